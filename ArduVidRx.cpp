@@ -20,6 +20,37 @@
 //  5/11/2017 -- [ET]  Version 1.8:  Modified so response of 'L' query
 //                     with empty list and serial-echo off is "0".
 //   1/4/2019 -- [ET]  Version 1.81:  Added IMD6C to frequency-list presets.
+// 10/16/2026 -- [ET]  Version 1.9:  Modified RX5808 tuning writes to use
+//                     direct-port access (RX5808_DIRECTPORT_FLAG) and to
+//                     skip unneeded frames; added 'XW' command; added
+//                     hardware-SPI option for RX5808 (RX5808_HWSPI_FLAG);
+//                     added adaptive RSSI-settle detection after tuning
+//                     (RSSI_SETTLE_DETECT_FLAG); added interrupt-driven
+//                     RSSI sampler (RSSI_ADCSAMPLER_FLAG); modified scans
+//                     to run as non-blocking scan jobs that are aborted
+//                     by serial input or button presses; added spectrum
+//                     model so 'N', 'P' and 'M' only rescan stale entries;
+//                     replaced RSSI sort with incrementally-updated ranking;
+//                     added binary-framed output option ('XO' command);
+//                     added streaming-sweeps command ('XS'); added
+//                     range-scan parameters to 'XF' command; channel
+//                     tables now generated from band plan at compile time;
+//                     added user-defined custom bands ('XE' command);
+//                     added queued serial output (SERIAL_OUTQUEUE_FLAG)
+//                     and 'XQ' command; added rate and averaging-window
+//                     parameters (with timestamped output) to 'O' command;
+//                     added RSSI flight recorder (RSSI_RECORDER_FLAG) and
+//                     'XV' command; added operation-timing statistics
+//                     (TIMESTATS_ENABLED_FLAG) to 'XQ' command; added
+//                     loop/ISR latency histograms (LATENCYHIST_ENABLED_FLAG)
+//                     to 'XQ' command; added raw-RSSI trace command ('XY');
+//                     display interrupt uses precomputed direct-port frames
+//                     (DISP7SEG_DIRECTPORT_FLAG); display values passed to
+//                     interrupt via published schedule buffers; added
+//                     Timer1 tick scheduler (TICKSCHED_ENABLED_FLAG) for
+//                     display, RSSI-output sampling and button sampling;
+//                     main loop split into run-queue tasks (shown via
+//                     "XQ T" command).
 //
 
 //Global arrays:
@@ -30,9 +61,18 @@
 // entry corresponds to a frequency in the Rx5808Fns 'channelFreqTable[]'
 // or a frequency in 'listFreqsMHzArr[]' (if entered).
 //
+//scanRssiAgeSecsArr[]:  Ages (in seconds, saturating at 255) of the
+// values in 'scanRssiValuesArr[]'.  Together these arrays form the
+// "spectrum model," which is updated by scans and by any other RSSI
+// readings of its channels (and only stale entries are rescanned by
+// the 'N', 'P' and 'M' commands).
+//
 //idxSortedByRssiArr[]:  List of channel-index values sorted by RSSI values
 // (in 'scanRssiValuesArr[]') in descending order.  If 'listFreqsMHzArr[]'
 // values are entered then the index values are for 'listFreqsMHzArr[]'.
+// The array is kept in order as entries in 'scanRssiValuesArr[]' are
+// updated (via 'setSpectrumModelEntry()'), so the rank of a channel index
+// may be found via binary search.
 //
 //idxSortedSelectedArr:  List of channel-index values selected from the
 // 'idxSortedByRssiArr[]' array by squelching frequencies adjacent to those
@@ -40,15 +80,45 @@
 // are copied in as-is.
 
 #include <Arduino.h>
+#include <util/atomic.h>
 #include "Config.h"
 #include "ArduVidUtil.h"
 #include "Rx5808Fns.h"
+#include "RssiSampler.h"
+#include "BinFrames.h"
+#include "SerialOutQueue.h"
+#include "RssiRecorder.h"
+#include "TimeStats.h"
+#include "LatencyHist.h"
+#include "TickSched.h"
+#include "RunQueue.h"
 #include "Display7Seg.h"
 #include "FreqListPresets.h"
 
 #define PROG_NAME_STR "ArduVidRx"
-#define PROG_VERSION_STR "1.81"
+#define PROG_VERSION_STR "1.9"
 #define LISTFREQMHZ_ARR_SIZE 80   //size for 'listFreqsMHzArr[]' array
+#define SELFREQS_CACHE_SIZE 20    //# of freqs cached when squelching chans
+
+#define SCANJOB_SRC_NONE 0        //scan-job sources:  none in progress
+#define SCANJOB_SRC_CHANS 1       // channels from table or 'L' list
+#define SCANJOB_SRC_FULL 2        // full band with fill-in freqs ('XF')
+#define SCANJOB_SRC_RANGE 3       // range with given step ('XF lo,hi,step')
+#define SCANJOB_SRC_TUNE 4        // selected channels tuned in turn
+#define SCANJOB_ACT_NONE 0        //scan-job actions when done:  none
+#define SCANJOB_ACT_REPORT 1      // report channels ('S', 'F')
+#define SCANJOB_ACT_AUTOTUNE 2    // tune channel ('A', 'N', 'P', 'M')
+#define SCANJOB_ACT_FULLDONE 3    // finish full-band scan ('XF')
+#define SCANJOB_ACT_STREAM 4      // show sweep and repeat ('XS')
+#define SCANJOB_ACT_TRACE 5       // show raw readings and repeat ('XY')
+#define SCANJOB_ACT_LISTLOAD 6    // load 'L' list from scan ('L S')
+#define SCANJOB_STEP_OUTMAX 32    //max # of output bytes per scan-job step
+#define CMDSTEP_OUTMAX 48         //max # of output bytes per command step
+#define STREAMFREQS_STEPCOUNT 8   //# of freqs shown per step for 'XS'
+#define CMDTEXT_DISPONLY_CHR '\x01'  //starts help line shown only w/display
+#define RANGESCAN_MAX_SAMPLES 64  //max samples per freq for range scan
+#define CONTRSSI_MAX_RATE 100     //max samples/second for 'O rate'
+#define CONTRSSI_MAX_WINDOW 32    //max RSSI readings averaged per sample
 
 #define EEPROM_ADRW_FREQ 0        //address for freq value in EEPROM (word)
 #define EEPROM_ADRB_BTNMODE 2     //address for button mode in EEPROM (byte)
@@ -61,8 +131,11 @@
 #define EEPROM_FLEN_UNITID 20     //field length for unit ID in EEPROM
 #define EEPROM_ADRA_FREQLIST 64   //address for freq list in EEPROM (array)
 #define EEPROM_FLEN_FREQLIST 84   //field length (in bytes) for freq list
+#define EEPROM_ADRA_CUSTBANDS 148 //address for custom bands in EEPROM
+#define EEPROM_FLEN_CUSTBAND 17   //field length for each band (char+8 words)
                                   //total length (in bytes) of EEPROM used:
-#define EEPROM_USED_DATASIZE (EEPROM_ADRA_FREQLIST+EEPROM_FLEN_FREQLIST)
+#define EEPROM_USED_DATASIZE (EEPROM_ADRA_CUSTBANDS+ \
+                                CUSTOM_BANDS_MAXCOUNT*EEPROM_FLEN_CUSTBAND)
 #define EEPROM_CHECK_VALUE 0x5242 //EEPROM integrity-check value
 
     //setup flags for button-interrupt usage depending on pin assignments:
@@ -70,31 +143,121 @@
 #define BUTTONPINS_UP3DOWN2_FLAG (UP_BUTTON_PIN == 3 && DOWN_BUTTON_PIN == 2)
 #define BUTTONPINS_USEINTERRUPT_FLAG (BUTTONS_ENABLED_FLAG && \
                      (BUTTONPINS_UP2DOWN3_FLAG || BUTTONPINS_UP3DOWN2_FLAG))
+    //if not using interrupts then sample buttons via Timer1 tick task:
+#define BUTTONPINS_TICKSAMPLED_FLAG (BUTTONS_ENABLED_FLAG && \
+                     TICKSCHED_ENABLED_FLAG && !BUTTONPINS_USEINTERRUPT_FLAG)
+    //sample RSSI for analog-RSSI output via Timer1 tick task:
+#define RSSIOUT_TICKTASK_FLAG (TICKSCHED_ENABLED_FLAG && RSSI_ADCSAMPLER_FLAG)
+#define RSSIOUT_TICKTASK_RUNS 2   //# of tick-task runs per RSSI-out value
 
 uint16_t currentTunerFreqMhzOrCode = 0;
 uint16_t currentTunerFreqInMhz = 0;
 boolean contRssiOutFlag = false;
 boolean contRssiListFlag = false;
 uint16_t contRssiPrevFreqVal = 0;
+uint16_t contRssiIntervalMs = 0;       //ms between samples (0=free-running)
+uint8_t contRssiWindowCount = 1;       //# of RSSI readings per sample
+unsigned long contRssiStartTimeMs = 0; //time continuous output started
+unsigned long contRssiNextTimeMs = 0;  //time for next sample
+unsigned long contRssiSampleTimeMs = 0;     //time of sample (since start)
+uint16_t contRssiSeqNum = 0;           //sample # (advanced for late slots)
+uint16_t contRssiSampleCount = 0;      //# of samples taken
+uint16_t contRssiLateCount = 0;        //# of sample slots missed
+uint16_t contRssiDroppedCount = 0;     //# of sample lines dropped
 boolean lastShowCurRssiListFlag = false;
+boolean lastShowCurRssiChanFlag = false;
 boolean monitorModeNextFlag = false;
 boolean displayRssiEnabledFlag = false;
 int sessionDefMinRssiLevel = DEF_MIN_RSSI_LEVEL;
 char itoaBuff[20];
 uint16_t listFreqsMHzArr[LISTFREQMHZ_ARR_SIZE];    //values via 'L' command
 uint8_t scanRssiValuesArr[LISTFREQMHZ_ARR_SIZE];   //RSSI vals for all chans
+uint8_t scanRssiAgeSecsArr[LISTFREQMHZ_ARR_SIZE]; //ages of RSSI values
 uint8_t idxSortedByRssiArr[LISTFREQMHZ_ARR_SIZE];  //indices sorted by RSSI
-uint8_t idxSortedSelectedArr[CHANNEL_MAX_INDEX+1];
+uint8_t rankedIdxCount = 0;            //# of entries in ranked-index array
+uint8_t idxSortedSelectedArr[CHANNEL_TOTAL_MAXCOUNT];
+#if LISTFREQMHZ_ARR_SIZE < CHANNEL_TOTAL_MAXCOUNT
+#error LISTFREQMHZ_ARR_SIZE must be at least CHANNEL_TOTAL_MAXCOUNT
+#endif
 int listFreqsMHzArrCount = 0;
+int listLoadPrevCount = 0;             //list count saved during 'L S' scan
 int idxSortedSelArrCount = 0;
 int nextTuneChannelIndex = -1;
 unsigned long lastNextTuneScanTime = 0;
 unsigned long monitorModeNextChanTime = 0;
+unsigned long spectrumAgesUpdateTimeMs = 0;   //last update of model ages
+byte scanJobSourceVal = 0;             //scan-job source (0 == none)
+byte scanJobActionVal = 0;             //action when scan job done
+boolean scanJobTunedFlag = false;      //true if waiting for RSSI ready
+boolean scanJobListFlag = false;       //true if using 'L' list
+boolean scanJobInclAllFlag = false;    //scan-job parameters:
+boolean scanJobTuneFirstFlag = false;
+boolean scanJobForwardFlag = false;
+boolean scanJobRescanOnSingleFlag = false;
+boolean scanJobAutoTuneScanDoneFlag = false;  //true if auto-tune after scan
+boolean scanJobAutoTuneDoneFlag = false;      //true if channel accepted
+int scanJobMinRssiLevel = 0;
+int scanJobIdx = 0;                    //index of current channel slot
+int scanJobMaxIdx = 0;                 //index of last channel slot
+int scanJobTableIdx = 0;               //table index for tuned frequency
+uint8_t scanJobFillPos = 0;            //fill-in position for full scan
+uint16_t scanJobFreqVal = 0;           //currently-scanned freq (MHz)
+uint16_t scanJobCodeVal = 0;           //freq code for scanned freq
+uint16_t scanJobRestoreFreqVal = 0;    //freq to restore when done (or 0)
+uint16_t scanJobPrevFreqVal = 0;       //freq before auto-tune scan
+uint8_t scanJobMinAgeSecs = 0;         //min entry age to scan (0 == all)
+int scanJobChanCount = 0;              //# of channels scanned
+unsigned long scanJobStartTimeMs = 0;  //start time for scan job
+uint16_t scanJobSweepCount = 0;        //# of sweeps done ('XS')
+uint16_t scanJobRangeFirstFreq = 0;    //first freq for range scan
+int scanJobRangeStep = 0;              //step for range scan (may be neg)
+uint8_t scanJobSamplesCount = 1;       //# of RSSI samples per freq
+uint8_t scanJobSampleIdx = 0;          //# of samples taken for freq
+uint16_t scanJobSampleSum = 0;         //sum of samples taken for freq
 int monitorModeIntervalSecs = DEF_MONITOR_INTERVAL_SECS;
 unsigned long rssiOutSamplingAvgrTotal = 0;
 byte rssiOutSamplingAvgrCounter = 0;
+#if RSSI_ADCSAMPLER_FLAG
+uint16_t rssiOutLastSampleSeqNum = 0;   //sampler seq # of last RSSI-out sample
+#endif
+#if RSSIOUT_TICKTASK_FLAG
+uint16_t rssiOutTickSeqNum = 0;        //sampler seq # of next tick-task sample
+uint16_t rssiOutTickMarkSeqNum = 0;    //sampler tune mark for tick window
+uint32_t rssiOutTickTotal = 0;         //total of samples in tick window
+uint8_t rssiOutTickCount = 0;          //# of samples in tick window
+uint8_t rssiOutTickRunCount = 0;       //# of tick-task runs in window
+volatile uint16_t rssiOutTickAvgVal = 0;         //averaged raw-RSSI value
+volatile uint16_t rssiOutTickAvgMarkSeqNum = 0;  //tune mark for value
+volatile boolean rssiOutTickAvgReadyFlag = false;     //true if value ready
+#endif
+#if BUTTONPINS_TICKSAMPLED_FLAG
+    //# of tick-task runs the sampled button inputs must be steady:
+#define BUTTONS_TICKTASK_DEBOUNCE_RUNS \
+      (TICKSCHED_MS_TO_TICKS(BUTTON_DEBOUNCE_TIMEMS)/TICKSCHED_PERIOD_BUTTONS)
+volatile byte buttonsTickCurrentMask = NO_BUTTONS_MASK;  //debounced state
+volatile byte buttonsTickUpTrigCounter = 0;      //incremented on presses
+volatile byte buttonsTickDownTrigCounter = 0;
+byte buttonsTickSampleMask = NO_BUTTONS_MASK;    //last sampled state
+uint8_t buttonsTickSteadyCount = 0;    //# of runs sampled state steady
+unsigned long buttonsTickEdgeUs = 0;   //time sampled state changed by
+volatile unsigned long buttonsTickChangeUs = 0;  //edge time for state
+#endif
+#if BUTTONS_ENABLED_FLAG
+unsigned long buttonsInputChangeUs = 0;     //time buttons last changed by
+#endif
+const char *loopSerialLineStr = NULL;  //serial line waiting for command
+const char *loopButtonCmdStr = NULL;   //button command waiting for command
+boolean loopSerialAvailFlag = false;   //serial chars or full line available
+unsigned long serialRxPrevRunUs = 0;   //time of previous serial-RX run
+unsigned long serialRxHeldUs = 0;      //time held serial input arrived by
+boolean serialRxHeldFlag = false;      //true if serial input being held
+boolean (*loopCmdStepFn)(uint16_t *) = NULL;     //command done in steps
+uint16_t loopCmdStepPos = 0;           //position for next command step
+const char *loopCmdStepTextPtr = NULL; //text shown via 'showTextStep()'
 unsigned long delayedSaveFreqToEepromTime = 0;
 boolean delayedSaveFreqToEepromFlag = false;
+boolean delayedSaveRssiMinMaxFlag = false;     //auto-calib values to save
+boolean delayedSaveFreqListFlag = false;       //'L' list to save
 uint16_t lastEepromFreqInMhzOrCode = 0;
 byte buttonsFunctionModeValue = 0;
 boolean autoRssiCalibEnabledFlag = true;
@@ -107,18 +270,48 @@ boolean displayConnectedFlag = true;
 const boolean displayConnectedFlag = false;
 #endif
 
+void setupRunQueueTasks();
+boolean isOutputModeInProgress();
+void stopOutputModesOnInput();
+void serialRxTask();
+#if BUTTONS_ENABLED_FLAG
+void buttonsTask();
+#endif
+void commandTask();
+void processCommandLine(const char *cmdStr, int sLen, boolean buttonInFlag);
+void startCommandSteps(boolean (*stepFn)(uint16_t *posPtr));
+void startTextCommandSteps(const char *textPtr);
+boolean showTextStep(uint16_t *posPtr);
+void processCommandSteps();
+void scanStepTask();
+void contRssiTask();
+void monitorTask();
+void rssiOutTask();
+void eepromSaveTask();
+void indicatorTask();
 boolean processExtraCommand(const char *cmdStr);
 void showHelpInformation();
 void showExtraHelpInformation();
 void showListCmdHelpInformation();
 void showFrequencyTable();
+boolean showFrequencyTableStep(uint16_t *posPtr);
 void showRevisionInfo(boolean dispInfoFlag);
 void processTuneCommand(const char *valueStr);
 void showCurrentFreqency();
 void processFreqsMHzList(const char *listStr);
+void loadFreqsMHzListFromScan();
+void storeFreqsMHzList(int numItems);
 void showFreqsMHzList();
 void processShowRssiCmd(const char *valueStr, boolean contFlag);
+boolean parseContRssiParams(const char *valueStr);
+void startContRssiOutput(boolean listFlag);
+boolean checkContRssiSampleDue();
+void addContRssiTimeStamp();
+void showContRssiStats();
 uint16_t showCurrentRssi(boolean showListFlag, boolean showChanFlag);
+void sendCurrentRssiOutput(void (*addFn)(uint16_t), uint16_t val);
+void addListRssiValues(uint16_t);
+void addCurrentRssiValue(uint16_t rVal);
 boolean repeatShowCurrentRssi();
 void processOneMHzCommand(boolean upFlag, boolean serialOutFlag);
 void processIncFreqCodeCommand(boolean bandFlag, boolean upFlag,
@@ -126,15 +319,53 @@ void processIncFreqCodeCommand(boolean bandFlag, boolean upFlag,
 void processAutoScanAndTuneCommand(const char *valueStr);
 void autoScanTuneNextChan(const char *valueStr, boolean scanForwardFlag,
                                                 boolean rescanOnSingleFlag);
+boolean autoTuneSelectNextChannel();
+boolean autoTuneCheckChannelRssi(uint8_t rssiVal);
+void startAutoTuneJob(boolean scanDoneFlag);
+void processAutoTuneJobStep();
+void finishAutoTuneJob(boolean abortFlag);
+void startAutoTuneScanJob();
+void doAutoScanTuneChannel(int minRssiLevel, boolean scanAndTuneFirstFlag,
+                        boolean scanForwardFlag, boolean rescanOnSingleFlag);
+void finishAutoScanTuneChannel();
 void processMonitorModeCommand(const char *valueStr);
 void monitorAutoTuneNextChan();
-boolean scanChannelsAndReport(int minRssiLevel, int fallbackRssiLevel,
-      boolean inclAllFlag, boolean restoreFreqFlag, boolean showOutputFlag);
-boolean processScanChannelsCommand(const char *valueStr, boolean inclAllFlag);
-void scanChansGetRssiValues(boolean includeLBandFlag, boolean inclAllFlag,
-                           boolean restoreFreqFlag, boolean showOutputFlag);
+boolean reportScannedChannels(int minRssiLevel, int fallbackRssiLevel,
+                                boolean inclAllFlag, boolean showOutputFlag);
+void processScanChannelsCommand(const char *valueStr, boolean inclAllFlag);
+void invalidateSpectrumModel();
+void updateSpectrumModelAges();
+void setSpectrumModelEntry(int idx, uint8_t rssiVal);
+boolean isSpectrumModelFresh(int minRssiLevel);
+boolean isScanJobInProgress();
+void startChansScanJob(byte actionVal, boolean inclAllFlag,
+                               boolean restoreFreqFlag, uint8_t minAgeSecs);
+void startFullScanJob();
+void startRangeScanJob(uint16_t startFreq, uint16_t stopFreq, int stepVal,
+                                                     uint8_t samplesCount);
+uint16_t getNextRangeScanFreq();
+void processFullScanCommand(const char *valueStr);
+uint16_t getFullScanAnchorFreq(int idx, int *pTableIdx);
+uint16_t getNextFullScanFreq(int *pTableIdx);
+uint16_t getChansScanSlotFreq(int slotIdx, int *pTableIdx);
+uint16_t getNextChansScanFreq(int *pTableIdx);
+void startStreamSweepJob();
+boolean showStreamSweepFreqsStep(uint16_t *posPtr);
+void showStreamSweepValues();
+void addStreamSweepValues(uint16_t sweepNum);
+void startRssiTraceJob();
+void showRssiTraceReading(uint16_t rawVal);
+void addRssiTraceReading(uint16_t rawVal);
+void showStreamSweepStats();
+void processScanJobStep();
+void finishScanJob(boolean abortFlag);
+void abortScanJob();
 void fullScanShowRssiValues();
 void processSerialEchoCommand(const char *valueStr);
+void processBinaryFramesCommand(const char *valueStr);
+void processCustomBandsCommand(const char *valueStr);
+void processOutQueueStatsCommand(const char *valueStr);
+void processRecorderCommand(const char *valueStr);
 void processRawRssiMinMaxCommand(const char *valueStr);
 void processEnableAutoRssiCalibCmd(const char *valueStr);
 void processMinTuneTimeCommand(const char *valueStr);
@@ -144,24 +375,39 @@ void processUnitIdCommand(const char *valueStr);
 void processSoftRebootCommand(const char *valueStr);
 void processShowFreqPresetListCmd(const char *valueStr);
 void processListTranslateInfoCmd(const char *listStr);
+uint8_t findRankOfIdx(uint8_t idx);
+void updateRankedIdxEntry(uint8_t idx, uint8_t rank);
+void rebuildRankedIdxArr(uint8_t count);
+int getRankOfChannelIdx(int idx);
+int getChannelIdxAtRank(int rank);
+int getNextRankedChannelIdx(int idx);
+int getPrevRankedChannelIdx(int idx);
+int loadTopRankedChannelIdxs(uint8_t *destArr, int maxCount);
 void loadIdxSortedByRssiArr(boolean inclAllFlag);
 int loadIdxSortedSelectedArr();
 void processShowInputsCmd(const char *listStr);
 void showDebugInputs();
 void checkReportTableValues();
+boolean checkReportTableStep(uint16_t *posPtr);
+void showTuneWriteTime();
 void setCurrentFreqByMhzOrCode(uint16_t freqMhzOrCode);
 uint16_t getCurrentFreqInMhz();
 uint16_t getCurrentFreqCodeWord();
 void setTunerChannelToFreq(uint16_t freqInMhz);
 void updateRssiOutput();
 void clearRssiOutput();
+#if RSSIOUT_TICKTASK_FLAG
+void rssiOutTickTask();
+#endif
 void updateRssiOutValue(uint16_t rssiVal);
 void scheduleDelayedSaveFreqToEeprom(int secs);
-void saveCurrentFreqToEeprom();
+boolean saveCurrentFreqToEepromStep();
 void setChanToFreqValFromEeprom();
 void saveButtonModeToEeprom(byte modeVal);
 byte loadButtonModeFromEeprom();
 void saveRssiMinMaxValsToEeprom();
+boolean saveRssiMinMaxValsToEepromStep();
+void showRssiMinMaxCalibValues();
 void loadRssiMinMaxValsFromEeprom();
 void saveAutoRssiCalFlagToEeprom(boolean flagVal);
 boolean loadAutoRssiCalFlagFromEeprom();
@@ -171,16 +417,23 @@ void saveUnitIdToEeprom(const char *str);
 boolean isUnitIdFromEepromEmpty();
 void showUnitIdFromEeprom();
 void saveListFreqsMHzArrToEeprom();
+boolean saveListFreqsMHzArrToEepromStep();
 void loadListFreqsMHzArrFromEeprom();
+void saveCustomBandsToEeprom();
+void loadCustomBandsFromEeprom();
 void setEepromToDefaultsValues();
 void checkEepromIntegrity();
 void updateActivityIndicator(boolean activityFlag);
 uint16_t readRssiValue();
+uint16_t readAvgRssiValue();
 void processAutoRssiCalValue(uint16_t rawVal);
 #if BUTTONS_ENABLED_FLAG
 void processButtonModeCommand(const char *valueStr);
 byte fetchButtonsTriggerState();
 char *processButtonInputs(boolean bEnabledFlag);
+#if BUTTONPINS_TICKSAMPLED_FLAG
+void buttonsTickTask();
+#endif
 #endif
 #if DISP7SEG_ENABLED_FLAG
 void processWriteDisplayCmd(const char *valueStr);
@@ -199,6 +452,9 @@ void showButtonModeOnDisplay(byte bModeVal, int dispTimeMs);
 void setup()
 {
   Serial.begin(SERIAL_BAUDRATE);
+#if TICKSCHED_ENABLED_FLAG
+  tickSchedStart();          //start Timer1 ticks (tasks added below)
+#endif
   checkEepromIntegrity();    //check EEPROM; reset to defaults if needed
 #if DISP7SEG_ENABLED_FLAG    //detect if display is actually wired in:
   displayConnectedFlag = disp7SegTestDisplayConnected();
@@ -219,6 +475,9 @@ void setup()
 #if BUTTONPINS_USEINTERRUPT_FLAG
   installD2InterruptRoutine();
   installD3InterruptRoutine();
+#elif BUTTONPINS_TICKSAMPLED_FLAG
+  tickSchedAddTask(buttonsTickTask,TICKSCHED_PERIOD_BUTTONS,
+                                                  TICKSCHED_PHASE_BUTTONS);
 #endif  //BUTTONPINS_USEINTERRUPT_FLAG
 #if DISP7SEG_ENABLED_FLAG
   if(displayConnectedFlag)
@@ -234,10 +493,16 @@ void setup()
   serialEchoFlag = true;
   setRx5808MinTuneTimeMs(loadMinTuneTimeMsFromEeprom());
   rx5808setup();
+#if RSSIOUT_TICKTASK_FLAG
+  tickSchedAddTask(rssiOutTickTask,TICKSCHED_PERIOD_RSSIOUT,
+                                                  TICKSCHED_PHASE_RSSIOUT);
+#endif
   loadRssiMinMaxValsFromEeprom();      //load RSSI-scaling values from EEPROM
                                        //load auto calib flag from EEPROM:
   autoRssiCalibEnabledFlag = loadAutoRssiCalFlagFromEeprom();
   loadListFreqsMHzArrFromEeprom();     //load array of 'L'-command freqs
+  loadCustomBandsFromEeprom();         //load user-defined bands
+  invalidateSpectrumModel();           //no spectrum-model entries yet
     //set tuner to freq value from EEPROM (or default if never saved):
   setChanToFreqValFromEeprom();
   if(!displayConnectedFlag)
@@ -261,6 +526,7 @@ void setup()
     Serial.print(F(" Using freq list: "));
     showFreqsMHzList();
   }
+  setupRunQueueTasks();                //setup tasks run via 'loop()'
 }
 
 //Performs shutdown-cleanup actions (disconnects interrupts).
@@ -274,231 +540,480 @@ void doShutdownCleanup()
   if(displayConnectedFlag)
     disp7SegShutdown();
 #endif
+#if TICKSCHED_ENABLED_FLAG
+  tickSchedStop();
+#endif
 }
 
 // LOOP ----------------------------------------------------------------------------
 void loop()
 {
-  if(delayedSaveFreqToEepromFlag && millis() > delayedSaveFreqToEepromTime)
-  {  //save freq to EEPROM scheduled and time reached
-    delayedSaveFreqToEepromFlag = false;
-    saveCurrentFreqToEeprom();
-  }
-         //check for next line of serial input:
-  const char *nextSerialLineStr = getNextSerialLine();
-  const boolean serialAvailFlag =      //serial chars or full line available
-                   (getSerialInputAvailflag() || nextSerialLineStr != NULL);
-         //if report-RSSI char was received (and not continuous
-         // RSSI output in progess) then show RSSI/channel:
-  if(getDoReportRssiFlag() && !contRssiOutFlag)
-    showCurrentRssi(false,true);
-
-  const char *cmdStr;
+  latencyHistMarkLoopPass();      //track time between 'loop()' passes
+                                  // (i.e., time of one task run)
+  if(contRssiOutFlag || isScanJobInProgress())
+    outQueuePump();          //streaming; send queued output as space allows
+  else                       //not streaming; send all queued output
+    outQueueFlush();         // (so it stays ahead of direct output)
+  updateSpectrumModelAges();      //update ages of spectrum-model entries
+  runQueueRunNext();              //run task with earliest deadline
+}
 
+//Sets up the main-loop tasks in the run queue, with the max time (ms)
+// between runs for each.  The serial-input limit keeps the 64-byte
+// receive buffer from overflowing (it fills in about 5.5 ms).
+void setupRunQueueTasks()
+{
+  runQueueSetTask(RUNQ_TASK_SERIALRX,serialRxTask,5);
 #if BUTTONS_ENABLED_FLAG
-         //process button inputs (disabled if serial in or continuous RSSI):
-  cmdStr = processButtonInputs(!(serialAvailFlag || contRssiOutFlag));
-  if(cmdStr != NULL)
-  {  //new command via button action
-    if(monitorModeNextFlag)
-    {  //auto-tune-monitor mode is in progress then
-      monitorModeNextFlag = false;     //stop monitor mode
-      cmdStr = NULL;                   //discard command
-    }
-    else if(serialEchoFlag)
-    {  //serial echo enabled
-      Serial.println(cmdStr);          //show command
-    }
-    setSerialInputPromptFlag();        //setup to show prompt later
-         //clear any previous command (so can't be invoked via <Enter> key):
-    clearLastCommandChar();
-  }
-#else
-  cmdStr = NULL;
+  runQueueSetTask(RUNQ_TASK_BUTTONS,buttonsTask,16);
 #endif
+  runQueueSetTask(RUNQ_TASK_COMMAND,commandTask,8);
+  runQueueSetTask(RUNQ_TASK_SCANSTEP,scanStepTask,0);
+  runQueueSetTask(RUNQ_TASK_CONTRSSI,contRssiTask,0);
+  runQueueSetTask(RUNQ_TASK_MONITOR,monitorTask,16);
+  runQueueSetTask(RUNQ_TASK_RSSIOUT,rssiOutTask,8);
+  runQueueSetTask(RUNQ_TASK_EEPROM,eepromSaveTask,100);
+  runQueueSetTask(RUNQ_TASK_INDICATOR,indicatorTask,30);
+}
+
+//Returns true if a scan job, continuous-RSSI output or auto-tune-monitor
+// mode is in progress.
+boolean isOutputModeInProgress()
+{
+  return isScanJobInProgress() || contRssiOutFlag || monitorModeNextFlag;
+}
 
+//Stops any scan job, continuous-RSSI output or auto-tune-monitor mode
+// in progress (called when serial input is received).
+void stopOutputModesOnInput()
+{
+  if(isScanJobInProgress())
+    abortScanJob();        //serial port input detected; stop scan
   if(contRssiOutFlag)
   {  //continuous RSSI output enabled
-    if(!serialAvailFlag)
-    {  //no serial port input received
-      const uint16_t rVal = showCurrentRssi(contRssiListFlag,false);
-      updateRssiOutValue(rVal);        //update analog-RSSI output
-      if(!displayConnectedFlag)             //if no display then
-        updateActivityIndicator(true);      //indicate "extra" activity
-      return;
-    }
-    else
-    {  //serial port input detected
-      contRssiOutFlag = false;                        //stop output
-      monitorModeNextFlag = false;                    //make sure both stopped
-      if(contRssiPrevFreqVal > (uint16_t)0)           //if saved then
-        setTunerChannelToFreq(contRssiPrevFreqVal);   //restore tuner freq
-      clearRssiOutput();
-    }
+    contRssiOutFlag = false;                        //stop output
+    monitorModeNextFlag = false;                    //make sure both stopped
+    outQueueFlush();                                //send queued output
+    if(contRssiIntervalMs > 0)                      //if fixed rate then
+      showContRssiStats();                          //show sample stats
+    contRssiIntervalMs = 0;              //back to free-running, no window
+    contRssiWindowCount = 1;             // (each 'O' sets its own values)
+    if(contRssiPrevFreqVal > (uint16_t)0)           //if saved then
+      setTunerChannelToFreq(contRssiPrevFreqVal);   //restore tuner freq
+    clearRssiOutput();
   }
   else if(monitorModeNextFlag)
   {  //auto-tune-monitor mode enabled
-    if(!serialAvailFlag)
-    {  //no serial port input received
-      monitorAutoTuneNextChan();
-      updateRssiOutput();              //update analog-RSSI output
-      return;
-    }
-    else
-    {  //serial port input detected
-      monitorModeNextFlag = false;               //stop output
-      contRssiOutFlag = false;                   //make sure both stopped
-      clearRssiOutput();
+    monitorModeNextFlag = false;               //stop output
+    contRssiOutFlag = false;                   //make sure both stopped
+    clearRssiOutput();
+  }
+}
+
+//Task that checks for serial input.  A received line is left for the
+// command task, and any input stops a scan job, continuous-RSSI output
+// or auto-tune-monitor mode in progress.
+void serialRxTask()
+{
+  const unsigned long curUs = micros();
+  if(loopSerialLineStr == NULL && loopCmdStepFn == NULL)
+  {  //no line waiting for (or command in progress in) command task;
+     // check for next line of input (no prompt shown while scan job
+     // in progress):
+    loopSerialLineStr = isScanJobInProgress() ?
+                                pollNextSerialLine() : getNextSerialLine();
+    if(loopSerialLineStr != NULL)
+    {  //line received; have command task run next (input arrived
+       // after previous run of this task, or while it was held)
+      runQueueMarkInput(RUNQ_INPUT_SERIAL,
+                         serialRxHeldFlag ? serialRxHeldUs : serialRxPrevRunUs);
+      serialRxHeldFlag = false;
+      runQueueWakeTask(RUNQ_TASK_COMMAND);
     }
+    else if(!getSerialInputAvailflag())     //if held input was not part
+      serialRxHeldFlag = false;             // of a line then clear flag
+  }
+  else if(!serialRxHeldFlag && Serial.available() > 0)
+  {  //input is being held until command is done; track when it arrived
+    serialRxHeldUs = serialRxPrevRunUs;
+    serialRxHeldFlag = true;
+  }
+  serialRxPrevRunUs = curUs;
+  loopSerialAvailFlag =                //serial chars or full line available
+               (getSerialInputAvailflag() || loopSerialLineStr != NULL);
+         //if report-RSSI char was received (and not continuous
+         // RSSI output in progess) then show RSSI/channel:
+  if(!(contRssiOutFlag || isScanJobInProgress()) && getDoReportRssiFlag())
+    showCurrentRssi(false,true);
+  if(loopSerialAvailFlag)
+    stopOutputModesOnInput();
+}
+
+#if BUTTONS_ENABLED_FLAG
+//Task that processes button inputs (disabled if serial in or continuous
+// RSSI).  A button command is left for the command task.
+void buttonsTask()
+{
+  if(loopButtonCmdStr != NULL || loopCmdStepFn != NULL)
+    return;          //if command waiting or in progress then leave buttons
+  const char *cmdStr =
+               processButtonInputs(!(loopSerialAvailFlag || contRssiOutFlag));
+  if(cmdStr == NULL)
+    return;
+  if(isScanJobInProgress())
+  {  //scan job is in progress
+    abortScanJob();                    //stop scan
+    monitorModeNextFlag = false;       //stop monitor mode (if running)
+    cmdStr = NULL;                     //discard command
   }
-  else   //neither output mode enabled
-    updateRssiOutput();           //update analog-RSSI output
+  else if(monitorModeNextFlag)
+  {  //auto-tune-monitor mode is in progress then
+    monitorModeNextFlag = false;       //stop monitor mode
+    cmdStr = NULL;                     //discard command
+  }
+  else if(serialEchoFlag)
+  {  //serial echo enabled
+    Serial.println(cmdStr);            //show command
+  }
+  setSerialInputPromptFlag();          //setup to show prompt later
+         //clear any previous command (so can't be invoked via <Enter> key):
+  clearLastCommandChar();
+  if(cmdStr != NULL)
+  {  //new command via button action; have command task run next
+    loopButtonCmdStr = cmdStr;
+    runQueueMarkInput(RUNQ_INPUT_BUTTON,buttonsInputChangeUs);
+    runQueueWakeTask(RUNQ_TASK_COMMAND);
+  }
+}
+#endif
 
-  const boolean buttonInFlag = (cmdStr != NULL);
-  int sLen;        //if no input via buttons then check serial input:
-  if(((buttonInFlag && (sLen=strlen(cmdStr)) > 0)) ||
-     ((cmdStr=nextSerialLineStr) != NULL && ((sLen=strlen(cmdStr)) == 0 ||
+//Task that executes a command received via the buttons or serial input.
+// A command with a long output (like the help screen) is done in steps,
+// over as many runs of the task as needed to send the output.
+void commandTask()
+{
+  if(loopCmdStepFn != NULL)
+  {  //command in progress is being done in steps
+    processCommandSteps();
+    return;
+  }
+  const char *cmdStr;
+  const boolean buttonInFlag = (loopButtonCmdStr != NULL);
+  if(buttonInFlag)           //command via button action
+    cmdStr = loopButtonCmdStr;
+  else if(loopSerialLineStr != NULL)   //line of serial input
+    cmdStr = loopSerialLineStr;
+  else
+    return;                  //no input-command data received
+  const int sLen = strlen(cmdStr);
+  if((buttonInFlag && sLen > 0) || (!buttonInFlag && (sLen == 0 ||
      (cmdStr[0] != SERIAL_PROMPT_CHAR && cmdStr[0] != SERIAL_LIGNORE_CHAR &&
                                 strncasecmp(cmdStr,PROG_NAME_STR,4) != 0))))
   {  //line of input data was received and doesn't begin with prompt,
      // space or sign-on string that may be received if slave receiver
+    processCommandLine(cmdStr,sLen,buttonInFlag);
+  }
+         //clear input after command (serial line is held in the buffer
+         // used to fetch the next line):
+  if(buttonInFlag)
+    loopButtonCmdStr = NULL;
+  else
+    loopSerialLineStr = NULL;
+  processCommandSteps();     //do first steps of command (if in steps)
+         //first output of command has been written; mark response:
+  runQueueMarkResponse(buttonInFlag ? RUNQ_INPUT_BUTTON : RUNQ_INPUT_SERIAL);
+}
+
+//Processes a line of command input.
+// cmdStr:  command string.
+// sLen:  length of command string.
+// buttonInFlag:  true if command is via button action.
+void processCommandLine(const char *cmdStr, int sLen, boolean buttonInFlag)
+{
               //if display not connected then always show "extra" activity:
-    if(!displayConnectedFlag)
-      updateActivityIndicator(true);
-    boolean displayActFlag = false;    //set below for activity indicator
-    int p = 0;
-    while(p < sLen && cmdStr[p] == ' ')
-      ++p;              //ignore any leading spaces
-    if(p < sLen)
-    {  //command not empty
-      const char cmdChar = (char)toupper(cmdStr[p]);
-      switch(cmdChar)
-      {
-        case 'T':       //tune receiver to given MHz value
-          processTuneCommand(&cmdStr[p+1]);
-          displayActFlag = true;            //indicate activity on display
-          break;
-        case 'A':       //auto-scan and tune to highest-RSSI channel
-          processAutoScanAndTuneCommand(&cmdStr[p+1]);
-          break;
-        case 'N':       //auto-scan and tune to next channel
-          autoScanTuneNextChan(&cmdStr[p+1],true,true);
-          break;
-        case 'P':       //auto-scan and tune to previous channel
-          autoScanTuneNextChan(&cmdStr[p+1],false,true);
-          break;
-        case 'M':       //auto-scan and monitor channels
-          processMonitorModeCommand(&cmdStr[p+1]);
-          break;
-        case 'S':       //scan and report channels with highest RSSI
-          processScanChannelsCommand(&cmdStr[p+1],false);
-          break;
-        case 'F':       //scan and report RSSI for full set of channels
-          processScanChannelsCommand(&cmdStr[p+1],true);
-          break;
-        case 'L':       //list of freq (MHz) values to be scanned
-          processFreqsMHzList(&cmdStr[p+1]);
-          displayActFlag = true;            //indicate activity on display
-          break;
-        case 'R':       //read RSSI
-          processShowRssiCmd(&cmdStr[p+1],false);
-          displayActFlag = true;            //indicate activity on display
-          break;
-        case 'O':       //continuous RSSI display
-          processShowRssiCmd(&cmdStr[p+1],true);
-          break;
-        case 'U':       //increase turned frequency by one MHz
-          processOneMHzCommand(true,serialEchoFlag);
-          break;
-        case 'D':       //decrease turned frequency by one MHz
-          processOneMHzCommand(false,serialEchoFlag);
-          break;
-        case 'B':       //increment band on tuned-frequency code
-          processIncFreqCodeCommand(true,true,false);
-          break;
-        case 'C':       //increment channel on tuned-frequency code
-          processIncFreqCodeCommand(false,true,false);
-          break;
-        case 'G':       //show raw debug inputs values
-          processShowInputsCmd(&cmdStr[p+1]);
-          displayActFlag = true;            //indicate activity on display
-          break;
+  if(!displayConnectedFlag)
+    updateActivityIndicator(true);
+  boolean displayActFlag = false;    //set below for activity indicator
+  int p = 0;
+  while(p < sLen && cmdStr[p] == ' ')
+    ++p;              //ignore any leading spaces
+  if(p < sLen)
+  {  //command not empty
+    const char cmdChar = (char)toupper(cmdStr[p]);
+    timeStatsSetCommandChar(cmdChar);
+    TIMESTATS_START(cmdStartUs);
+    switch(cmdChar)
+    {
+      case 'T':       //tune receiver to given MHz value
+        processTuneCommand(&cmdStr[p+1]);
+        displayActFlag = true;            //indicate activity on display
+        break;
+      case 'A':       //auto-scan and tune to highest-RSSI channel
+        processAutoScanAndTuneCommand(&cmdStr[p+1]);
+        break;
+      case 'N':       //auto-scan and tune to next channel
+        autoScanTuneNextChan(&cmdStr[p+1],true,true);
+        break;
+      case 'P':       //auto-scan and tune to previous channel
+        autoScanTuneNextChan(&cmdStr[p+1],false,true);
+        break;
+      case 'M':       //auto-scan and monitor channels
+        processMonitorModeCommand(&cmdStr[p+1]);
+        break;
+      case 'S':       //scan and report channels with highest RSSI
+        processScanChannelsCommand(&cmdStr[p+1],false);
+        break;
+      case 'F':       //scan and report RSSI for full set of channels
+        processScanChannelsCommand(&cmdStr[p+1],true);
+        break;
+      case 'L':       //list of freq (MHz) values to be scanned
+        processFreqsMHzList(&cmdStr[p+1]);
+        displayActFlag = true;            //indicate activity on display
+        break;
+      case 'R':       //read RSSI
+        processShowRssiCmd(&cmdStr[p+1],false);
+        displayActFlag = true;            //indicate activity on display
+        break;
+      case 'O':       //continuous RSSI display
+        processShowRssiCmd(&cmdStr[p+1],true);
+        break;
+      case 'U':       //increase turned frequency by one MHz
+        processOneMHzCommand(true,serialEchoFlag);
+        break;
+      case 'D':       //decrease turned frequency by one MHz
+        processOneMHzCommand(false,serialEchoFlag);
+        break;
+      case 'B':       //increment band on tuned-frequency code
+        processIncFreqCodeCommand(true,true,false);
+        break;
+      case 'C':       //increment channel on tuned-frequency code
+        processIncFreqCodeCommand(false,true,false);
+        break;
+      case 'G':       //show raw debug inputs values
+        processShowInputsCmd(&cmdStr[p+1]);
+        displayActFlag = true;            //indicate activity on display
+        break;
 #if DISP7SEG_ENABLED_FLAG
-        case '#':       //toggle showing live RSSI on display
-          if(displayConnectedFlag)
-          {  //display is actually wired in
-            if(!displayRssiEnabledFlag)
-              displayRssiEnabledFlag = true;
-            else
-            {  //disable showing
-              displayRssiEnabledFlag = false;
-              disp7SegClearOvrDisplay();    //clear RSSI value immediately
-            }
+      case '#':       //toggle showing live RSSI on display
+        if(displayConnectedFlag)
+        {  //display is actually wired in
+          if(!displayRssiEnabledFlag)
+            displayRssiEnabledFlag = true;
+          else
+          {  //disable showing
+            displayRssiEnabledFlag = false;
+            disp7SegClearOvrDisplay();    //clear RSSI value immediately
           }
-          break;
+        }
+        break;
 #endif
 #if BUTTONS_ENABLED_FLAG
-        case '=':       //set/show button mode value
-          processButtonModeCommand(&cmdStr[p+1]);
-          break;
+      case '=':       //set/show button mode value
+        processButtonModeCommand(&cmdStr[p+1]);
+        break;
 #endif
-        case 'E':       //serial echo on/off or echo text
-          processSerialEchoCommand(&cmdStr[p+1]);
-          displayActFlag = true;            //indicate activity on display
-          break;
-        case 'V':       //show program-version information
-          showRevisionInfo(true);
-          displayActFlag = true;            //indicate activity on display
-          break;
-        case 'H':       //show help screen
-        case '?':
-          showHelpInformation();
-          displayActFlag = true;            //indicate activity on display
-          break;
-        case 'I':       //show frequency-information screen
-          showFrequencyTable();
-          displayActFlag = true;            //indicate activity on display
-          break;
-        case 'X':       //process "extra" command
-          displayActFlag = processExtraCommand(&cmdStr[p+1]);
-          break;
-        default:
-          Serial.print(F(" Unrecognized command:  "));
-          Serial.print(&cmdStr[p]);
-          Serial.println(F("  [Enter H for help]"));
-          displayActFlag = true;            //indicate activity on display
-      }
+      case 'E':       //serial echo on/off or echo text
+        processSerialEchoCommand(&cmdStr[p+1]);
+        displayActFlag = true;            //indicate activity on display
+        break;
+      case 'V':       //show program-version information
+        showRevisionInfo(true);
+        displayActFlag = true;            //indicate activity on display
+        break;
+      case 'H':       //show help screen
+      case '?':
+        showHelpInformation();
+        displayActFlag = true;            //indicate activity on display
+        break;
+      case 'I':       //show frequency-information screen
+        showFrequencyTable();
+        displayActFlag = true;            //indicate activity on display
+        break;
+      case 'X':       //process "extra" command
+        displayActFlag = processExtraCommand(&cmdStr[p+1]);
+        break;
+      default:
+        Serial.print(F(" Unrecognized command:  "));
+        Serial.print(&cmdStr[p]);
+        Serial.println(F("  [Enter H for help]"));
+        displayActFlag = true;            //indicate activity on display
     }
-    else //received command line is empty,
-    {    // repeat last command (if one of those below)
-      const char lastCommandChar = getLastCommandChar();
-      if(lastCommandChar == 'R')
-      {
-        if(!repeatShowCurrentRssi())        //if not 'L' list then
-          displayActFlag = true;            //indicate activity on display
-      }
-      else if(lastCommandChar == 'N')
-        autoScanTuneNextChan("",true,true);
-      else if(lastCommandChar == 'P')
-        autoScanTuneNextChan("",false,true);
-      else if(lastCommandChar == 'B')
-        processIncFreqCodeCommand(true,true,false);
-      else if(lastCommandChar == 'C')
-        processIncFreqCodeCommand(false,true,false);
-      else if(lastCommandChar == 'G')
-      {
-        processShowInputsCmd("");
-        displayActFlag = true;              //indicate activity on display
-      }
-      else  //empty command line and no repeat command
-        displayActFlag = true;              //indicate activity on display
+    TIMESTATS_END(TSTAT_COMMAND,cmdStartUs);
+  }
+  else //received command line is empty,
+  {    // repeat last command (if one of those below)
+    const char lastCommandChar = getLastCommandChar();
+    if(lastCommandChar == 'R')
+    {
+      if(!repeatShowCurrentRssi())        //if not 'L' list then
+        displayActFlag = true;            //indicate activity on display
+    }
+    else if(lastCommandChar == 'N')
+      autoScanTuneNextChan("",true,true);
+    else if(lastCommandChar == 'P')
+      autoScanTuneNextChan("",false,true);
+    else if(lastCommandChar == 'B')
+      processIncFreqCodeCommand(true,true,false);
+    else if(lastCommandChar == 'C')
+      processIncFreqCodeCommand(false,true,false);
+    else if(lastCommandChar == 'G')
+    {
+      processShowInputsCmd("");
+      displayActFlag = true;              //indicate activity on display
+    }
+    else  //empty command line and no repeat command
+      displayActFlag = true;              //indicate activity on display
+  }
+       //if display connected and flag was set then show "extra" activity:
+  if(displayConnectedFlag && displayActFlag && !buttonInFlag)
+    updateActivityIndicator(true);
+}
+
+//Starts a command that is done in steps.  The steps are done by the
+// command task, each one when the serial port has room for its output
+// (up to CMDSTEP_OUTMAX bytes), so that a long output does not hold up
+// the other tasks.  New commands are not taken until the steps are done.
+// stepFn:  function that does a step; it is passed a pointer to a
+//          position value (starting at zero) that it advances, and
+//          returns false after the last step.
+void startCommandSteps(boolean (*stepFn)(uint16_t *posPtr))
+{
+  loopCmdStepFn = stepFn;
+  loopCmdStepPos = 0;
+}
+
+//Starts showing the given text (in program memory) via command steps.
+// textPtr:  text, with each line ending in '\n'; a line beginning with
+//           CMDTEXT_DISPONLY_CHR is only shown if the display is connected.
+void startTextCommandSteps(const char *textPtr)
+{
+  loopCmdStepTextPtr = textPtr;
+  startCommandSteps(showTextStep);
+}
+
+//Command step that shows the next part of the text setup via
+// 'startTextCommandSteps()', up to the end of the current line.
+// posPtr:  pointer to position in text.
+// Returns true if there is more text to show; false if done.
+boolean showTextStep(uint16_t *posPtr)
+{
+  uint16_t p = *posPtr;
+  char ch = (char)pgm_read_byte_near(loopCmdStepTextPtr+p);
+  while(ch == CMDTEXT_DISPONLY_CHR)
+  {  //line is only shown if display is connected
+    ++p;
+    if(displayConnectedFlag)
+      break;
+    do       //display not connected; skip line
+      ch = (char)pgm_read_byte_near(loopCmdStepTextPtr+(p++));
+    while(ch != '\n' && ch != '\0');
+    if(ch == '\0')
+      return false;
+    ch = (char)pgm_read_byte_near(loopCmdStepTextPtr+p);
+  }
+  uint8_t count = 0;
+  while((ch=(char)pgm_read_byte_near(loopCmdStepTextPtr+p)) != '\0')
+  {  //for each character shown (leaving room for line end)
+    ++p;
+    if(ch == '\n')
+    {  //end of line
+      Serial.println();
+      break;
+    }
+    Serial.print(ch);
+    if(++count >= CMDSTEP_OUTMAX-2)
+      break;
+  }
+  *posPtr = p;
+  return (pgm_read_byte_near(loopCmdStepTextPtr+p) != (uint8_t)0);
+}
+
+//Does the steps of the command in progress (if any) for which the
+// serial port has room.
+void processCommandSteps()
+{
+  while(loopCmdStepFn != NULL && outQueueDirectHasRoom(CMDSTEP_OUTMAX))
+  {  //command in steps is in progress and output will not have to wait
+    if(!(*loopCmdStepFn)(&loopCmdStepPos))
+      loopCmdStepFn = NULL;       //last step done
+  }
+}
+
+//Task that does the next step of a scan job in progress.  The step
+// waits while a command is showing its output in steps (so the scan
+// output follows it).
+void scanStepTask()
+{
+  if(isScanJobInProgress() && loopCmdStepFn == NULL)
+    processScanJobStep();
+}
+
+//Task that does continuous-RSSI output (when enabled).
+void contRssiTask()
+{
+  if(!contRssiOutFlag || isScanJobInProgress())
+    return;
+  if(contRssiIntervalMs > 0 && !checkContRssiSampleDue())
+    return;                            //not yet time for next sample
+  const uint16_t rVal = showCurrentRssi(contRssiListFlag,false);
+  updateRssiOutValue(rVal);            //update analog-RSSI output
+  if(!displayConnectedFlag)            //if no display then
+    updateActivityIndicator(true);     //indicate "extra" activity
+}
+
+//Task that does auto-tune-monitor mode (when enabled).
+void monitorTask()
+{
+  if(!monitorModeNextFlag || contRssiOutFlag || isScanJobInProgress())
+    return;
+  monitorAutoTuneNextChan();
+  updateRssiOutput();                  //update analog-RSSI output
+}
+
+//Task that updates the analog-RSSI output (when no output mode enabled).
+void rssiOutTask()
+{
+  if(!isOutputModeInProgress())
+    updateRssiOutput();
+}
+
+//Task that does a scheduled save of the tuned frequency to EEPROM, or
+// a save of the list entered via the 'L' command or of the RSSI-scaling
+// values set via auto calibration (which may be adjusted while scanning,
+// where the EEPROM writes would stall the scan).  At most one byte is written per run (an EEPROM write takes
+// about 3.4 ms), so a save does not hold up the other tasks.
+void eepromSaveTask()
+{
+  if(isScanJobInProgress())
+    return;
+  if(delayedSaveFreqToEepromFlag && millis() > delayedSaveFreqToEepromTime)
+  {  //save freq to EEPROM scheduled and time reached (and not scanning)
+    if(saveCurrentFreqToEepromStep())
+      delayedSaveFreqToEepromFlag = false;
+  }
+  else if(delayedSaveFreqListFlag)
+  {  //save list entered via 'L' command (and not scanning)
+    if(saveListFreqsMHzArrToEepromStep())
+      delayedSaveFreqListFlag = false;
+  }
+  else if(delayedSaveRssiMinMaxFlag)
+  {  //save auto-calibrated RSSI-scaling values (and not scanning)
+    if(saveRssiMinMaxValsToEepromStep())
+    {  //save done
+      delayedSaveRssiMinMaxFlag = false;
+      showRssiMinMaxCalibValues();
     }
-         //if display connected and flag was set then show "extra" activity:
-    if(displayConnectedFlag && displayActFlag && !buttonInFlag)
-      updateActivityIndicator(true);
   }
-  else  //no input-command data received
+}
+
+//Task that updates the activity indicator (when idle).
+void indicatorTask()
+{
+  if(!isOutputModeInProgress() && loopSerialLineStr == NULL &&
+                                                   loopButtonCmdStr == NULL)
+  {  //no output mode and no input-command data received
     updateActivityIndicator(false);         //indicate normal activity
+  }
 }
 
 //Processes "extra" (X) command.
@@ -543,7 +1058,7 @@ boolean processExtraCommand(const char *cmdStr)
       processShowFreqPresetListCmd(&cmdStr[p+1]);
       break;
     case 'P':      //show all frequency-list presets
-      freqListPresetShowAllSets();
+      startCommandSteps(freqListPresetShowAllSetsStep);
       break;
     case 'B':      //decrement band on tuned-frequency code
       processIncFreqCodeCommand(true,false,false);
@@ -551,8 +1066,8 @@ boolean processExtraCommand(const char *cmdStr)
     case 'C':      //decrement channel on tuned-frequency code
       processIncFreqCodeCommand(false,false,false);
       break;
-    case 'F':      //perform and report full scan of all freqs
-      fullScanShowRssiValues();
+    case 'F':      //perform and report full scan of all freqs (or range)
+      processFullScanCommand(&cmdStr[p+1]);
       break;
     case 'X':      //show index values for frequencies (devel)
       processListTranslateInfoCmd(&cmdStr[p+1]);
@@ -569,6 +1084,29 @@ boolean processExtraCommand(const char *cmdStr)
     case 'K':      //check/report calc vs table values (debug)
       checkReportTableValues();
       break;
+    case 'W':      //measure and show RX5808 tune-write time (devel)
+      showTuneWriteTime();
+      break;
+    case 'S':      //streaming sweeps until input
+      startStreamSweepJob();
+      retFlag = false;        //no indicator (scan shows activity)
+      break;
+    case 'Y':      //stream raw-RSSI trace until input
+      startRssiTraceJob();
+      retFlag = false;        //no indicator (scan shows activity)
+      break;
+    case 'O':      //binary-framed output off/on
+      processBinaryFramesCommand(&cmdStr[p+1]);
+      break;
+    case 'E':      //set or show user-defined bands
+      processCustomBandsCommand(&cmdStr[p+1]);
+      break;
+    case 'Q':      //show or reset output-queue statistics (devel)
+      processOutQueueStatsCommand(&cmdStr[p+1]);
+      break;
+    case 'V':      //show or clear RSSI flight-recorder entries
+      processRecorderCommand(&cmdStr[p+1]);
+      break;
     case 'Z':      //soft reboot
       processSoftRebootCommand(&cmdStr[p+1]);
       break;
@@ -584,95 +1122,146 @@ boolean processExtraCommand(const char *cmdStr)
   return retFlag;
 }
 
-//Displays help screen.
+    //help text for commands (a line beginning with CMDTEXT_DISPONLY_CHR
+    // is only shown if the display is connected):
+const char helpTextPArray[] PROGMEM =
+  " Commands:\n"
+  "  T [freq]    : Tune receiver to given MHz or XX code\n"
+  "  A           : Auto-scan and tune to highest-RSSI channel\n"
+  "  N [minRSSI] : Auto-scan and tune to next channel\n"
+  "  P [minRSSI] : Auto-scan and tune to previous channel\n"
+  "  M [seconds] : Auto-scan and monitor channels\n"
+  "  S [minRSSI] : Scan and report channels with highest RSSI\n"
+  "  F [minRSSI] : Scan and report RSSI for full set of channels\n"
+  "  L [list]    : List of freqs of interest (LH for help)\n"
+  "  R           : Read RSSI for current channel (RL for 'L' freqs)\n"
+  "  O [rate[,n]]: Continuous RSSI display (OL for 'L' freqs)\n"
+  "  U / D       : Change tuned frequency up/down by one MHz\n"
+  "  B / C       : Increment band/channel on tuned-frequency code\n"
+  "  X           : Extra commands (XH for help)\n"
+#if DISP7SEG_ENABLED_FLAG
+  "\001  #           : Toggle showing live RSSI on display\n"
+#endif
+#if BUTTONS_ENABLED_FLAG
+  "  =           : Set or show button mode value\n"
+#endif
+  "  V           : Show program-version information\n"
+  "  I           : Show frequency-table information\n"
+  "  H or ?      : Show help information\n";
+
+//Displays help screen (via command steps).
 void showHelpInformation()
 {
   showRevisionInfo(false);
-  Serial.println(F(" Commands:"));
-  Serial.println(F("  T [freq]    : Tune receiver to given MHz or XX code"));
-  Serial.println(F("  A           : Auto-scan and tune to highest-RSSI channel"));
-  Serial.println(F("  N [minRSSI] : Auto-scan and tune to next channel"));
-  Serial.println(F("  P [minRSSI] : Auto-scan and tune to previous channel"));
-  Serial.println(F("  M [seconds] : Auto-scan and monitor channels"));
-  Serial.println(F("  S [minRSSI] : Scan and report channels with highest RSSI"));
-  Serial.println(F("  F [minRSSI] : Scan and report RSSI for full set of channels"));
-  Serial.println(F("  L [list]    : List of freqs of interest (LH for help)"));
-  Serial.println(F("  R           : Read RSSI for current channel (RL for 'L' freqs)"));
-  Serial.println(F("  O           : Continuous RSSI display (OL for 'L' freqs)"));
-  Serial.println(F("  U / D       : Change tuned frequency up/down by one MHz"));
-  Serial.println(F("  B / C       : Increment band/channel on tuned-frequency code"));
-  Serial.println(F("  X           : Extra commands (XH for help)"));
+  startTextCommandSteps(helpTextPArray);
+}
+
+    //help text for 'X' commands (a line beginning with CMDTEXT_DISPONLY_CHR
+    // is only shown if the display is connected):
+const char extraHelpTextPArray[] PROGMEM =
+  " Extra commands:\n"
+  "  XJ [min,max]  : Set or show RSSI-scaling values\n"
+  "  XJ default    : Set RSSI-scaling values to defaults\n"
+  "  XA [0|1|R]    : Disable/enable/restart auto RSSI calib\n"
+  "  XT [timeMs]   : Set or show RX5808 min-tune time (ms)\n"
+  "  XM [minRSSI]  : Set or show minimum RSSI for scans\n"
+  "  XI [seconds]  : Set or show monitor-mode interval\n"
+  "  XU [text]     : Set or show Unit-ID string\n"
+  "  XR or ~       : Read and show RSSI (with channel info)\n"
+  "  XB / XC       : Decrement band/channel on tuned-freq code\n"
+  "  XF            : Perform and report full scan of all freqs\n"
+  "  XF lo,hi,step[,n] : Scan range (MHz) with 'n' samples/freq\n"
 #if DISP7SEG_ENABLED_FLAG
-  if(displayConnectedFlag)
-    Serial.println(F("  #           : Toggle showing live RSSI on display"));
+  "\001  XD [chars]    : Show given chars on display\n"
 #endif
-#if BUTTONS_ENABLED_FLAG
-  Serial.println(F("  =           : Set or show button mode value"));
+  "  XP            : Show all frequency-list presets\n"
+  "  XL [name]     : Show frequency list for preset name\n"
+  "  XX [list]     : Show index values for frequencies (devel)\n"
+  "  XK            : Show frequency table values (devel)\n"
+  "  XW            : Show RX5808 tune-write time (devel)\n"
+  "  XS            : Stream sweeps of channels until input\n"
+  "  XY            : Stream raw-RSSI trace until input\n"
+  "  XO [0|1]      : Set or show binary-framed output off/on\n"
+#if CUSTOM_BANDS_MAXCOUNT > 0
+  "  XE [b [list]] : Set, remove or show user-defined bands\n"
 #endif
-  Serial.println(F("  V           : Show program-version information"));
-  Serial.println(F("  I           : Show frequency-table information"));
-  Serial.println(F("  H or ?      : Show help information"));
-}
+  "  XQ [R|H|T]    : Show/reset queue/timing stats, histograms or tasks\n"
+#if RSSI_RECORDER_FLAG
+  "  XV [C]        : Show or clear RSSI flight-recorder entries\n"
+#endif
+  "  XZ [defaults] : Perform soft program reboot\n"
+  "  X, XH or X?   : Show extra help information\n";
 
-//Displays help screen for 'X' commands.
+//Displays help screen for 'X' commands (via command steps).
 void showExtraHelpInformation()
 {
-  Serial.println(F(" Extra commands:"));
-  Serial.println(F("  XJ [min,max]  : Set or show RSSI-scaling values"));
-  Serial.println(F("  XJ default    : Set RSSI-scaling values to defaults"));
-  Serial.println(F("  XA [0|1|R]    : Disable/enable/restart auto RSSI calib"));
-  Serial.println(F("  XT [timeMs]   : Set or show RX5808 min-tune time (ms)"));
-  Serial.println(F("  XM [minRSSI]  : Set or show minimum RSSI for scans"));
-  Serial.println(F("  XI [seconds]  : Set or show monitor-mode interval"));
-  Serial.println(F("  XU [text]     : Set or show Unit-ID string"));
-  Serial.println(F("  XR or ~       : Read and show RSSI (with channel info)"));
-  Serial.println(F("  XB / XC       : Decrement band/channel on tuned-freq code"));
-  Serial.println(F("  XF            : Perform and report full scan of all freqs"));
-#if DISP7SEG_ENABLED_FLAG
-  if(displayConnectedFlag)
-    Serial.println(F("  XD [chars]    : Show given chars on display"));
-#endif
-  Serial.println(F("  XP            : Show all frequency-list presets"));
-  Serial.println(F("  XL [name]     : Show frequency list for preset name"));
-  Serial.println(F("  XX [list]     : Show index values for frequencies (devel)"));
-  Serial.println(F("  XK            : Show frequency table values (devel)"));
-  Serial.println(F("  XZ [defaults] : Perform soft program reboot"));
-  Serial.println(F("  X, XH or X?   : Show extra help information"));
+  startTextCommandSteps(extraHelpTextPArray);
 }
 
-//Displays help screen for 'L' command.
+    //help text for 'L' command:
+const char listHelpTextPArray[] PROGMEM =
+  " Frequency-list command:\n"
+  "  L [list]    : Set list of freq (MHz) values of interest\n"
+  "  L           : Show list of freq (MHz) values of interest\n"
+  "  L 0         : Clear list of freq values of interest\n"
+  "  L +values   : Add values to current list\n"
+  "  L -values   : Remove values from current list\n"
+  "  L S         : Load list of freqs via RSSI scan\n"
+  "  L H         : Show help information for 'L' command\n"
+  " When a list is entered, the frequencies in the list will be the only ones\n"
+  " scanned and selected by the 'A', 'S', 'N', 'P' and 'M' commands.  The 'RL'\n"
+  " and 'OL' commands will scan and display RSSI values for the frequencies in\n"
+  " the list.  Entering 'L 0' will clear the list.  The '+' and '-' operators\n"
+  " may be used to add and remove frequencies, and may be mixed together\n"
+  " (i.e., 'L +5740 -5905').  The 'L S' command will load the list with the\n"
+  " frequency set returned by the last scan ('S' command), or will perform a\n"
+  " scan and load the detected values.  Frequency-list-preset names may also\n"
+  " be used as parameters to the 'L' command (i.e., 'L IMD5').  Available\n"
+  " presets may be displayed via the 'XP' command.\n";
+
+//Displays help screen for 'L' command (via command steps).
 void showListCmdHelpInformation()
 {
-  Serial.println(F(" Frequency-list command:"));
-  Serial.println(F("  L [list]    : Set list of freq (MHz) values of interest"));
-  Serial.println(F("  L           : Show list of freq (MHz) values of interest"));
-  Serial.println(F("  L 0         : Clear list of freq values of interest"));
-  Serial.println(F("  L +values   : Add values to current list"));
-  Serial.println(F("  L -values   : Remove values from current list"));
-  Serial.println(F("  L S         : Load list of freqs via RSSI scan"));
-  Serial.println(F("  L H         : Show help information for 'L' command"));
-  Serial.println(F(" When a list is entered, the frequencies in the list will be the only ones"));
-  Serial.println(F(" scanned and selected by the 'A', 'S', 'N', 'P' and 'M' commands.  The 'RL'"));
-  Serial.println(F(" and 'OL' commands will scan and display RSSI values for the frequencies in"));
-  Serial.println(F(" the list.  Entering 'L 0' will clear the list.  The '+' and '-' operators"));
-  Serial.println(F(" may be used to add and remove frequencies, and may be mixed together"));
-  Serial.println(F(" (i.e., 'L +5740 -5905').  The 'L S' command will load the list with the"));
-  Serial.println(F(" frequency set returned by the last scan ('S' command), or will perform a"));
-  Serial.println(F(" scan and load the detected values.  Frequency-list-preset names may also"));
-  Serial.println(F(" be used as parameters to the 'L' command (i.e., 'L IMD5').  Available"));
-  Serial.println(F(" presets may be displayed via the 'XP' command."));
-}
-
-//Displays frequency table.
+  startTextCommandSteps(listHelpTextPArray);
+}
+
+//Displays frequency table (via command steps).
 void showFrequencyTable()
 {
-  Serial.println(F(" Frequency Table    1     2     3     4     5     6     7     8"));
-  Serial.println(F(" Frequency band A  5865  5845  5825  5805  5785  5765  5745  5725"));
-  Serial.println(F(" Frequency band B  5733  5752  5771  5790  5809  5828  5847  5866"));
-  Serial.println(F(" Frequency band E  5705  5685  5665  5645  5885  5905  5925  5945"));
-  Serial.println(F(" Frequency band F  5740  5760  5780  5800  5820  5840  5860  5880"));
-  Serial.println(F(" Frequency band R  5658  5695  5732  5769  5806  5843  5880  5917"));
-  Serial.println(F(" Frequency band L  5362  5399  5436  5473  5510  5547  5584  5621"));
+  startCommandSteps(showFrequencyTableStep);
+}
+
+//Command step that shows the next part of the frequency table:  half of
+// the heading, the code for a band, or a channel frequency.
+// posPtr:  pointer to position in table.
+// Returns true if there is more to show; false if done.
+boolean showFrequencyTableStep(uint16_t *posPtr)
+{
+  const uint16_t pos = (*posPtr)++;
+  if(pos == 0)
+  {  //first half of heading
+    Serial.print(F(" Frequency Table    1     2     3"));
+    return true;
+  }
+  if(pos == 1)
+  {  //second half of heading
+    Serial.println(F("     4     5     6     7     8"));
+    return (getNumFreqBands() > 0);
+  }
+  const int bandIdx = (pos-2) / (CHANNEL_BAND_SIZE+1);
+  const int itemIdx = (pos-2) % (CHANNEL_BAND_SIZE+1);
+  if(itemIdx == 0)
+  {  //start of row for band (built-in or user-defined) in channel table
+    Serial.print(F(" Frequency band "));
+    Serial.print(getFreqBandCode(bandIdx));
+    return true;
+  }
+  Serial.print(F("  "));
+  Serial.print(getChannelFreqTableEntry(bandIdx*CHANNEL_BAND_SIZE+itemIdx-1));
+  if(itemIdx < CHANNEL_BAND_SIZE)
+    return true;
+  Serial.println();
+  return (bandIdx+1 < getNumFreqBands());
 }
 
 //Shows the "Unable to parse value" message via serial.
@@ -828,30 +1417,20 @@ void processFreqsMHzList(const char *listStr)
   }
   if((listStr[sPos] == 'S' || listStr[sPos] == 's') && sPos+1 == sLen)
   {  //use frequency values from band scan
-    numItems = listFreqsMHzArrCount;   //save current count
-    listFreqsMHzArrCount = 0;          //clear any existing entries
     if(idxSortedSelArrCount <= 0 ||
-               millis() >= lastNextTuneScanTime + NEXT_CHAN_RESCANSECS*1000)
+               millis() >= lastNextTuneScanTime + NEXT_CHAN_RESCANSECS*1000L)
     {  //no freqs available from previous scan or too much time elapsed
-      if(!scanChannelsAndReport(sessionDefMinRssiLevel,   //do band scan now
-                          sessionDefMinRssiLevel,false,true,serialEchoFlag))
-      {  //no channels with high enough RSSI found
-        listFreqsMHzArrCount = numItems;    //keep existing list (if any)
-        return;
-      }
-    }
-    if(idxSortedSelArrCount <= 0)
-      return;      //abort if no freqs available (shouldn't happen)
-    for(numItems=0; numItems<idxSortedSelArrCount; ++numItems)
-    {  //for each index value in array; fetch and copy frequency value
-      listFreqsMHzArr[numItems] = getChannelFreqTableEntry(
-                                            idxSortedSelectedArr[numItems]);
+      listLoadPrevCount = listFreqsMHzArrCount;     //save current count
+      listFreqsMHzArrCount = 0;        //scan all channels (not list)
+      startChansScanJob(SCANJOB_ACT_LISTLOAD,false,true,0);
+      return;      //list is loaded when scan job is done
     }
-    idxSortedSelArrCount = 0;  //idxSortedSelectedArr[] values no longer valid
+    loadFreqsMHzListFromScan();
+    return;
   }
   else
   {  //don't use frequency values from band scan
-    idxSortedSelArrCount = 0;  //idxSortedSelectedArr[] values no longer valid
+    invalidateSpectrumModel();     //model entries no longer valid
     const int listStrLen = strlen(listStr);
     boolean plusFlag = false, minusFlag = false, firstFlag = true;
     int val, ePos, psetCount;
@@ -952,8 +1531,34 @@ void processFreqsMHzList(const char *listStr)
       firstFlag = false;
     }
   }
+  storeFreqsMHzList(numItems);
+}
+
+//Loads the 'listFreqsMHzArr[]' array with the frequencies for the
+// channels selected by the last scan (for the 'L S' command), then
+// saves and shows the list.
+void loadFreqsMHzListFromScan()
+{
+  if(idxSortedSelArrCount <= 0)
+    return;        //abort if no freqs available (shouldn't happen)
+  int numItems;
+  for(numItems=0; numItems<idxSortedSelArrCount; ++numItems)
+  {  //for each index value in array; fetch and copy frequency value
+    listFreqsMHzArr[numItems] = getChannelFreqTableEntry(
+                                            idxSortedSelectedArr[numItems]);
+  }
+  invalidateSpectrumModel();     //model entries no longer valid
+  storeFreqsMHzList(numItems);
+}
+
+//Sets the number of entries in the 'listFreqsMHzArr[]' array, schedules
+// the save of the list to EEPROM (done via the EEPROM-save task) and
+// shows it.
+// numItems:  number of entries.
+void storeFreqsMHzList(int numItems)
+{
   listFreqsMHzArrCount = numItems;
-  saveListFreqsMHzArrToEeprom();       //store new list in EEPROM
+  delayedSaveFreqListFlag = true;      //store new list in EEPROM
   Serial.print(' ');    //start with leading space (so ignored by slave recvr)
   if(serialEchoFlag)
   {  //echo on; show list of frequencies entered
@@ -996,30 +1601,40 @@ void showFreqsMHzList()
 //Processes the show-RSSI command.  May have 'L' parameter to show
 // RSSI values for frequencies entered via 'L' command.
 // contFlag:  true if 'O' command (continuous output); false if 'R' command.
+//For the 'O' command, "rate[,n]" parameters may follow (after the 'L'
+// parameter, if given) to output samples at a fixed rate (per second),
+// with 'n' RSSI readings averaged for each sample.
 void processShowRssiCmd(const char *valueStr, boolean contFlag)
 {
   const int sLen = strlen(valueStr);
   int p = 0;
   while(valueStr[p] == ' ' && ++p < sLen);  //ignore any leading spaces
-  if(p >= sLen)
-  {  //no parameter given
-    if(contFlag)
-    {  //'O' command
-      contRssiOutFlag = true;     //start continuous-RSSI display
-      contRssiListFlag = false;   //don't show for 'L' list
-      contRssiPrevFreqVal = 0;    //don't need to restore frequency
-      clearSerialInputPromptFlag();    //suppress '>' serial prompt
-    }
-    else  //'R' command
-      showCurrentRssi(false,false);    //show RSSI for currently-tuned freq
-    return;
+  const boolean listFlag = (p < sLen &&
+                                  (valueStr[p] == 'L' || valueStr[p] == 'l'));
+  if(listFlag)     //if 'L' parameter then ignore any spaces after it
+    while(++p < sLen && valueStr[p] == ' ');
+  if(contFlag)
+  {  //'O' command; parse any rate and averaging-window parameters
+    if(!parseContRssiParams(&valueStr[p]))
+      return;
   }
-  if(valueStr[p] != 'L' && valueStr[p] != 'l')
-  {  //parameter is not 'L'
+  else if(p < sLen)
+  {  //'R' command with parameter that is not 'L'
     Serial.print(F(" Invalid parameter:  "));
     Serial.println(&valueStr[p]);
     return;
   }
+  if(!listFlag)
+  {  //no 'L' parameter given
+    if(contFlag)
+    {  //'O' command
+      contRssiPrevFreqVal = 0;    //don't need to restore frequency
+      startContRssiOutput(false); //start continuous-RSSI display
+    }
+    else  //'R' command
+      showCurrentRssi(false,false);    //show RSSI for currently-tuned freq
+    return;
+  }
   if(listFreqsMHzArrCount <= 0)
   {
     Serial.println(F(" Frequency list (via 'L' command) is empty"));
@@ -1028,10 +1643,8 @@ void processShowRssiCmd(const char *valueStr, boolean contFlag)
          //frequency list was entered via 'L' command
   if(contFlag)
   {  //'OL' command
-    contRssiOutFlag = true;     //start continuous-RSSI display
-    contRssiListFlag = true;    //show for 'L' list
     contRssiPrevFreqVal = currentTunerFreqMhzOrCode;     //save tuned freq
-    clearSerialInputPromptFlag();      //suppress '>' serial prompt
+    startContRssiOutput(true);         //start continuous-RSSI display
   }
   else
   {  //'RL' command
@@ -1041,75 +1654,275 @@ void processShowRssiCmd(const char *valueStr, boolean contFlag)
   }
 }
 
+//Parses the "rate[,n]" parameters for the 'O' command and sets up the
+// continuous-RSSI sample interval and averaging window.  If no parameters
+// are given then the output is free-running (as fast as possible).  The
+// values are reset when the output is stopped, so they are not carried
+// over to the next 'O' command.
+// Returns:  true if successful; false if error (message shown).
+boolean parseContRssiParams(const char *valueStr)
+{
+  const int sLen = strlen(valueStr);
+  int valsArr[2];
+  int numVals = 0, p = 0;
+  while(p < sLen && numVals < 2)
+  {  //for each parameter value
+    if(!convStrToInt(&valueStr[p],&valsArr[numVals]))
+      break;
+    ++numVals;
+    while(p < sLen && valueStr[p] >= '0' && valueStr[p] <= '9')
+      ++p;              //scan through digits
+    while(p < sLen && valueStr[p] == ' ')
+      ++p;              //scan through spaces
+    if(p < sLen && valueStr[p] == ',')
+      ++p;              //scan through comma
+    while(p < sLen && valueStr[p] == ' ')
+      ++p;              //scan through spaces
+  }
+  if(p < sLen)
+  {  //unable to parse
+    Serial.print(F(" Invalid parameter:  "));
+    Serial.println(valueStr);
+    return false;
+  }
+  if(numVals < 2)
+    valsArr[1] = 1;               //if no window value then use 1
+  if(numVals > 0 && (valsArr[0] < 1 || valsArr[0] > CONTRSSI_MAX_RATE))
+  {
+    Serial.print(F(" Rate must be 1 to "));
+    Serial.println(CONTRSSI_MAX_RATE);
+    return false;
+  }
+  if(valsArr[1] < 1 || valsArr[1] > CONTRSSI_MAX_WINDOW)
+  {
+    Serial.print(F(" Averaging window must be 1 to "));
+    Serial.println(CONTRSSI_MAX_WINDOW);
+    return false;
+  }
+  contRssiIntervalMs = (numVals > 0) ?
+                     (uint16_t)((1000 + valsArr[0]/2) / valsArr[0]) : 0;
+  contRssiWindowCount = (uint8_t)valsArr[1];
+  return true;
+}
+
+//Starts continuous-RSSI output (using the sample interval and averaging
+// window set via 'parseContRssiParams()').
+// listFlag:  true to show RSSI values for frequencies entered via
+//            'L' command.
+void startContRssiOutput(boolean listFlag)
+{
+  contRssiOutFlag = true;              //start continuous-RSSI display
+  contRssiListFlag = listFlag;
+  contRssiSeqNum = 0;
+  contRssiSampleCount = 0;
+  contRssiLateCount = 0;
+  contRssiDroppedCount = 0;
+  contRssiStartTimeMs = millis();
+  contRssiNextTimeMs = contRssiStartTimeMs;
+  clearSerialInputPromptFlag();        //suppress '>' serial prompt
+}
+
+//Checks if it is time for the next fixed-rate continuous-RSSI sample.
+// If sample times were missed (because the previous sample took too
+// long) then they are skipped and counted as late, and the sample number
+// is advanced past them (so the gap is visible in the output).
+// Returns:  true if a sample should be taken now.
+boolean checkContRssiSampleDue()
+{
+  const unsigned long curTimeMs = millis();
+  if((long)(curTimeMs - contRssiNextTimeMs) < 0)
+    return false;
+  if(contRssiSampleCount > 0)
+    ++contRssiSeqNum;                  //advance to this sample time
+  const unsigned long lateMs = curTimeMs - contRssiNextTimeMs;
+  if(lateMs >= contRssiIntervalMs)
+  {  //one or more sample times were missed; skip them
+    const uint16_t missedCount = (uint16_t)(lateMs / contRssiIntervalMs);
+    contRssiLateCount += missedCount;
+    contRssiSeqNum += missedCount;
+    contRssiNextTimeMs += (unsigned long)missedCount * contRssiIntervalMs;
+  }
+  contRssiNextTimeMs += contRssiIntervalMs;
+  contRssiSampleTimeMs = curTimeMs - contRssiStartTimeMs;
+  ++contRssiSampleCount;
+  return true;
+}
+
+//Adds the sample number and time stamp for a fixed-rate continuous-RSSI
+// sample to the output, as " sampleNum,timeMs:" (or as the start of the
+// payload for a binary frame).
+void addContRssiTimeStamp()
+{
+  if(binFramesEnabledFlag)
+  {  //binary frames; add sample number and time to payload
+    binFrameAddWord(contRssiSeqNum);
+    binFrameAddWord((uint16_t)contRssiSampleTimeMs);
+    binFrameAddWord((uint16_t)(contRssiSampleTimeMs >> 16));
+    return;
+  }
+  outQueueAddChar(' ');
+  outQueueAddUint(contRssiSeqNum);
+  outQueueAddChar(',');
+  outQueueAddULong(contRssiSampleTimeMs);
+  outQueueAddChar(':');
+}
+
+//Shows the number of fixed-rate continuous-RSSI samples taken, and the
+// numbers of missed (late) sample times and dropped sample lines.
+void showContRssiStats()
+{
+  Serial.print(F(" Samples="));
+  Serial.print(contRssiSampleCount);
+  Serial.print(F(", late="));
+  Serial.print(contRssiLateCount);
+  Serial.print(F(", dropped="));
+  Serial.println(contRssiDroppedCount);
+}
+
 //Shows the current RSSI value(s).
 // showListFlag:  true to show RSSI values for frequencies entered via
 //                'L' command.
 // showChanFlag:  true to include channel info (only applies when
 //                'showListFlag==false').
+// The output is sent via the serial-output queue; for continuous RSSI
+// display the lines are droppable (if the serial port falls behind).
 // Returns:  The current RSSI value, or zero if more than one was shown.
 uint16_t showCurrentRssi(boolean showListFlag, boolean showChanFlag)
 {
   lastShowCurRssiListFlag = showListFlag;   //save for 'repeatShowCurrentRssi()'
+  lastShowCurRssiChanFlag = showChanFlag;   //save for 'addCurrentRssiValue()'
   if(showListFlag)
   {  //showing RSSI values for frequencies entered via 'L' command
     if(listFreqsMHzArrCount <= 0)
       return (uint16_t)0;              //if no list then abort
-    Serial.print(' ');
-    int i = 0;
-    uint16_t wordVal;
-    while(true)
-    {  //for each frequency value in list
-      if(serialEchoFlag)
-      {  //show extra info
-        Serial.print(listFreqsMHzArr[i]);
-        Serial.print('=');
-      }
-      const uint16_t freqVal = listFreqsMHzArr[i];
-      setCurrentFreqByMhzOrCode(freqVal);
+    sendCurrentRssiOutput(addListRssiValues,0);
 #if DISP7SEG_ENABLED_FLAG
-      if(displayConnectedFlag)
-      {  //display enabled; show freq code for freq value (if any)
-        if((wordVal=freqInMhzToFreqCode(freqVal,NULL)) > (uint16_t)0)
-          disp7SegSetOvrAsciiViaWord(wordVal,0);
-        else
-          disp7SegSetOvrShowDashes(0);    //if no freq code show dashes
-      }
+    if(displayConnectedFlag)
+      disp7SegClearOvrDisplay();
 #endif
-      waitRssiReady();               //delay after channel change
-      Serial.print((int)readRssiValue());
-      if(++i >= listFreqsMHzArrCount)
-        break;
-      Serial.print(',');
+    return (uint16_t)0;
+  }
+  waitRssiReady();              //make sure not too soon after chan change
+  const uint16_t rVal = readAvgRssiValue();
+  sendCurrentRssiOutput(addCurrentRssiValue,rVal);
+  return rVal;
+}
+
+//Sends output for 'showCurrentRssi()' via the given function.  For
+// continuous RSSI display the output is droppable (and dropped lines
+// are counted).
+// addFn:  function that adds the output.
+// val:  value passed to 'addFn'.
+void sendCurrentRssiOutput(void (*addFn)(uint16_t), uint16_t val)
+{
+  if(!contRssiOutFlag)
+    addFn(val);
+  else if(!outQueueSendDroppable(addFn,val))
+    ++contRssiDroppedCount;       //line was dropped
+}
+
+//Adds the RSSI values for the frequencies entered via the 'L' command to
+// the output (tuning to each frequency in turn).
+void addListRssiValues(uint16_t)
+{
+                   //check if fixed-rate continuous display (timestamped):
+  const boolean timedFlag = (contRssiOutFlag && contRssiIntervalMs > 0);
+  if(timedFlag)
+  {  //fixed-rate continuous display; start with sample # and time
+    if(binFramesEnabledFlag)
+    {
+      binFrameBegin(BINFRAME_TYPE_RSSILISTTIMED,
+                                       (uint8_t)(listFreqsMHzArrCount+6));
     }
-    Serial.println();
+    addContRssiTimeStamp();
+  }
+  else if(binFramesEnabledFlag)   //if binary frames then start list frame
+    binFrameBegin(BINFRAME_TYPE_RSSILIST,(uint8_t)listFreqsMHzArrCount);
+  else
+    outQueueAddChar(' ');
+  int i = 0;
+  uint16_t wordVal;
+  while(true)
+  {  //for each frequency value in list
+    if(serialEchoFlag && !binFramesEnabledFlag)
+    {  //show extra info
+      outQueueAddUint(listFreqsMHzArr[i]);
+      outQueueAddChar('=');
+    }
+    const uint16_t freqVal = listFreqsMHzArr[i];
+    setCurrentFreqByMhzOrCode(freqVal);
 #if DISP7SEG_ENABLED_FLAG
     if(displayConnectedFlag)
-      disp7SegClearOvrDisplay();
+    {  //display enabled; show freq code for freq value (if any)
+      if((wordVal=freqInMhzToFreqCode(freqVal,NULL)) > (uint16_t)0)
+        disp7SegSetOvrAsciiViaWord(wordVal,0);
+      else
+        disp7SegSetOvrShowDashes(0);    //if no freq code show dashes
+    }
 #endif
-    return (uint16_t)0;
+    waitRssiReady();                 //delay after channel change
+    if(binFramesEnabledFlag)
+    {  //binary frames; add RSSI value to list frame
+      binFrameAddByte((uint8_t)readAvgRssiValue());
+      if(++i >= listFreqsMHzArrCount)
+        break;
+      continue;
+    }
+    outQueueAddUint(readAvgRssiValue());
+    if(++i >= listFreqsMHzArrCount)
+      break;
+    outQueueAddChar(',');
   }
+  if(binFramesEnabledFlag)
+    binFrameEnd();
   else
-  {  //not showing RSSI values for frequencies entered via 'L' command
-    Serial.print(' ');
-    if(showChanFlag)
-    {  //showing channel info
-      Serial.print((int)getCurrentFreqInMhz());
-      const uint16_t codeVal = getCurrentFreqCodeWord();
-      if(codeVal > (uint16_t)0)
-      {  //frequency-code value available; show it
-        Serial.print((char)(codeVal >> (uint16_t)8));
-        Serial.print((char)(codeVal & (uint16_t)0x7F));
-      }
-      Serial.print('=');
+    outQueueAddNewline();
+}
+
+//Adds the given RSSI value for the currently-tuned frequency to the
+// output (with channel info if 'lastShowCurRssiChanFlag' is true).
+// rVal:  RSSI value.
+void addCurrentRssiValue(uint16_t rVal)
+{
+                   //check if fixed-rate continuous display (timestamped):
+  const boolean timedFlag = (contRssiOutFlag && contRssiIntervalMs > 0);
+  if(binFramesEnabledFlag)
+  {  //binary frames; send frequency and RSSI value
+    if(timedFlag)
+    {  //fixed-rate continuous display; start with sample # and time
+      binFrameBegin(BINFRAME_TYPE_RSSITIMED,10);
+      addContRssiTimeStamp();
     }
-    waitRssiReady();            //make sure not too soon after chan change
-    const uint16_t rVal = readRssiValue();
-    Serial.print((int)rVal);
-    if(monitorModeNextFlag)       //if auto-tune-monitor mode then
-      Serial.print(" M");         //append indicator
-    Serial.println();
-    return rVal;
+    else
+      binFrameBegin(BINFRAME_TYPE_RSSI,4);
+    binFrameAddWord(getCurrentFreqInMhz());
+    binFrameAddByte((uint8_t)rVal);
+    binFrameAddByte(monitorModeNextFlag ? BINFRAME_RSSI_MONITORFLAG : 0);
+    binFrameEnd();
+    return;
+  }
+  if(timedFlag)                 //if fixed-rate continuous display then
+    addContRssiTimeStamp();     //start with sample # and time
+  else
+    outQueueAddChar(' ');
+  if(lastShowCurRssiChanFlag)
+  {  //showing channel info
+    outQueueAddUint(getCurrentFreqInMhz());
+    const uint16_t codeVal = getCurrentFreqCodeWord();
+    if(codeVal > (uint16_t)0)
+    {  //frequency-code value available; show it
+      outQueueAddChar((char)(codeVal >> (uint16_t)8));
+      outQueueAddChar((char)(codeVal & (uint16_t)0x7F));
+    }
+    outQueueAddChar('=');
+  }
+  outQueueAddUint(rVal);
+  if(monitorModeNextFlag)
+  {  //auto-tune-monitor mode; append indicator
+    outQueueAddChar(' ');
+    outQueueAddChar('M');
   }
+  outQueueAddNewline();
 }
 
 //Repeats the last call to 'showCurrentRssi()' using the same 'showListFlag'
@@ -1184,8 +1997,10 @@ void processOneMHzCommand(boolean upFlag, boolean serialOutFlag)
       Serial.print(')');
     }
     waitRssiReady();            //delay after channel change
+    const uint16_t rssiVal = readRssiValue();
+    rssiRecAddReading(rssiVal);          //record value
     Serial.print("  ");
-    Serial.println((int)readRssiValue());
+    Serial.println((int)rssiVal);
   }
 }
 
@@ -1218,7 +2033,213 @@ void processIncFreqCodeCommand(boolean bandFlag, boolean upFlag,
   scheduleDelayedSaveFreqToEeprom(3);
 }
 
+//Selects the next (or previous) channel via the spectrum model (with
+// wrap around) and tunes it, for the auto-tune scan job.  The RSSI of the
+// channel is checked (via 'autoTuneCheckChannelRssi()') once it has
+// settled.
+// Returns true if a channel was tuned; false if not (in which case the
+// next channel should be tried).
+boolean autoTuneSelectNextChannel()
+{
+  if(scanJobForwardFlag)
+  {  //scanning forward; increment index (with wrap around)
+    if(++nextTuneChannelIndex >= idxSortedSelArrCount)
+      nextTuneChannelIndex = 0;      //select next (or first) channel
+  }
+  else
+  {  //scanning backward; decrement index (with wrap around)
+    if(nextTuneChannelIndex > 0)
+      --nextTuneChannelIndex;
+    else if(idxSortedSelArrCount > 0)
+      nextTuneChannelIndex = idxSortedSelArrCount - 1;
+  }
+  if(nextTuneChannelIndex >= idxSortedSelArrCount)
+    return false;                      //if channel index not OK then skip
+  const uint8_t chanIdx = idxSortedSelectedArr[nextTuneChannelIndex];
+  uint16_t freqVal;
+  if(listFreqsMHzArrCount > 0)
+  {  //using 'listFreqsMHzArr[]' entered via 'L' command; check index
+    freqVal = (chanIdx < listFreqsMHzArrCount) ?
+                                 listFreqsMHzArr[chanIdx] : (uint16_t)0;
+  }
+  else  //not using 'listFreqsMHzArr[]' entered via 'L' command
+    freqVal = getChannelFreqTableEntry(chanIdx);    //get freq via index
+  if(freqVal < MIN_CHANNEL_MHZ || freqVal > MAX_CHANNEL_MHZ)
+  {  //frequency value is out of range
+    Serial.print(F(" Channel frequency value out of range:  "));
+    Serial.println(freqVal);
+    return false;
+  }
+          //display messages and tune to frequency:
+  if(serialEchoFlag)
+  {  //serial-echo enabled; show output
+    Serial.print(F(" Tuning to frequency "));
+    if(!scanJobTuneFirstFlag)
+    {  //stepping through channels; show index and total
+      Serial.print('(');
+      Serial.print(nextTuneChannelIndex+1);
+      Serial.print('/');
+      Serial.print(idxSortedSelArrCount);
+      Serial.print(") ");
+    }
+    Serial.print(freqVal);
+    Serial.print(F("MHz"));
+    const uint16_t codeVal = freqInMhzToFreqCode((uint16_t)freqVal,NULL);
+    if(codeVal > (uint16_t)0)
+    {  //frequency-code value available; show it
+      Serial.print(" (");
+      Serial.print((char)(codeVal >> (uint16_t)8));
+      Serial.print((char)(codeVal & (uint16_t)0x7F));
+      Serial.print(')');
+    }
+  }
+  if(freqVal != getCurrentFreqInMhz())
+  {  //frequency is different from currently-tuned frequency
+           //if freq corresponds to a frequency code then use it:
+    uint16_t codeVal;
+    if((codeVal=freqInMhzToFreqCode(freqVal,NULL)) != (uint16_t)0)
+      setTunerChannelToFreq(codeVal);
+    else
+      setTunerChannelToFreq(freqVal);
+  }
+  else
+  {  //frequency same as current; make sure display matches freq
+#if DISP7SEG_ENABLED_FLAG
+    if(displayConnectedFlag)        //if display wired in then
+      showTunerChannelOnDisplay();  //update tuner channel on display
+#endif
+  }
+  scanJobTableIdx = chanIdx;
+  scanJobFreqVal = freqVal;
+  return true;
+}
+
+//Checks the (settled) RSSI of the channel tuned via
+// 'autoTuneSelectNextChannel()', for the auto-tune scan job.
+// rssiVal:  RSSI value read for the channel.
+// Returns true if finished; false if the next channel should be tried.
+boolean autoTuneCheckChannelRssi(uint8_t rssiVal)
+{
+  rssiRecAddReading(rssiVal);                       //record value
+  setSpectrumModelEntry(scanJobTableIdx,rssiVal);   //update model entry
+  if(serialEchoFlag)
+  {  //serial-echo enabled; show output
+    Serial.print(F(", RSSI="));
+    Serial.print((int)rssiVal);
+  }
+  const boolean rssiGoodFlag = (rssiVal >= scanJobMinRssiLevel/2);
+  if(scanJobTuneFirstFlag)
+  {  //scanning and tuning to highest-RSSI channel
+    if(!rssiGoodFlag)               //if RSSI low then
+      nextTuneChannelIndex = -1;    //rescan on next invocation
+    if(serialEchoFlag)
+      Serial.println();   //finish display line
+    return true;
+  }
+  if(scanJobAutoTuneScanDoneFlag || rssiGoodFlag)
+  {  //scan was just performed or RSSI value is high enough
+                //if flag and only one entry then
+                //setup to rescan on next invocation:
+    if(scanJobRescanOnSingleFlag && idxSortedSelArrCount <= 1)
+      nextTuneChannelIndex = -1;
+    if(serialEchoFlag)
+      Serial.println();   //finish display line
+    if(rssiGoodFlag)
+    {  //RSSI value is high enough
+      Serial.print('T');   //send tune cmd to possible slave receiver
+      Serial.println(scanJobFreqVal);
+    }
+    return true;
+  }
+      //scan was not just performed and RSSI value is low
+  if(serialEchoFlag)                     //try next selected channel
+    Serial.println(F(", skipping"));
+  return false;
+}
+
+//Starts a scan job that tunes the channels selected via the spectrum
+// model in turn (each at most once), until one with a high enough RSSI
+// is found.  Each channel is tuned on one step of the job and its RSSI is
+// checked on a later step, once it has settled (so other tasks are not
+// held up while waiting).
+// scanDoneFlag:  true if a scan was just performed (so the last channel
+//                tried is accepted, and no rescan is done).
+void startAutoTuneJob(boolean scanDoneFlag)
+{
+  scanJobAutoTuneScanDoneFlag = scanDoneFlag;
+  scanJobAutoTuneDoneFlag = false;
+  scanJobRestoreFreqVal = 0;
+  scanJobActionVal = SCANJOB_ACT_AUTOTUNE;
+  scanJobTunedFlag = false;
+  scanJobChanCount = 0;                //# of channels tried
+  scanJobSourceVal = SCANJOB_SRC_TUNE;
+}
+
+//Performs the next step of the auto-tune scan job:  tunes the next
+// selected channel, or (once the RSSI is ready) checks its RSSI.
+void processAutoTuneJobStep()
+{
+  if(!outQueueDirectHasRoom(CMDSTEP_OUTMAX))
+    return;                  //no room for output yet; do step later
+  if(!scanJobTunedFlag)
+  {  //next channel not yet tuned
+    if(scanJobChanCount >= idxSortedSelArrCount)
+    {  //all selected channels tried
+      finishScanJob(false);
+      return;
+    }
+    ++scanJobChanCount;
+    scanJobTunedFlag = autoTuneSelectNextChannel();
+    return;
+  }
+  if(!isRx5808RssiReady())   //if RSSI not settled after channel change
+    return;                  // then check again later
+  scanJobTunedFlag = false;
+  if(autoTuneCheckChannelRssi((uint8_t)readRssiValue()))
+  {  //channel accepted
+    scanJobAutoTuneDoneFlag = true;
+    finishScanJob(false);
+  }
+}
+
+//Finishes the auto-tune scan job.  If no channel was accepted (and a
+// scan was not just performed) then a scan is started.
+// abortFlag:  true if the job is being aborted.
+void finishAutoTuneJob(boolean abortFlag)
+{
+  if(abortFlag)
+  {  //job aborted; finish display line (if started)
+    if(scanJobTunedFlag && serialEchoFlag)
+      Serial.println(F(", aborted"));
+    return;
+  }
+  if(!scanJobAutoTuneDoneFlag && !scanJobAutoTuneScanDoneFlag)
+    startAutoTuneScanJob();            //no channel accepted; do scan
+}
+
+//Starts the scan job for the auto-scan-and-tune functions; the channel
+// is tuned (via 'finishAutoScanTuneChannel()') when the scan is done.
+// The parameters are in the 'scanJob...' variables (set via
+// 'doAutoScanTuneChannel()').
+void startAutoTuneScanJob()
+{
+  nextTuneChannelIndex = -1;         //setup to select first channel
+  uint8_t minAgeSecs = 0;            //do full scan if always-scan or no model
+  if(!scanJobTuneFirstFlag && idxSortedSelArrCount > 0)
+  {  //spectrum model available; only refresh stale entries
+    minAgeSecs = (idxSortedSelArrCount <= 1) ?
+                          NEXT_CHAN_SINGLE_RESCANSECS : NEXT_CHAN_RESCANSECS;
+  }
+  scanJobPrevFreqVal = currentTunerFreqMhzOrCode;
+  startChansScanJob(SCANJOB_ACT_AUTOTUNE,false,false,minAgeSecs);
+}
+
 //Auto scans frequencies and (successively) tunes to found channels.
+// If the spectrum model is fresh then the next selected channel is tuned
+// (via an auto-tune scan job); otherwise a scan job is started and the
+// tuning is finished (via 'finishAutoScanTuneChannel()') when the scan
+// is done.  If the RSSI of the tuned channel is low then the following
+// selected channels are tried (each at most once).
 // minRssiLevel:  minimum RSSI value for accepted channels.
 // scanAndTuneFirstFlag:  if true then a scan is always performed and the
 //                        channel with the highest RSSI is tuned.
@@ -1229,137 +2250,35 @@ void processIncFreqCodeCommand(boolean bandFlag, boolean upFlag,
 void doAutoScanTuneChannel(int minRssiLevel, boolean scanAndTuneFirstFlag,
                         boolean scanForwardFlag, boolean rescanOnSingleFlag)
 {
-  boolean scanDoneFlag = false;
-  while(1)
-  {  //will loop if tuning channel after scanning frequencies
-    if(scanDoneFlag || (!scanAndTuneFirstFlag && idxSortedSelArrCount > 1 &&
-              ((minRssiLevel <= 0 && listFreqsMHzArrCount > 0) ||
-               millis() < lastNextTuneScanTime + NEXT_CHAN_RESCANSECS*1000)))
-    {  //just did freq scan or scanned chans avail and not time to rescan
-       // (if 'scanAndTuneFirstFlag'==true then always do scan first)
-       // (if 'minRssi'==0 and using 'L' list don't scan because of timeout)
-      if(scanForwardFlag)
-      {  //scanning forward; increment index (with wrap around)
-        if(++nextTuneChannelIndex >= idxSortedSelArrCount)
-          nextTuneChannelIndex = 0;    //select next (or first) channel
-      }
-      else
-      {  //scanning backward; decrement index (with wrap around)
-        if(nextTuneChannelIndex > 0)
-          --nextTuneChannelIndex;
-        else if(idxSortedSelArrCount > 0)
-          nextTuneChannelIndex = idxSortedSelArrCount - 1;
-      }
-      if(nextTuneChannelIndex < idxSortedSelArrCount)
-      {  //channel index value OK
-        const uint8_t chanIdx = idxSortedSelectedArr[nextTuneChannelIndex];
-        uint16_t freqVal;
-        if(listFreqsMHzArrCount > 0)
-        {  //using 'listFreqsMHzArr[]' entered via 'L' command; check index
-          freqVal = (chanIdx < listFreqsMHzArrCount) ?
-                                     listFreqsMHzArr[chanIdx] : (uint16_t)0;
-        }
-        else  //not using 'listFreqsMHzArr[]' entered via 'L' command
-          freqVal = getChannelFreqTableEntry(chanIdx);  //get freq via index
-              //display messages and tune to frequency:
-        if(freqVal >= MIN_CHANNEL_MHZ && freqVal <= MAX_CHANNEL_MHZ)
-        {  //frequency value is in range
-          if(serialEchoFlag)
-          {  //serial-echo enabled; show output
-            Serial.print(F(" Tuning to frequency "));
-            if(!scanAndTuneFirstFlag)
-            {  //stepping through channels; show index and total
-              Serial.print('(');
-              Serial.print(nextTuneChannelIndex+1);
-              Serial.print('/');
-              Serial.print(idxSortedSelArrCount);
-              Serial.print(") ");
-            }
-            Serial.print(freqVal);
-            Serial.print(F("MHz"));
-            const uint16_t codeVal = freqInMhzToFreqCode((uint16_t)freqVal,NULL);
-            if(codeVal > (uint16_t)0)
-            {  //frequency-code value available; show it
-              Serial.print(" (");
-              Serial.print((char)(codeVal >> (uint16_t)8));
-              Serial.print((char)(codeVal & (uint16_t)0x7F));
-              Serial.print(')');
-            }
-          }
-          if(freqVal != getCurrentFreqInMhz())
-          {  //frequency is different from currently-tuned frequency
-                   //if freq corresponds to a frequency code then use it:
-            uint16_t codeVal;
-            if((codeVal=freqInMhzToFreqCode(freqVal,NULL)) != (uint16_t)0)
-              setTunerChannelToFreq(codeVal);
-            else
-              setTunerChannelToFreq(freqVal);
-          }
-          else
-          {  //frequency same as current; make sure display matches freq
-#if DISP7SEG_ENABLED_FLAG
-            if(displayConnectedFlag)        //if display wired in then
-              showTunerChannelOnDisplay();  //update tuner channel on display
-#endif
-          }
-          waitRssiReady();           //delay after channel change
-          const uint8_t rssiVal = readRssiValue();
-          if(serialEchoFlag)
-          {  //serial-echo enabled; show output
-            Serial.print(F(", RSSI="));
-            Serial.print((int)rssiVal);
-          }
-          const boolean rssiGoodFlag = (rssiVal >= minRssiLevel/2);
-          if(scanAndTuneFirstFlag)
-          {  //scanning and tuning to highest-RSSI channel
-            if(!rssiGoodFlag)               //if RSSI low then
-              nextTuneChannelIndex = -1;    //rescan on next invocation
-            if(serialEchoFlag)
-              Serial.println();   //finish display line
-            break;                //exit function
-          }
-          if(scanDoneFlag || rssiGoodFlag)
-          {  //scan was just performed or RSSI value is high enough
-                        //if flag and only one entry then
-                        //setup to rescan on next invocation:
-            if(rescanOnSingleFlag && idxSortedSelArrCount <= 1)
-              nextTuneChannelIndex = -1;
-            if(serialEchoFlag)
-              Serial.println();   //finish display line
-            if(rssiGoodFlag)
-            {  //RSSI value is high enough
-              Serial.print('T');   //send tune cmd to possible slave receiver
-              Serial.println(freqVal);
-            }
-            break;                //exit function
-          }
-              //scan was not just performed and RSSI value is low
-          if(serialEchoFlag)                     //do scan of frequencies now
-            Serial.println(F(", rescanning"));
-        }
-        else
-        {
-          Serial.print(F(" Channel frequency value out of range:  "));
-          Serial.println(freqVal);
-        }
-      }
-    }
-    if(scanDoneFlag)    //if scan already performed then
-      break;            //exit function
-    nextTuneChannelIndex = -1;         //setup to select first channel
-    const uint16_t prevFreqVal = currentTunerFreqMhzOrCode;
+  scanJobMinRssiLevel = minRssiLevel;
+  scanJobTuneFirstFlag = scanAndTuneFirstFlag;
+  scanJobForwardFlag = scanForwardFlag;
+  scanJobRescanOnSingleFlag = rescanOnSingleFlag;
+  if(!scanAndTuneFirstFlag && idxSortedSelArrCount > 1 &&
+                                         isSpectrumModelFresh(minRssiLevel))
+  {  //scanned chans avail and model entries fresh; tune next channel
+    startAutoTuneJob(false);
+    return;
+  }
+         //scan needed (if 'scanAndTuneFirstFlag'==true then always scan)
+  startAutoTuneScanJob();
+}
+
+//Finishes the auto-scan-and-tune function after the scan job (started
+// via 'startAutoTuneScanJob()') is done.
+void finishAutoScanTuneChannel()
+{
          //if always tuning highest-RSSI channel then use fallback-min
          // value of 0 so all channels are always accepted:
-    const int fallbackRssiLevel = scanAndTuneFirstFlag ? 0 : minRssiLevel;
-                        //do scan of frequencies:
-    if(!scanChannelsAndReport(minRssiLevel,fallbackRssiLevel,false,false,
+  const int fallbackRssiLevel = scanJobTuneFirstFlag ? 0 :
+                                                        scanJobMinRssiLevel;
+  if(!reportScannedChannels(scanJobMinRssiLevel,fallbackRssiLevel,false,
                                                             serialEchoFlag))
-    {  //no channels with high enough RSSI found
-      setTunerChannelToFreq(prevFreqVal);   //restore tuner frequency
-      break;            //exit function
-    }
-    scanDoneFlag = true;     //indicate successful scan was performed
-  }  //loop around and tune channel
+  {  //no channels with high enough RSSI found
+    setTunerChannelToFreq(scanJobPrevFreqVal);   //restore tuner frequency
+    return;
+  }
+  startAutoTuneJob(true);              //tune selected channel
 }
 
 //Auto scans frequencies and tunes to highest-RSSI channel.
@@ -1434,12 +2353,16 @@ void monitorAutoTuneNextChan()
 {
   const unsigned long curTime = millis();
   uint16_t curRssi = readRssiValue();  //get RSSI of current channel
+  if(nextTuneChannelIndex >= 0 && nextTuneChannelIndex < idxSortedSelArrCount)
+  {  //current channel selected via model; update model entry
+    setSpectrumModelEntry(idxSortedSelectedArr[nextTuneChannelIndex],
+                                                          (uint8_t)curRssi);
+  }
   long timeOffs = (long)monitorModeIntervalSecs * 1000;
   if(curRssi < MAX_RSSI_VAL*3/10)      //less than 30
   {  //RSSI of current channel is on the low side
     int curIdx;         //get highest RSSI value among all channels:
-    if((curIdx=idxSortedByRssiArr[0]) >= CHANNEL_MIN_INDEX &&
-                                            curIdx < LISTFREQMHZ_ARR_SIZE &&
+    if((curIdx=getChannelIdxAtRank(0)) >= CHANNEL_MIN_INDEX &&
                                 scanRssiValuesArr[curIdx] >= MAX_RSSI_VAL/2)
     {  //highest RSSI value is on the high side
               //reduce duration that current channel will be shown:
@@ -1454,29 +2377,24 @@ void monitorAutoTuneNextChan()
   }
 }
 
-//Scans and reports channels that have RSSI values above the limit.
-// If a list of frequencies was entered via the 'L' command then
-// it is used (unless the 'inclAllFlag' parameter is true).
-// This function blocks while the scanning is performed.
+//Reports channels (from the last scan) that have RSSI values above the
+// limit, and loads the 'idxSortedByRssiArr[]' and 'idxSortedSelectedArr[]'
+// arrays.
 // minRssiLevel:  minimum RSSI value for accepted channels.
 // fallbackRssiLevel:  alternate minimum RSSI value to use if RSSI of
 //                     all channels is below 'minRssiLevel'.
 // inclAllFlag:  true to include all frequencies; false to squelch
 //               frequencies adjacent to those already shown.
-// restoreFreqFlag:  true to restore tuner frequency on exit.
 // showOutputFlag:  show serial-output messages.
 //Returns true if one or more channels with high enough RSSI found;
 // false if all channels have low RSSI.
-boolean scanChannelsAndReport(int minRssiLevel, int fallbackRssiLevel,
-       boolean inclAllFlag, boolean restoreFreqFlag, boolean showOutputFlag)
+boolean reportScannedChannels(int minRssiLevel, int fallbackRssiLevel,
+                                 boolean inclAllFlag, boolean showOutputFlag)
 {
-         //scan frequencies and store received RSSI values:
-  scanChansGetRssiValues(USE_LBAND_FLAG,inclAllFlag,restoreFreqFlag,false);
   loadIdxSortedByRssiArr(inclAllFlag); //create list sorted by RSSI values
   lastNextTuneScanTime = millis();
   int curIdx;           //get highest RSSI value among all channels:
-  if((curIdx=idxSortedByRssiArr[0]) >= CHANNEL_MIN_INDEX &&
-                                            curIdx < LISTFREQMHZ_ARR_SIZE &&
+  if((curIdx=getChannelIdxAtRank(0)) >= CHANNEL_MIN_INDEX &&
                                    scanRssiValuesArr[curIdx] < minRssiLevel)
   {  //all RSSI values are below the minimum
     minRssiLevel = fallbackRssiLevel;       //use alternate minimum RSSI
@@ -1489,7 +2407,7 @@ boolean scanChannelsAndReport(int minRssiLevel, int fallbackRssiLevel,
   if(inclAllFlag)
   {  //show all frequencies (via tables)
     minIdx = CHANNEL_MIN_INDEX;
-    maxIdx = CHANNEL_MAX_INDEX;
+    maxIdx = getChannelMaxIndex();
     idxArr = idxSortedByRssiArr;       //use array with all frequencies
   }
   else if(!listFlag)
@@ -1502,11 +2420,28 @@ boolean scanChannelsAndReport(int minRssiLevel, int fallbackRssiLevel,
   {  //using 'listFreqsMHzArr[]' entered via 'L' command
     minIdx = 0;
     maxIdx = listFreqsMHzArrCount - 1;
-    for(int p=0; p<listFreqsMHzArrCount; ++p)    //copy to sel-freqs array
-      idxSortedSelectedArr[p] = idxSortedByRssiArr[p];
-    idxSortedSelArrCount = listFreqsMHzArrCount;
+    idxSortedSelArrCount = loadTopRankedChannelIdxs(  //copy to sel array
+                                 idxSortedSelectedArr,listFreqsMHzArrCount);
     idxArr = idxSortedSelectedArr;     //use array with copied indices
   }
+  const boolean textOutFlag = showOutputFlag && !binFramesEnabledFlag;
+  if(showOutputFlag && binFramesEnabledFlag)
+  {  //binary frames enabled; send report frame with (idx,rssi) pairs
+    int cnt = 0;
+    while(minIdx+cnt <= maxIdx &&
+                      scanRssiValuesArr[idxArr[minIdx+cnt]] >= minRssiLevel)
+    {  //count channels with RSSI level high enough
+      ++cnt;
+    }
+    binFrameBegin(BINFRAME_TYPE_SCANREPORT,(uint8_t)(cnt*2+1));
+    binFrameAddByte(listFlag ? BINFRAME_SCANRPT_LISTFLAG : 0);
+    for(int i=minIdx; i<minIdx+cnt; ++i)
+    {
+      binFrameAddByte(idxArr[i]);
+      binFrameAddByte(scanRssiValuesArr[idxArr[i]]);
+    }
+    binFrameEnd();
+  }
   for(int i=minIdx; i<=maxIdx; ++i)
   {  //for each possible channel
     curIdx = idxArr[i];    //get index from sorted list
@@ -1514,7 +2449,7 @@ boolean scanChannelsAndReport(int minRssiLevel, int fallbackRssiLevel,
     {  //RSSI level is high enough
       if(firstFlag)
         firstFlag = false;
-      if(showOutputFlag)
+      if(textOutFlag)
       {  //serial-output enabled
         Serial.print(' ');        //put in separator (or leading space)
         if(listFlag)
@@ -1532,8 +2467,11 @@ boolean scanChannelsAndReport(int minRssiLevel, int fallbackRssiLevel,
         nextTuneChannelIndex = -1;     //clear any current index
         if(showOutputFlag)
         {  //serial-output enabled
-          Serial.print(F(" No channels with RSSI at least "));
-          Serial.print(minRssiLevel);
+          if(textOutFlag)
+          {  //text output
+            Serial.print(F(" No channels with RSSI at least "));
+            Serial.print(minRssiLevel);
+          }
 #if DISP7SEG_ENABLED_FLAG              //show indicator on display
           if(displayConnectedFlag)
             disp7SegSetOvrAsciiValues('n',false,'c',false,1000);
@@ -1547,7 +2485,7 @@ boolean scanChannelsAndReport(int minRssiLevel, int fallbackRssiLevel,
       break;
     }
   }
-  if(showOutputFlag)
+  if(textOutFlag)
     Serial.println();
   if(nextTuneChannelIndex > 0 &&      //check RSSI entry for current channel
                               nextTuneChannelIndex < idxSortedSelArrCount &&
@@ -1556,7 +2494,6 @@ boolean scanChannelsAndReport(int minRssiLevel, int fallbackRssiLevel,
   {  //RSSI of current channel is below minimum; reset to first channel
     nextTuneChannelIndex = -1;     //clear any current index
   }
-  flushSerialInputLines();   //clear any commands received while busy scanning
   if(!firstFlag)             //if channel with high enough RSSI found then
     return true;             //return indicator flag
   return false;              //indicate no channels with high enough RSSI
@@ -1568,9 +2505,9 @@ boolean scanChannelsAndReport(int minRssiLevel, int fallbackRssiLevel,
 //            displayed, or empty string for default.
 // inclAllFlag:  true to include all frequencies; false to squelch
 //               frequencies adjacent to those already shown.
-//Returns true if one or more channels with high enough RSSI found;
-// false if all channels have low RSSI.
-boolean processScanChannelsCommand(const char *valueStr, boolean inclAllFlag)
+// The scan is performed via a scan job, with the results reported when
+// the scan is done.
+void processScanChannelsCommand(const char *valueStr, boolean inclAllFlag)
 {
   int minRssiLevel = sessionDefMinRssiLevel;
   const int sLen = strlen(valueStr);
@@ -1583,219 +2520,779 @@ boolean processScanChannelsCommand(const char *valueStr, boolean inclAllFlag)
     {  //error parsing given value
       showUnableToParseValueMsg();
       Serial.println(valueStr);
-      return false;
+      return;
     }
     sessionDefMinRssiLevel = minRssiLevel;  //save new default for session
   }
-  return scanChannelsAndReport(             //always show output
-                           minRssiLevel,minRssiLevel,inclAllFlag,true,true);
+  scanJobMinRssiLevel = minRssiLevel;
+  scanJobInclAllFlag = inclAllFlag;
+  startChansScanJob(SCANJOB_ACT_REPORT,inclAllFlag,true,0);
+}
+
+//Marks all entries in the spectrum model as stale and clears the
+// selected-channels list (so the next auto-scan does a full scan).
+void invalidateSpectrumModel()
+{
+  memset(scanRssiAgeSecsArr,0xFF,sizeof(scanRssiAgeSecsArr));
+  idxSortedSelArrCount = 0;
+  nextTuneChannelIndex = -1;
+}
+
+//Updates the ages of the entries in the spectrum model.  This function
+// should be called on a periodic basis.
+void updateSpectrumModelAges()
+{
+  const unsigned long elapsedSecs =
+                            (millis() - spectrumAgesUpdateTimeMs) / 1000;
+  if(elapsedSecs == 0)
+    return;
+  spectrumAgesUpdateTimeMs += elapsedSecs * 1000;
+  const uint8_t incVal = (elapsedSecs < 255) ? (uint8_t)elapsedSecs : 255;
+  for(uint8_t i=0; i<LISTFREQMHZ_ARR_SIZE; ++i)
+  {  //for each entry; increment age (saturating at 255)
+    scanRssiAgeSecsArr[i] = (scanRssiAgeSecsArr[i] < 255 - incVal) ?
+                                 scanRssiAgeSecsArr[i] + incVal : (uint8_t)255;
+  }
+}
+
+//Sets the RSSI value for an entry in the spectrum model.
+// idx:  index into 'scanRssiValuesArr[]' array.
+// rssiVal:  RSSI value.
+void setSpectrumModelEntry(int idx, uint8_t rssiVal)
+{
+  if(idx >= 0 && idx < LISTFREQMHZ_ARR_SIZE)
+  {
+    scanRssiAgeSecsArr[idx] = 0;
+    if(scanRssiValuesArr[idx] != rssiVal)
+    {  //value changed; update entry in ranked-index array
+      if(idx < rankedIdxCount)
+      {  //entry is ranked; find rank (via old value) and then move entry
+        const uint8_t rank = findRankOfIdx((uint8_t)idx);
+        scanRssiValuesArr[idx] = rssiVal;
+        updateRankedIdxEntry((uint8_t)idx,rank);
+      }
+      else
+        scanRssiValuesArr[idx] = rssiVal;
+    }
+  }
 }
 
-//Scans channels and stores received RSSI values in the 'scanRssiValuesArr[]'
-// array.  If a list of frequencies was entered via the 'L' command then
-// it is used (unless the 'inclAllFlag' parameter is true).  This function
-// blocks while the scanning is performed.
-// includeLBandFlag:  true to include L-band frequencies in scan.
+//Returns true if none of the entries in the spectrum model are older
+// than NEXT_CHAN_RESCANSECS (or if using the 'L' list with a minimum
+// RSSI of 0, in which case entries are never considered stale).
+boolean isSpectrumModelFresh(int minRssiLevel)
+{
+  if(minRssiLevel <= 0 && listFreqsMHzArrCount > 0)
+    return true;
+  const int count = (listFreqsMHzArrCount > 0) ? listFreqsMHzArrCount :
+                                                   getChannelMaxIndex()+1;
+  for(int i=0; i<count; ++i)
+  {
+    if(scanRssiAgeSecsArr[i] >= NEXT_CHAN_RESCANSECS)
+      return false;
+  }
+  return true;
+}
+
+//Returns true if a scan job is in progress.
+boolean isScanJobInProgress()
+{
+  return (scanJobSourceVal != SCANJOB_SRC_NONE);
+}
+
+//Starts a scan job that scans channels and stores received RSSI values in
+// the 'scanRssiValuesArr[]' array.  If a list of frequencies was entered
+// via the 'L' command then it is used (unless the 'inclAllFlag' parameter
+// is true).  The scan is performed via calls to 'processScanJobStep()'.
+// actionVal:  action to perform when scan done (SCANJOB_ACT_...).
 // inclAllFlag:  true to include all frequencies (don't use list entered
 //               via 'L' command).
-// restoreFreqFlag:  true to restore tuner frequency on exit.
-// showOutputFlag:  show messages while scanning.
-void scanChansGetRssiValues(boolean includeLBandFlag, boolean inclAllFlag,
-                            boolean restoreFreqFlag, boolean showOutputFlag)
-{
-  uint16_t prevFreqVal = 0;
-  if(restoreFreqFlag)
-    prevFreqVal = currentTunerFreqMhzOrCode;
+// restoreFreqFlag:  true to restore tuner frequency when scan done.
+// minAgeSecs:  if nonzero then only spectrum-model entries at least this
+//              old (in seconds) are scanned (all of them, so that the
+//              model is fresh after the scan); if zero then all entries
+//              are scanned.
+void startChansScanJob(byte actionVal, boolean inclAllFlag,
+                                boolean restoreFreqFlag, uint8_t minAgeSecs)
+{
   clearRssiOutput();         //clear analog-RSSI output
+  scanJobRestoreFreqVal = restoreFreqFlag ? currentTunerFreqMhzOrCode : 0;
                    //check if should use list entered via 'L' command:
-  const boolean listFlag = ((!inclAllFlag) && listFreqsMHzArrCount > 0);
-  Serial.print(" Scanning");
-  int idx, maxIdx;
-  if(listFlag)
+  scanJobListFlag = ((!inclAllFlag) && listFreqsMHzArrCount > 0);
+  if(scanJobListFlag)
   {  //using 'listFreqsMHzArr[]' entered via 'L' command
-    idx = 0;
-    maxIdx = listFreqsMHzArrCount - 1;
+    scanJobIdx = 0;
+    scanJobMaxIdx = listFreqsMHzArrCount - 1;
   }
   else
   {  //not using 'listFreqsMHzArr[]' entered via 'L' command
-    idx = CHANNEL_MIN_INDEX;      //using full list of channels from table
-    maxIdx = CHANNEL_MAX_INDEX;
+    scanJobIdx = CHANNEL_MIN_INDEX;   //using full list of channels from table
+    scanJobMaxIdx = getChannelMaxIndex();
   }
-  int tableIdx = 0;
-  uint16_t freqVal,wordVal;
-  while(true)
-  {  //for each channel slot
-    if(listFlag)
-    {  //using 'listFreqsMHzArr[]' entered via 'L' command
-      freqVal = listFreqsMHzArr[idx];
-      tableIdx = idx;        //index into 'scanRssiValuesArr[]' array
+  if(actionVal != SCANJOB_ACT_STREAM && actionVal != SCANJOB_ACT_TRACE)
+    Serial.print(minAgeSecs > 0 ? " Refreshing" : " Scanning");
+  scanJobMinAgeSecs = minAgeSecs;
+  scanJobActionVal = actionVal;
+  scanJobSamplesCount = 1;
+  scanJobTunedFlag = false;
+  scanJobChanCount = 0;
+  scanJobStartTimeMs = millis();
+  scanJobSourceVal = SCANJOB_SRC_CHANS;
+}
+
+//Starts a scan job for a full-band scan (with "fill-in" frequencies
+// between the table frequencies), with received RSSI values displayed
+// while scanning.  The scan is performed via calls to
+// 'processScanJobStep()'.
+void startFullScanJob()
+{
+  clearRssiOutput();         //clear analog-RSSI output
+  scanJobIdx = 0;
+  scanJobFillPos = 0;
+  scanJobFreqVal = 0;
+  scanJobActionVal = SCANJOB_ACT_FULLDONE;
+  scanJobSamplesCount = 1;
+  scanJobTunedFlag = false;
+  scanJobChanCount = 0;
+  scanJobStartTimeMs = millis();
+  scanJobSourceVal = SCANJOB_SRC_FULL;
+}
+
+//Starts a scan job for a range of frequencies, with received RSSI values
+// displayed while scanning.  To keep synthesizer jumps small the range
+// is scanned starting at the end nearest to the current frequency.
+// The scan is performed via calls to 'processScanJobStep()'.
+// startFreq:  first frequency in range (MHz).
+// stopFreq:  last frequency in range (MHz).
+// stepVal:  step between frequencies (MHz).
+// samplesCount:  number of RSSI samples to average for each frequency.
+void startRangeScanJob(uint16_t startFreq, uint16_t stopFreq, int stepVal,
+                                                      uint8_t samplesCount)
+{
+  clearRssiOutput();         //clear analog-RSSI output
+  if(startFreq > stopFreq)
+  {  //given range is backwards; swap values
+    const uint16_t tmpVal = startFreq;
+    startFreq = stopFreq;
+    stopFreq = tmpVal;
+  }
+  scanJobMaxIdx = (stopFreq - startFreq) / stepVal;   //last point index
+  const uint16_t lastFreq = startFreq + scanJobMaxIdx*stepVal;
+  const int curFreq = (int)getCurrentFreqInMhz();
+  if(abs(curFreq-(int)lastFreq) < abs(curFreq-(int)startFreq))
+  {  //current frequency is closer to end of range; scan downward
+    scanJobRangeFirstFreq = lastFreq;
+    scanJobRangeStep = -stepVal;
+  }
+  else
+  {  //current frequency is closer to start of range; scan upward
+    scanJobRangeFirstFreq = startFreq;
+    scanJobRangeStep = stepVal;
+  }
+  scanJobIdx = 0;
+  scanJobFreqVal = 0;
+  scanJobRestoreFreqVal = currentTunerFreqMhzOrCode;
+  scanJobActionVal = SCANJOB_ACT_FULLDONE;
+  scanJobSamplesCount = samplesCount;
+  scanJobSampleIdx = 0;
+  scanJobSampleSum = 0;
+  scanJobTunedFlag = false;
+  scanJobChanCount = 0;
+  scanJobStartTimeMs = millis();
+  scanJobSourceVal = SCANJOB_SRC_RANGE;
+}
+
+//Returns the next frequency for the range-scan job.
+// Returns:  The frequency in MHz, or 0 if all frequencies are done.
+uint16_t getNextRangeScanFreq()
+{
+  if(scanJobIdx > scanJobMaxIdx)
+    return 0;
+  return scanJobRangeFirstFreq + (scanJobIdx++)*scanJobRangeStep;
+}
+
+//Returns the frequency of the given "anchor" entry for the full-band scan:
+// the lowest table freq minus 37 MHz, then the table freqs sorted by
+// MHz value, and then the highest table freq plus 37 MHz.
+// idx:  anchor index (0 to getChannelMaxIndex()+2).
+// pTableIdx:  pointer to variable that receives the channel-table index
+//             for the frequency, or -1 if none.
+uint16_t getFullScanAnchorFreq(int idx, int *pTableIdx)
+{
+  if(idx <= 0)
+  {  //start at minFreq-37 MHz
+    *pTableIdx = -1;
+    return getChannelFreqTableEntry(
+                          getChannelSortTableEntry(CHANNEL_MIN_INDEX)) - 37;
+  }
+  const int maxIdx = getChannelMaxIndex();
+  if(idx > maxIdx+1)
+  {  //finish at maxFreq+37 MHz
+    *pTableIdx = -1;
+    return getChannelFreqTableEntry(
+                          getChannelSortTableEntry(maxIdx)) + 37;
+  }
+  *pTableIdx = (int)getChannelSortTableEntry(idx-1);       //channel index
+  return getChannelFreqTableEntry(*pTableIdx);             //freq in MHz
+}
+
+//Returns the next frequency for the full-band scan job.  If the spacing
+// between table frequencies is wide enough then "fill-in" frequencies
+// are added in between.
+// pTableIdx:  pointer to variable that receives the channel-table index
+//             for the frequency, or -1 if none.
+// Returns:  The frequency in MHz, or 0 if all frequencies are done.
+uint16_t getNextFullScanFreq(int *pTableIdx)
+{
+  int tableIdx;
+  while(scanJobIdx <= getChannelMaxIndex()+2)
+  {  //for each entry in table of channels sorted by MHz value
+    const uint16_t freqVal = getFullScanAnchorFreq(scanJobIdx,pTableIdx);
+    if(scanJobIdx == 0)
+    {  //first entry
+      ++scanJobIdx;
+      return freqVal;
     }
-    else
-    {  //not using 'listFreqsMHzArr[]' entered via 'L' command
-      tableIdx = (int)getChannelSortTableEntry(idx);    //sort by MHz
-         //if including L-band or not L-band channel then get freq in MHz:
-      freqVal = (includeLBandFlag || !isLBandChannelIndex(tableIdx)) ?
-                           getChannelFreqTableEntry(tableIdx) : (uint16_t)0;
+    const uint16_t prevFreqVal = getFullScanAnchorFreq(scanJobIdx-1,&tableIdx);
+    const int diff = freqVal - prevFreqVal;
+    const uint8_t fillCount = (diff > 35) ? 3 : ((diff > 22) ? 2 :
+                                                          ((diff > 9) ? 1 : 0));
+    if(scanJobFillPos < fillCount)
+    {  //add fill-in frequency (if 37 MHz between L-band freqs put 3
+       // in between; otherwise two or one in between, evenly spaced)
+      const int step = diff / (fillCount+1);
+      ++scanJobFillPos;
+      *pTableIdx = -1;
+      return prevFreqVal + step*scanJobFillPos +
+                            ((fillCount == 3 && scanJobFillPos > 1) ? 1 : 0);
     }
+    scanJobFillPos = 0;
+    ++scanJobIdx;
+    if(diff != 0)            //if not same as last freq then scan it
+      return freqVal;
+  }
+  return 0;
+}
+
+//Returns the frequency for the given channel slot of the scan-channels
+// job (slots are the 'L' list entries, or the table channels sorted by
+// MHz value).
+// slotIdx:  channel-slot index.
+// pTableIdx:  pointer to variable that receives the index into the
+//             'scanRssiValuesArr[]' array for the frequency.
+// Returns:  The frequency in MHz, or 0 if the channel is skipped (L-band
+//           channel when USE_LBAND_FLAG is false).
+uint16_t getChansScanSlotFreq(int slotIdx, int *pTableIdx)
+{
+  if(scanJobListFlag)
+  {  //using 'listFreqsMHzArr[]' entered via 'L' command
+    *pTableIdx = slotIdx;          //index into 'scanRssiValuesArr[]' array
+    return listFreqsMHzArr[slotIdx];
+  }
+         //not using 'listFreqsMHzArr[]' entered via 'L' command
+  *pTableIdx = (int)getChannelSortTableEntry(slotIdx);     //sort by MHz
+         //if including L-band or not L-band channel then get freq in MHz:
+  return (USE_LBAND_FLAG || !isLBandChannelIndex(*pTableIdx)) ?
+                            getChannelFreqTableEntry(*pTableIdx) : (uint16_t)0;
+}
+
+//Returns the next frequency for the scan-channels job.  Entries for
+// channels that are skipped (L-band channels when USE_LBAND_FLAG is
+// false) are set to zero in 'scanRssiValuesArr[]'.
+// pTableIdx:  pointer to variable that receives the index into the
+//             'scanRssiValuesArr[]' array for the frequency.
+// Returns:  The frequency in MHz, or 0 if all frequencies are done.
+uint16_t getNextChansScanFreq(int *pTableIdx)
+{
+  uint16_t freqVal;
+  while(scanJobIdx <= scanJobMaxIdx)
+  {  //for each channel slot
+    freqVal = getChansScanSlotFreq(scanJobIdx,pTableIdx);
     if(freqVal >= MIN_CHANNEL_MHZ && freqVal <= MAX_CHANNEL_MHZ)
     {  //frequency is valid
-      setCurrentFreqByMhzOrCode(freqVal);
-#if DISP7SEG_ENABLED_FLAG    //display frequency codes while scanning
-      if(displayConnectedFlag)
-      {
-        if(listFlag)
-        {  //using 'listFreqsMHzArr[]' entered via 'L' command
-                   //display freq code for freq value (if any):
-          if((wordVal=freqInMhzToFreqCode(freqVal,NULL)) > (uint16_t)0)
-            disp7SegSetOvrAsciiViaWord(wordVal,0);
-          else
-            disp7SegSetOvrShowDashes(0);    //if no freq code show dashes
-        }
-        else
-        {  //not using 'listFreqsMHzArr[]' entered via 'L' command
-          disp7SegSetOvrAsciiViaWord(freqIdxToFreqCode(tableIdx,NULL), 0);
-        }
+      if(scanRssiAgeSecsArr[*pTableIdx] >= scanJobMinAgeSecs)
+        return freqVal;      //if not refreshing or entry stale then scan
+    }
+    else  //frequency value not valid (skipping L-band channel)
+      setSpectrumModelEntry(*pTableIdx,0);
+    ++scanJobIdx;
+  }
+  return 0;
+}
+
+//Performs the next step of the scan job in progress:  tunes the next
+// frequency, or (once the RSSI is ready) reads and stores (or shows) the
+// RSSI value for the tuned frequency.  When all frequencies are done the
+// job is finished via 'finishScanJob()'.  This function does not block
+// (except for reading the RSSI value) and should be called on a periodic
+// basis while 'isScanJobInProgress()' returns true.  If the serial-output
+// queue does not have room for the step's output then the step is
+// deferred (so the scan waits for the serial port without blocking).
+// Auto-tune jobs (selected channels tuned in turn) are stepped via
+// 'processAutoTuneJobStep()'.
+void processScanJobStep()
+{
+  if(scanJobSourceVal == SCANJOB_SRC_TUNE)
+  {  //auto-tune of selected channels
+    processAutoTuneJobStep();
+    return;
+  }
+  if(!outQueueHasRoom(SCANJOB_STEP_OUTMAX))
+    return;                  //no room for output yet; do step later
+  if(!scanJobTunedFlag)
+  {  //next frequency not yet tuned
+    if(scanJobSourceVal == SCANJOB_SRC_FULL)
+    {  //full-band scan
+      if((scanJobFreqVal=getNextFullScanFreq(&scanJobTableIdx)) == 0)
+      {  //all frequencies done
+        finishScanJob(false);
+        return;
       }
+      scanJobCodeVal = (scanJobTableIdx >= 0) ?   //get code for freq
+                        freqIdxToFreqCode(scanJobTableIdx,NULL) : (uint16_t)0;
+    }
+    else if(scanJobSourceVal == SCANJOB_SRC_RANGE)
+    {  //range scan
+      if((scanJobFreqVal=getNextRangeScanFreq()) == 0)
+      {  //all frequencies done
+        finishScanJob(false);
+        return;
+      }
+      scanJobTableIdx = -1;
+      scanJobCodeVal = freqInMhzToFreqCode(scanJobFreqVal,NULL);
+    }
+    else
+    {  //scan channels
+      if((scanJobFreqVal=getNextChansScanFreq(&scanJobTableIdx)) == 0)
+      {  //all frequencies done
+        finishScanJob(false);
+        return;
+      }
+      scanJobCodeVal = scanJobListFlag ?    //get code for freq (if avail)
+                               freqInMhzToFreqCode(scanJobFreqVal,NULL) :
+                                   freqIdxToFreqCode(scanJobTableIdx,NULL);
+    }
+    setCurrentFreqByMhzOrCode(scanJobFreqVal);
+#if DISP7SEG_ENABLED_FLAG    //display frequency codes while scanning
+    if(displayConnectedFlag)
+    {
+      if(scanJobCodeVal > (uint16_t)0)      //show freq code (if avail):
+        disp7SegSetOvrAsciiViaWord(scanJobCodeVal,0);
+      else
+        disp7SegSetOvrShowDashes(0);        //if no freq code show dashes
+    }
 #endif
-      waitRssiReady();               //delay after channel change
-      scanRssiValuesArr[tableIdx] = (uint8_t)readRssiValue();
-      if(showOutputFlag)
-      {
-        Serial.print((int)freqVal);
-        Serial.print('(');
-        Serial.print(tableIdx);
-        Serial.print(")=");
-        Serial.print((int)scanRssiValuesArr[tableIdx]);
+    scanJobTunedFlag = true;
+    return;
+  }
+  if(!isRx5808RssiReady())   //if RSSI not settled after channel change
+    return;                  // then check again later
+  if(scanJobActionVal == SCANJOB_ACT_TRACE)
+  {  //raw-RSSI trace ('XY'); show reading and move to next channel
+    showRssiTraceReading(readRawRssiValue());
+    scanJobTunedFlag = false;
+    ++scanJobChanCount;
+    ++scanJobIdx;
+    return;
+  }
+  uint8_t rssiVal = (uint8_t)readRssiValue();
+  if(scanJobSamplesCount > 1)
+  {  //averaging multiple RSSI samples for each frequency
+    scanJobSampleSum += rssiVal;
+    if(++scanJobSampleIdx < scanJobSamplesCount)
+    {  //more samples needed; take next one on later call
+#if RSSI_ADCSAMPLER_FLAG
+      rssiSamplerMarkTune();      //make next reading use new samples
+#endif
+      return;
+    }
+    rssiVal = (uint8_t)((scanJobSampleSum + scanJobSamplesCount/2) /
+                                                       scanJobSamplesCount);
+    scanJobSampleIdx = 0;
+    scanJobSampleSum = 0;
+  }
+  rssiRecAddReading(rssiVal);          //record value for frequency
+  scanJobTunedFlag = false;
+  ++scanJobChanCount;
+  if(scanJobSourceVal == SCANJOB_SRC_FULL)
+  {  //full-band scan; show frequency and RSSI value
+    if(binFramesEnabledFlag)
+      binFrameAddPoint(scanJobFreqVal,rssiVal);     //add to points frame
+    else
+    {  //ASCII output
+      outQueueAddUint(scanJobFreqVal);
+      if(scanJobCodeVal > (uint16_t)0)
+      {  //frequency-code value available; show it
+        outQueueAddChar((char)(scanJobCodeVal >> (uint16_t)8));
+        outQueueAddChar((char)(scanJobCodeVal & (uint16_t)0x7F));
       }
-      if(++idx > maxIdx)
-        break;
-      if(showOutputFlag)
-        Serial.print(',');
-      else if((idx % 8) == 0)
-        Serial.print(".");
+      outQueueAddChar('=');
+      outQueueAddUint(rssiVal);
+      outQueueAddNewline();
     }
+    if(scanJobTableIdx >= 0 && listFreqsMHzArrCount <= 0)
+      setSpectrumModelEntry(scanJobTableIdx,rssiVal);   //update model entry
+  }
+  else if(scanJobSourceVal == SCANJOB_SRC_RANGE)
+  {  //range scan; show frequency and RSSI value
+    if(binFramesEnabledFlag)
+      binFrameAddPoint(scanJobFreqVal,rssiVal);     //add to points frame
     else
-    {  //frequency value not valid (skipping L-band channel)
-      scanRssiValuesArr[tableIdx] = (uint8_t)0;
-      if(++idx > maxIdx)
-        break;
+    {  //ASCII output
+      outQueueAddUint(scanJobFreqVal);
+      outQueueAddChar('=');
+      outQueueAddUint(rssiVal);
+      outQueueAddNewline();
     }
-    if(!displayConnectedFlag)               //if no display then
-      updateActivityIndicator(true);        //indicate "extra" activity
   }
-  Serial.println();
+  else
+  {  //scan channels; store RSSI value
+    setSpectrumModelEntry(scanJobTableIdx,rssiVal);
+    if(++scanJobIdx <= scanJobMaxIdx && (scanJobIdx % 8) == 0 &&
+                                      scanJobActionVal != SCANJOB_ACT_STREAM)
+    {
+      outQueueAddChar('.');            //show progress
+    }
+  }
+  if(!displayConnectedFlag)            //if no display then
+    updateActivityIndicator(true);     //indicate "extra" activity
+}
+
+//Finishes the scan job in progress.
+// abortFlag:  true if the scan job is being aborted (results not used).
+void finishScanJob(boolean abortFlag)
+{
+  const byte sourceVal = scanJobSourceVal;
+  scanJobSourceVal = SCANJOB_SRC_NONE;
+  const boolean streamFlag = (scanJobActionVal == SCANJOB_ACT_STREAM ||
+                                     scanJobActionVal == SCANJOB_ACT_TRACE);
+  if(abortFlag || !streamFlag)
+    outQueueFlush();         //send queued output (unless next sweep)
 #if DISP7SEG_ENABLED_FLAG
   if(displayConnectedFlag)
     disp7SegClearOvrDisplay();    //clear displayed freq code
 #endif
-  if(restoreFreqFlag)
-    setTunerChannelToFreq(prevFreqVal);
-#if BUTTONS_ENABLED_FLAG
-  fetchButtonsTriggerState();     //clear any presses while busy scanning
-#endif
+  if(sourceVal == SCANJOB_SRC_TUNE)
+  {  //auto-tune of selected channels
+    finishAutoTuneJob(abortFlag);
+    return;
+  }
+  if(sourceVal == SCANJOB_SRC_FULL || sourceVal == SCANJOB_SRC_RANGE)
+  {  //full-band or range scan
+    if(binFramesEnabledFlag)
+    {  //binary frames; send remaining points and "finished" frame
+      binFrameFlushPoints();
+      binFrameSendEmpty(BINFRAME_TYPE_SCANDONE);
+    }
+    else
+      Serial.println("0=0");      //show "finished" indicator
+    if(sourceVal == SCANJOB_SRC_RANGE)
+    {  //range scan; restore tuner frequency
+      setTunerChannelToFreq(scanJobRestoreFreqVal);
+      return;
+    }
+         //do tune to leave display, etc correctly in sync
+         //see if frequency corresponds to a frequency code:
+    const uint16_t codeVal = freqInMhzToFreqCode(scanJobFreqVal,NULL);
+         //if matching code then use it; otherwise freq value:
+    setTunerChannelToFreq((codeVal != (uint16_t)0) ? codeVal :
+                                                            scanJobFreqVal);
+    return;
+  }
+  if(streamFlag)
+  {  //streaming sweeps ('XS' command) or raw-RSSI trace ('XY' command)
+    if(!abortFlag)
+    {  //sweep completed; show values and start next sweep
+      if(scanJobActionVal == SCANJOB_ACT_STREAM)
+      {
+        TIMESTATS_START(startUs);
+        showStreamSweepValues();
+        TIMESTATS_END(TSTAT_REPORTOUT,startUs);
+      }
+      else  //trace readings already shown; just count sweep
+        ++scanJobSweepCount;
+      scanJobIdx = scanJobListFlag ? 0 : CHANNEL_MIN_INDEX;
+      scanJobChanCount = 0;
+      scanJobSourceVal = SCANJOB_SRC_CHANS;
+      return;
+    }
+    showStreamSweepStats();       //streaming stopped; show sweep rate
+    if(scanJobRestoreFreqVal > (uint16_t)0)
+      setTunerChannelToFreq(scanJobRestoreFreqVal);
+    return;
+  }
+  if(abortFlag)
+  {  //scan aborted
+    if(serialEchoFlag)
+      Serial.print(F(" aborted"));
+  }
+  else if(serialEchoFlag && scanJobChanCount > 0)
+  {  //show average time spent on each channel
+    Serial.print(F(" (ms/chan="));
+    Serial.print((int)((millis()-scanJobStartTimeMs)/scanJobChanCount));
+    Serial.print(')');
+  }
+  Serial.println();
+  if(scanJobRestoreFreqVal > (uint16_t)0)
+    setTunerChannelToFreq(scanJobRestoreFreqVal);
+  if(abortFlag)
+  {  //scan aborted
+    if(scanJobActionVal == SCANJOB_ACT_AUTOTUNE)
+      setTunerChannelToFreq(scanJobPrevFreqVal);     //restore tuner freq
+    else if(scanJobActionVal == SCANJOB_ACT_LISTLOAD)
+      listFreqsMHzArrCount = listLoadPrevCount;      //restore 'L' list
+    return;
+  }
+  switch(scanJobActionVal)
+  {
+    case SCANJOB_ACT_REPORT:       //report channels ('S' or 'F' command)
+      {
+        TIMESTATS_START(startUs);
+        reportScannedChannels(scanJobMinRssiLevel,scanJobMinRssiLevel,
+                                                   scanJobInclAllFlag,true);
+        TIMESTATS_END(TSTAT_REPORTOUT,startUs);
+      }
+      break;
+    case SCANJOB_ACT_AUTOTUNE:     //tune channel ('A','N','P','M' commands)
+      finishAutoScanTuneChannel();
+      break;
+    case SCANJOB_ACT_LISTLOAD:     //load 'L' list ('L S' command)
+      if(reportScannedChannels(sessionDefMinRssiLevel,
+                               sessionDefMinRssiLevel,false,serialEchoFlag))
+      {  //channels with high enough RSSI found; load them into list
+        loadFreqsMHzListFromScan();
+      }
+      else  //no channels with high enough RSSI found
+        listFreqsMHzArrCount = listLoadPrevCount;    //keep existing list
+      break;
+  }
+}
+
+//Aborts the scan job in progress (if any).
+void abortScanJob()
+{
+  if(scanJobSourceVal != SCANJOB_SRC_NONE)
+    finishScanJob(true);
+}
+
+//Performs a full-band scan and displays received RSSI values while scanning.
+// The scan is performed via a scan job (and is aborted if any input
+// is received).
+void fullScanShowRssiValues()
+{
+  startFullScanJob();
+}
+
+//Processes the full-scan ('XF') command.  If no parameters are given
+// then a full-band scan is performed; otherwise the parameters are
+// "start,stop,step[,samples]" for a range scan (MHz values).
+void processFullScanCommand(const char *valueStr)
+{
+  const int sLen = strlen(valueStr);
+  int p = 0;
+  while(valueStr[p] == ' ' && ++p < sLen);  //ignore any leading spaces
+  if(p >= sLen)
+  {  //no parameters given
+    fullScanShowRssiValues();
+    return;
+  }
+  int valsArr[4];
+  int numVals = 0;
+  while(p < sLen && numVals < 4)
+  {  //for each parameter value
+    if(!convStrToInt(&valueStr[p],&valsArr[numVals]))
+      break;
+    ++numVals;
+    while(p < sLen && valueStr[p] >= '0' && valueStr[p] <= '9')
+      ++p;              //scan through digits
+    while(p < sLen && valueStr[p] == ' ')
+      ++p;              //scan through spaces
+    if(p < sLen && valueStr[p] == ',')
+      ++p;              //scan through comma
+    while(p < sLen && valueStr[p] == ' ')
+      ++p;              //scan through spaces
+  }
+  if(numVals < 3 || p < sLen)
+  {  //not enough values or unable to parse
+    showUnableToParseValueMsg();
+    Serial.println(valueStr);
+    return;
+  }
+  if(numVals < 4)
+    valsArr[3] = 1;               //if no samples value then use 1
+  if(valsArr[0] < MIN_CHANNEL_MHZ || valsArr[0] > MAX_CHANNEL_MHZ ||
+                 valsArr[1] < MIN_CHANNEL_MHZ || valsArr[1] > MAX_CHANNEL_MHZ)
+  {
+    Serial.print(F(" Frequency values must be "));
+    Serial.print(MIN_CHANNEL_MHZ);
+    Serial.print(F(" to "));
+    Serial.println(MAX_CHANNEL_MHZ);
+    return;
+  }
+  if(valsArr[2] < 1 || valsArr[3] < 1 || valsArr[3] > RANGESCAN_MAX_SAMPLES)
+  {
+    Serial.print(F(" Step must be at least 1 and samples 1 to "));
+    Serial.println(RANGESCAN_MAX_SAMPLES);
+    return;
+  }
+  startRangeScanJob((uint16_t)valsArr[0],(uint16_t)valsArr[1],valsArr[2],
+                                                        (uint8_t)valsArr[3]);
+}
+
+//Starts streaming sweeps of the channels (the list entered via the 'L'
+// command, or all table channels), with the RSSI values for each
+// completed sweep shown on one line (or sent as one binary frame).
+// The frequencies are shown first (in sweep order, via command steps).
+// The sweeps are performed via a scan job that repeats until any input
+// is received.
+void startStreamSweepJob()
+{
+  startChansScanJob(SCANJOB_ACT_STREAM,false,true,0);
+  scanJobSweepCount = 0;
+  startCommandSteps(showStreamSweepFreqsStep);
+  clearSerialInputPromptFlag();        //suppress '>' serial prompt
+}
+
+//Command step that shows the next part of the frequencies for the
+// streaming sweeps started via 'startStreamSweepJob()' (on one line, or
+// as one binary frame).  The scan job does not step until these are
+// shown, so its start and end indices are unchanged.
+// posPtr:  pointer to position (offset of next frequency in sweep).
+// Returns true if there are more frequencies to show; false if done.
+boolean showStreamSweepFreqsStep(uint16_t *posPtr)
+{
+  int i = scanJobIdx + *posPtr;
+  if(*posPtr == 0)
+  {  //first step; start frame or line
+    if(binFramesEnabledFlag)
+    {  //binary frames; begin frame with frequencies
+      binFrameBegin(BINFRAME_TYPE_SWEEPFREQS,
+                                 (uint8_t)((scanJobMaxIdx-scanJobIdx+1)*2));
+    }
+    else
+      Serial.print(' ');
+  }
+  int tableIdx;
+  for(uint8_t n=0; n<STREAMFREQS_STEPCOUNT && i<=scanJobMaxIdx; ++n)
+  {  //for each frequency shown on this step
+    if(binFramesEnabledFlag)
+      binFrameAddWord(getChansScanSlotFreq(i,&tableIdx));
+    else
+    {
+      if(i > scanJobIdx)
+        Serial.print(',');
+      Serial.print((int)getChansScanSlotFreq(i,&tableIdx));
+    }
+    ++i;
+  }
+  *posPtr = (uint16_t)(i - scanJobIdx);
+  if(i <= scanJobMaxIdx)
+    return true;
+  if(binFramesEnabledFlag)
+    binFrameEnd();
+  else
+    Serial.println();
+  return false;
+}
+
+//Shows the RSSI values for the streaming sweep just completed, as
+// "sweepNum,timeMs:rssi,rssi,..." (or as a binary frame), where 'timeMs'
+// is the time since the streaming started.
+void showStreamSweepValues()
+{
+  ++scanJobSweepCount;        //sweep may be dropped if serial falls behind:
+  outQueueSendDroppable(addStreamSweepValues,scanJobSweepCount);
+}
+
+//Adds the RSSI values for the streaming sweep just completed to the
+// output (see 'showStreamSweepValues()').
+// sweepNum:  sweep number.
+void addStreamSweepValues(uint16_t sweepNum)
+{
+  const unsigned long timeMs = millis() - scanJobStartTimeMs;
+  const int minIdx = scanJobListFlag ? 0 : CHANNEL_MIN_INDEX;
+  int i, tableIdx;
+  if(binFramesEnabledFlag)
+  {  //binary frames; send frame with sweep number, time and RSSI values
+    binFrameBegin(BINFRAME_TYPE_SWEEP,(uint8_t)(scanJobMaxIdx-minIdx+1+6));
+    binFrameAddWord(sweepNum);
+    binFrameAddWord((uint16_t)timeMs);
+    binFrameAddWord((uint16_t)(timeMs >> 16));
+    for(i=minIdx; i<=scanJobMaxIdx; ++i)
+    {
+      getChansScanSlotFreq(i,&tableIdx);
+      binFrameAddByte(scanRssiValuesArr[tableIdx]);
+    }
+    binFrameEnd();
+    return;
+  }
+  outQueueAddChar(' ');
+  outQueueAddUint(sweepNum);
+  outQueueAddChar(',');
+  outQueueAddULong(timeMs);
+  outQueueAddChar(':');
+  for(i=minIdx; i<=scanJobMaxIdx; ++i)
+  {
+    if(i > minIdx)
+      outQueueAddChar(',');
+    getChansScanSlotFreq(i,&tableIdx);
+    outQueueAddUint(scanRssiValuesArr[tableIdx]);
+  }
+  outQueueAddNewline();
 }
 
-//Tunes to the given channel, receives its RSSI value, and displays it.
-// freqVal:  frequency value to scan.
-// tableIdx:  table index for frequency, or -1 if none.
-void doScanFreqShowRssiValue(uint16_t freqVal, int tableIdx)
+//Starts streaming a raw-RSSI trace of the channels (the list entered via
+// the 'L' command, or all table channels), for capturing RF conditions
+// to be replayed in the host simulation.  Each reading is shown on its
+// own line as "timeMs,freqMhz,rawRssi", where 'timeMs' is the time since
+// the trace started.  A header line with the current raw-RSSI scaling
+// values is shown first.  The channels are swept (as with 'XS') until
+// any input is received.  The trace is always sent as text.
+void startRssiTraceJob()
 {
-  uint16_t rssiVal;
-  setCurrentFreqByMhzOrCode(freqVal);
-  uint16_t codeVal = (tableIdx >= 0) ?      //get code for freq (if avail)
-                             freqIdxToFreqCode(tableIdx,NULL) : (uint16_t)0;
-#if DISP7SEG_ENABLED_FLAG    //display frequency codes while scanning
-  if(displayConnectedFlag)
-  {
-    if(codeVal > (uint16_t)0)          //show freq code (via table index):
-      disp7SegSetOvrAsciiViaWord(codeVal,0);
-    else
-      disp7SegSetOvrShowDashes(0);     //if no freq code show dashes
-  }
-#endif
-  waitRssiReady();                   //delay after channel change
-  rssiVal = (uint8_t)readRssiValue();
-  Serial.print((int)freqVal);
-  if(codeVal > (uint16_t)0)
-  {  //frequency-code value available; show it
-    Serial.print((char)(codeVal >> (uint16_t)8));
-    Serial.print((char)(codeVal & (uint16_t)0x7F));
-  }
-  Serial.print('=');
-  Serial.println((int)rssiVal);
-  if(!displayConnectedFlag)            //if no display then
-    updateActivityIndicator(true);     //indicate "extra" activity
+  startChansScanJob(SCANJOB_ACT_TRACE,false,true,0);
+  scanJobSweepCount = 0;
+  Serial.print(F("#trace rawMin="));
+  Serial.print(getRx5808RawRssiMinVal());
+  Serial.print(F(" rawMax="));
+  Serial.println(getRx5808RawRssiMaxVal());
+  clearSerialInputPromptFlag();        //suppress '>' serial prompt
 }
 
-//Performs a full-band scan and displays received RSSI values while scanning.
-// This function blocks while the scanning is performed.
-void fullScanShowRssiValues()
+//Shows a raw-RSSI trace reading for the currently-scanned frequency.
+// rawVal:  raw RSSI value.
+void showRssiTraceReading(uint16_t rawVal)
+{                           //reading may be dropped if serial behind:
+  outQueueSendDroppable(addRssiTraceReading,rawVal);
+}
+
+//Adds a raw-RSSI trace reading for the currently-scanned frequency to
+// the output, as "timeMs,freqMhz,rawRssi".
+// rawVal:  raw RSSI value.
+void addRssiTraceReading(uint16_t rawVal)
 {
-  clearRssiOutput();         //clear analog-RSSI output
-  uint16_t nextFreqVal, freqVal = 0;
-  int diff;
-  int idx = CHANNEL_MIN_INDEX - 1;
-  int tableIdx = -1;
-  nextFreqVal = getChannelFreqTableEntry(   //start at minFreq-37 MHz
-                          getChannelSortTableEntry(CHANNEL_MIN_INDEX)) - 37;
-  while(true)
-  {  //for each entry in table of channels sorted by MHz value
-    if(nextFreqVal != freqVal)    //if not same as last freq then do scan
-      doScanFreqShowRssiValue(nextFreqVal,tableIdx);
-    freqVal = nextFreqVal;
-    if(++idx <= CHANNEL_MAX_INDEX)
-    {  //next index is in range
-      tableIdx = (int)getChannelSortTableEntry(idx);       //channel index
-      nextFreqVal = getChannelFreqTableEntry(tableIdx);    //freq in MHz
-    }
-    else
-    {  //all frequencies in table have been processed
-      if(idx > CHANNEL_MAX_INDEX+1)    //if additional freq has been processed
-        break;                         // then exit loop
-      tableIdx = -1;
-      nextFreqVal += 37;     //finish at maxFreq+37 MHz
-    }
-         //if spacing between current and next frequency is
-         // wide enough then add fill-in frequency in between:
-    if((diff=nextFreqVal-freqVal) > 35)
-    {  //if 37 MHz between L-band freqs put 3 in between
-      diff /= 4;
-      freqVal += diff;
-      doScanFreqShowRssiValue(freqVal,-1);
-      freqVal += diff+1;
-      doScanFreqShowRssiValue(freqVal,-1);
-      freqVal += diff;
-      doScanFreqShowRssiValue(freqVal,-1);
-    }
-    else if(diff > 22)
-    {  //enough room for two frequencies in between
-      diff /= 3;
-      freqVal += diff;
-      doScanFreqShowRssiValue(freqVal,-1);
-      freqVal += diff;
-      doScanFreqShowRssiValue(freqVal,-1);
-    }
-    else if(diff > 9)
-    {  //enough room for one frequency in between
-      freqVal += diff / 2;        //do average of values
-      doScanFreqShowRssiValue(freqVal,-1);
-    }
-    if(Serial.available())        //if any serial input then
-      break;                      //abort scan
-  }
-  Serial.println("0=0");          //show "finished" indicator
-#if DISP7SEG_ENABLED_FLAG
-  if(displayConnectedFlag)
-    disp7SegClearOvrDisplay();    //clear displayed freq code
-#endif
-    //do tune to leave display, etc correctly in sync
-         //see if frequency corresponds to a frequency code:
-  const uint16_t codeVal = freqInMhzToFreqCode(freqVal,NULL);
-         //if matching code then use it; otherwise freq value:
-  setTunerChannelToFreq((codeVal != (uint16_t)0) ? codeVal : freqVal);
-#if BUTTONS_ENABLED_FLAG
-  fetchButtonsTriggerState();     //clear any presses while busy scanning
-#endif
+  outQueueAddULong(millis() - scanJobStartTimeMs);
+  outQueueAddChar(',');
+  outQueueAddUint(scanJobFreqVal);
+  outQueueAddChar(',');
+  outQueueAddUint(rawVal);
+  outQueueAddNewline();
+}
+
+//Shows the number of streaming sweeps done and the sweep rate.
+void showStreamSweepStats()
+{
+  const unsigned long timeMs = millis() - scanJobStartTimeMs;
+  Serial.print(F(" Sweeps="));
+  Serial.print(scanJobSweepCount);
+  Serial.print(F(", sweeps/sec="));
+  const unsigned long rateX100 = (timeMs > 0) ?
+                         (unsigned long)scanJobSweepCount * 100000L / timeMs : 0;
+  Serial.print(rateX100 / 100);
+  Serial.print('.');
+  if(rateX100 % 100 < 10)
+    Serial.print('0');
+  Serial.println(rateX100 % 100);
 }
 
 //Process command for serial echo on/off or echo text.
@@ -1824,6 +3321,201 @@ void processSerialEchoCommand(const char *valueStr)
   Serial.println(serialEchoFlag ? 1 : 0);
 }
 
+//Processes command to show or reset the serial-output-queue and
+// operation-timing statistics ("XQ R" resets them; "XQ H" shows latency
+// histograms; "XQ T" shows run-queue task stats).
+void processOutQueueStatsCommand(const char *valueStr)
+{
+  const int sLen = strlen(valueStr);
+  int p = 0;
+  while(valueStr[p] == ' ' && ++p < sLen);  //ignore any leading spaces
+  if(p < sLen)
+  {  //parameter value given
+    const char ch = (char)toupper(valueStr[p]);
+    if(ch == 'R')
+    {
+      outQueueClearStats();
+      timeStatsClear();
+      latencyHistClear();
+      runQueueClearStats();
+    }
+    else if(ch == 'H')
+      latencyHistShowValues();
+    else if(ch == 'T')
+      startCommandSteps(runQueueShowStatsStep);
+    else
+    {
+      Serial.print(F(" Invalid parameter:  "));
+      Serial.println(&valueStr[p]);
+    }
+    return;
+  }
+  Serial.print(F(" Out-queue size="));
+#if SERIAL_OUTQUEUE_FLAG
+  Serial.print(OUTQUEUE_RING_SIZE-1);
+#else
+  Serial.print('0');
+#endif
+  Serial.print(F(", maxUsed="));
+  Serial.print((int)outQueueGetMaxUsed());
+  Serial.print(F(", dropped="));
+  Serial.print(outQueueGetDroppedCount());
+  Serial.print(F(", stalls="));
+  Serial.println(outQueueGetStallCount());
+  timeStatsShowValues();
+}
+
+//Processes command to show the RSSI flight-recorder entries ("XV C"
+// clears them).
+void processRecorderCommand(const char *valueStr)
+{
+  const int sLen = strlen(valueStr);
+  int p = 0;
+  while(valueStr[p] == ' ' && ++p < sLen);  //ignore any leading spaces
+  if(p < sLen)
+  {  //parameter value given
+    if(toupper(valueStr[p]) == 'C')
+      rssiRecClear();
+    else
+    {
+      Serial.print(F(" Invalid parameter:  "));
+      Serial.println(&valueStr[p]);
+    }
+    return;
+  }
+  rssiRecShowEntries();
+}
+
+//Process command for binary-framed output off/on.  When on, the
+// results for the 'S', 'F', 'XF', 'XS', 'R', 'O' and 'XR' commands
+// are sent as binary frames (see 'BinFrames.h').
+void processBinaryFramesCommand(const char *valueStr)
+{
+  const int sLen = strlen(valueStr);
+  int p = 0;
+  while(valueStr[p] == ' ' && p < sLen)
+    ++p;              //skip leading spaces
+  if(p < sLen)
+  {  //parameter value given
+    const char ch = valueStr[p];
+    if(ch == '0')
+      binFramesEnabledFlag = false;    //turn off binary frames
+    else if(ch == '1')
+      binFramesEnabledFlag = true;     //turn on binary frames
+    else
+    {
+      Serial.print(F(" Invalid parameter:  "));
+      Serial.println(&valueStr[p]);
+    }
+    return;
+  }
+    //no parameter; show current binary-frames on/off value
+  Serial.print(' ');
+  Serial.println(binFramesEnabledFlag ? 1 : 0);
+}
+
+//Processes command to set, remove or show user-defined bands.  The
+// parameters are "band f1,f2,...,f8" to set a band, "band" to remove
+// a band, or "0" to remove all bands.  With no parameters the
+// user-defined bands are shown.  Changes are saved to EEPROM.
+void processCustomBandsCommand(const char *valueStr)
+{
+#if CUSTOM_BANDS_MAXCOUNT > 0
+  const int sLen = strlen(valueStr);
+  int p = 0;
+  while(valueStr[p] == ' ' && ++p < sLen);  //ignore any leading spaces
+  if(p >= sLen)
+  {  //no parameters given; show user-defined bands
+    if(getCustomBandsCount() <= 0)
+      Serial.println(F(" No user-defined bands"));
+    else
+    {
+      const int numBands = getNumFreqBands();
+      for(int bandIdx=CUSTOM_FIRST_INDEX/CHANNEL_BAND_SIZE;
+                                             bandIdx<numBands; ++bandIdx)
+      {  //for each user-defined band
+        Serial.print(' ');
+        Serial.print(getFreqBandCode(bandIdx));
+        for(int i=0; i<CHANNEL_BAND_SIZE; ++i)
+        {
+          Serial.print(i > 0 ? ',' : ' ');
+          Serial.print(getChannelFreqTableEntry(bandIdx*CHANNEL_BAND_SIZE+i));
+        }
+        Serial.println();
+      }
+    }
+    return;
+  }
+  const char bandCh = (char)toupper(valueStr[p]);
+  if(bandCh == '0' && p+1 >= sLen)
+  {  //remove all user-defined bands
+    clearCustomBands();
+    saveCustomBandsToEeprom();
+    invalidateSpectrumModel();         //channel indices changed
+    return;
+  }
+  if(bandCh < 'A' || bandCh > 'Z' || isBuiltinFreqBandCode(bandCh))
+  {
+    Serial.print(F(" Invalid band code (must be letter not used by "));
+    Serial.println(F("built-in bands)"));
+    return;
+  }
+  while(++p < sLen && valueStr[p] == ' ');  //ignore spaces after band code
+  if(p >= sLen)
+  {  //no frequency values given; remove band
+    if(removeCustomBand(bandCh))
+    {
+      saveCustomBandsToEeprom();
+      invalidateSpectrumModel();       //channel indices changed
+    }
+    else
+      Serial.println(F(" Band not found"));
+    return;
+  }
+  uint16_t freqsArr[CHANNEL_BAND_SIZE];
+  int val, numVals = 0;
+  while(p < sLen && numVals < CHANNEL_BAND_SIZE)
+  {  //for each frequency value
+    if(!convStrToInt(&valueStr[p],&val))
+      break;
+    if(val < MIN_CHANNEL_MHZ || val > MAX_CHANNEL_MHZ)
+    {
+      Serial.print(F(" Frequency values must be "));
+      Serial.print(MIN_CHANNEL_MHZ);
+      Serial.print(F(" to "));
+      Serial.println(MAX_CHANNEL_MHZ);
+      return;
+    }
+    freqsArr[numVals++] = (uint16_t)val;
+    while(p < sLen && valueStr[p] >= '0' && valueStr[p] <= '9')
+      ++p;              //scan through digits
+    while(p < sLen && valueStr[p] == ' ')
+      ++p;              //scan through spaces
+    if(p < sLen && valueStr[p] == ',')
+      ++p;              //scan through comma
+    while(p < sLen && valueStr[p] == ' ')
+      ++p;              //scan through spaces
+  }
+  if(numVals < CHANNEL_BAND_SIZE || p < sLen)
+  {  //not enough values or unable to parse
+    showUnableToParseValueMsg();
+    Serial.println(valueStr);
+    return;
+  }
+  if(!setCustomBand(bandCh,freqsArr))
+  {
+    Serial.print(F(" Too many user-defined bands (max is "));
+    Serial.print(CUSTOM_BANDS_MAXCOUNT);
+    Serial.println(')');
+    return;
+  }
+  saveCustomBandsToEeprom();
+  invalidateSpectrumModel();           //channel indices changed
+#else
+  Serial.println(F(" User-defined bands not enabled"));
+#endif
+}
+
 //Processes command to set or show raw-RSSI-scaling values.
 void processRawRssiMinMaxCommand(const char *valueStr)
 {
@@ -2093,9 +3785,12 @@ void processSoftRebootCommand(const char *valueStr)
         Serial.println(valueStr);
         return;
       }
+      delayedSaveFreqListFlag = false;      //list is being reset
       setEepromToDefaultsValues();
     }
   }
+  if(delayedSaveFreqListFlag)          //if 'L' list not yet saved then
+    saveListFreqsMHzArrToEeprom();     //finish saving it
   doShutdownCleanup();       //disconnect interrupts
   delay(5);                  //make sure interrupts have cleared
   doSoftwareReset();         //do soft restart
@@ -2180,57 +3875,136 @@ void processListTranslateInfoCmd(const char *listStr)
   loadListFreqsMHzArrFromEeprom();     //restore list via EEPROM copy
 }
 
-//Loads the 'idxSortedByRssiArr[]' array with a list of channel-index
-// values, sorted by the RSSI values in 'scanRssiValuesArr[]'.
-void loadIdxSortedByRssiArr(boolean inclAllFlag)
+//Returns true if the given channel index ranks above the second one
+// (higher RSSI value, or same RSSI value and lower index).
+inline boolean isRankedAbove(uint8_t idxA, uint8_t idxB)
 {
-  idxSortedSelArrCount = 0;  //idxSortedSelectedArr[] values no longer valid
-  int minIdx,maxIdx;
-  if((!inclAllFlag) && listFreqsMHzArrCount > 0)
-  {  //using 'listFreqsMHzArr[]' entered via 'L' command
-    minIdx = 0;
-    maxIdx = listFreqsMHzArrCount - 1;
+  return (scanRssiValuesArr[idxA] > scanRssiValuesArr[idxB] ||
+                          (scanRssiValuesArr[idxA] == scanRssiValuesArr[idxB] &&
+                                                              idxA < idxB));
+}
+
+//Returns the rank (position in 'idxSortedByRssiArr[]') of the given
+// channel index, found via binary search (O(log n)) using the current
+// 'scanRssiValuesArr[]' entry for the index.  (No inverse array is kept,
+// to save RAM.)
+// idx:  channel index (less than 'rankedIdxCount').
+uint8_t findRankOfIdx(uint8_t idx)
+{
+  uint8_t loPos = 0, hiPos = rankedIdxCount;
+  while(loPos < hiPos)
+  {
+    const uint8_t midPos = (loPos + hiPos) / 2;
+    const uint8_t midIdx = idxSortedByRssiArr[midPos];
+    if(midIdx == idx)
+      return midPos;
+    if(isRankedAbove(midIdx,idx))
+      loPos = midPos + 1;
+    else
+      hiPos = midPos;
   }
-  else
-  {  //not using 'listFreqsMHzArr[]' entered via 'L' command
-    minIdx = CHANNEL_MIN_INDEX;      //using full list of channels
-    maxIdx = CHANNEL_MAX_INDEX;
-  }
-  int idx, sortedArrIdx = 0;
-  uint8_t curMaxRssi, lastMaxRssi = 255;
-  for(int cnt=minIdx; cnt<=maxIdx; ++cnt)
-  {  //loop while filling 'idxSortedByRssiArr[]' (max 'cnt' for safety)
-    curMaxRssi = 0;
-    idx = minIdx;
-    do
-    {  //find current maximum
-      if(scanRssiValuesArr[idx] > curMaxRssi &&
-                                       scanRssiValuesArr[idx] < lastMaxRssi)
-      {  //found new maximum that is not larger then last maximum
-        curMaxRssi = scanRssiValuesArr[idx];
-      }
-    }
-    while(++idx <= maxIdx);
-    idx = minIdx;
-    do
-    {  //find values matching current maximum
-      if(scanRssiValuesArr[idx] == curMaxRssi)
-      {  //value matches current maximum; add index to array
-        idxSortedByRssiArr[sortedArrIdx++] = (uint8_t)idx;
-//        Serial.print(getChannelFreqTableEntry(idx));
-//        Serial.print('(');
-//        Serial.print(idx);
-//        Serial.print(")=");
-//        Serial.print(curMaxRssi);
-//        Serial.print(' ');
-      }
-    }
-    while(++idx <= maxIdx);
-    if(sortedArrIdx > maxIdx || curMaxRssi == 0)
-      break;       //exit if array filled or current max is zero
-    lastMaxRssi = curMaxRssi;     //save max for next iteration
+  return loPos;
+}
+
+//Moves the given channel index to its proper place in the ranked-index
+// array ('idxSortedByRssiArr[]').  This function should be called after
+// the 'scanRssiValuesArr[]' entry for the index changes.  Only the
+// entries between the old and new ranks are shifted, so the work is
+// proportional to the change in rank (O(n) worst case).  Most new
+// readings move an entry by a few ranks at most; an O(1) bucketed
+// ranking would need a bucket per RSSI level (101 of them), which would
+// cost more RAM than the shifting costs time.
+// idx:  channel index (less than 'rankedIdxCount').
+// rank:  current rank of entry (found before its value was changed).
+void updateRankedIdxEntry(uint8_t idx, uint8_t rank)
+{
+  while(rank > 0 && isRankedAbove(idx,idxSortedByRssiArr[rank-1]))
+  {  //entry above ranks lower; shift it down
+    idxSortedByRssiArr[rank] = idxSortedByRssiArr[rank-1];
+    --rank;
+  }
+  while(rank+1 < rankedIdxCount &&
+                               isRankedAbove(idxSortedByRssiArr[rank+1],idx))
+  {  //entry below ranks higher; shift it up
+    idxSortedByRssiArr[rank] = idxSortedByRssiArr[rank+1];
+    ++rank;
+  }
+  idxSortedByRssiArr[rank] = idx;
+}
+
+//Rebuilds the ranked-index array for the given number of channels
+// (via insertion of each entry).
+// count:  number of entries in 'scanRssiValuesArr[]' to be ranked.
+void rebuildRankedIdxArr(uint8_t count)
+{
+  TIMESTATS_START(startUs);
+  rankedIdxCount = 0;
+  while(rankedIdxCount < count)
+  {  //for each entry; add at bottom and move into place
+    idxSortedByRssiArr[rankedIdxCount] = rankedIdxCount;
+    ++rankedIdxCount;
+    updateRankedIdxEntry(rankedIdxCount-1,rankedIdxCount-1);
   }
-//  Serial.println();
+  TIMESTATS_END(TSTAT_RANKSORT,startUs);
+}
+
+//Returns the rank (0 == highest RSSI) of the given channel index, or
+// -1 if the index is not ranked.
+int getRankOfChannelIdx(int idx)
+{
+  return (idx >= 0 && idx < rankedIdxCount) ?
+                                     (int)findRankOfIdx((uint8_t)idx) : -1;
+}
+
+//Returns the channel index at the given rank (0 == highest RSSI), or
+// -1 if no channel at the rank.
+int getChannelIdxAtRank(int rank)
+{
+  return (rank >= 0 && rank < rankedIdxCount) ?
+                                         (int)idxSortedByRssiArr[rank] : -1;
+}
+
+//Returns the channel index ranked just below the given one, or -1 if
+// the given index is the lowest ranked (or not ranked).
+int getNextRankedChannelIdx(int idx)
+{
+  const int rank = getRankOfChannelIdx(idx);
+  return (rank >= 0) ? getChannelIdxAtRank(rank+1) : -1;
+}
+
+//Returns the channel index ranked just above the given one, or -1 if
+// the given index is the highest ranked (or not ranked).
+int getPrevRankedChannelIdx(int idx)
+{
+  const int rank = getRankOfChannelIdx(idx);
+  return (rank > 0) ? getChannelIdxAtRank(rank-1) : -1;
+}
+
+//Copies the channel indices with the highest RSSI values (in ranked
+// order) to the given array.
+// destArr:  destination array.
+// maxCount:  maximum number of indices to copy.
+//Returns the number of indices copied.
+int loadTopRankedChannelIdxs(uint8_t *destArr, int maxCount)
+{
+  if(maxCount > rankedIdxCount)
+    maxCount = rankedIdxCount;
+  if(maxCount > 0)
+    memcpy(destArr,idxSortedByRssiArr,maxCount);
+  return (maxCount > 0) ? maxCount : 0;
+}
+
+//Makes sure the 'idxSortedByRssiArr[]' array holds the list of
+// channel-index values sorted by the RSSI values in 'scanRssiValuesArr[]'.
+// The ranking is kept up to date by 'setSpectrumModelEntry()', so it
+// only needs to be rebuilt when the number of channels changes.
+void loadIdxSortedByRssiArr(boolean inclAllFlag)
+{
+  idxSortedSelArrCount = 0;  //idxSortedSelectedArr[] values no longer valid
+  const uint8_t count = ((!inclAllFlag) && listFreqsMHzArrCount > 0) ?
+              (uint8_t)listFreqsMHzArrCount : (uint8_t)(getChannelMaxIndex()+1);
+  if(count != rankedIdxCount)
+    rebuildRankedIdxArr(count);
 }
 
 //Loads the 'idxSortedSelectedArr[]' array with a list of channel-index
@@ -2239,22 +4013,30 @@ void loadIdxSortedByRssiArr(boolean inclAllFlag)
 // sorted by the RSSI values in 'scanRssiValuesArr[]'.
 int loadIdxSortedSelectedArr()
 {
+  loadIdxSortedByRssiArr(true);        //make sure all channels are ranked
+  TIMESTATS_START(startUs);
+  uint16_t selFreqsArr[SELFREQS_CACHE_SIZE];  //freqs of loaded channels
   int selIdx = 0;
   uint8_t curIdx;
-  for(int idx=CHANNEL_MIN_INDEX; idx<=CHANNEL_MAX_INDEX; ++idx)
+  uint16_t curFreq, selFreq;
+  const int maxIdx = getChannelMaxIndex();
+  for(int idx=CHANNEL_MIN_INDEX; idx<=maxIdx; ++idx)
   {  //for each channel-index value in 'idxSortedByRssiArr[]' array
     curIdx = idxSortedByRssiArr[idx];
+    curFreq = getChannelFreqTableEntry(curIdx);
     int j = 0;
     while(true)
     {  //loop while comparing channel-freq value to values already loaded
       if(j >= selIdx)
       {  //no more loaded values left to check (or is first one)
+        if(selIdx < SELFREQS_CACHE_SIZE)
+          selFreqsArr[selIdx] = curFreq;
         idxSortedSelectedArr[selIdx++] = curIdx;      //load channel index
         break;
       }
-      if(abs((int)getChannelFreqTableEntry(curIdx)-
-                (int)getChannelFreqTableEntry(idxSortedSelectedArr[j])) <=
-                                                             ADJ_CHAN_MHZ)
+      selFreq = (j < SELFREQS_CACHE_SIZE) ? selFreqsArr[j] :
+                         getChannelFreqTableEntry(idxSortedSelectedArr[j]);
+      if(abs((int)curFreq-(int)selFreq) <= ADJ_CHAN_MHZ)
       {  //channel-frequency value is too close to an already-load freq
         break;     //discard channel
       }
@@ -2263,6 +4045,7 @@ int loadIdxSortedSelectedArr()
   }
          //save and return # of entries in 'idxSortedByRssiArr[]' array:
   idxSortedSelArrCount = selIdx;
+  TIMESTATS_END(TSTAT_SQUELCH,startUs);
   return selIdx;
 }
 
@@ -2293,6 +4076,9 @@ void showDebugInputs()
   Serial.print(digitalRead(3));
   Serial.print(", D4=");
   Serial.print(digitalRead(4));
+#if RSSI_ADCSAMPLER_FLAG
+  rssiSamplerStop();              //stop sampler so 'analogRead()' may be used
+#endif
   analogRead(A5);                 //do pre-reads to help settle inputs
   Serial.print(", A5=");
   Serial.print(analogRead(A5));
@@ -2302,6 +4088,9 @@ void showDebugInputs()
   analogRead(A7);
   Serial.print(", A7=");
   Serial.println(analogRead(A7));
+#if RSSI_ADCSAMPLER_FLAG
+  rssiSamplerRestart();
+#endif
 }
 
 #if DISP7SEG_ENABLED_FLAG
@@ -2327,38 +4116,59 @@ void processWriteDisplayCmd(const char *valueStr)
 #endif
 
 //Steps through table values comparing register values via
-// 'freqMhzToRegVal()' vs table and sends report to serial port.
+// 'freqMhzToRegVal()' vs table and sends report to serial port (via
+// command steps).
 void checkReportTableValues()
 {
-  int tableIdx;
-  uint16_t freqVal, calcRegVal, tableRegVal;
+  startCommandSteps(checkReportTableStep);
+}
 
-  for(int idx=CHANNEL_MIN_INDEX; idx<=CHANNEL_MAX_INDEX; ++idx)
-  {
-//    tableIdx = (int)getChannelSortTableEntry(idx);    //sort by MHz
-    tableIdx = idx;
-    freqVal = getChannelFreqTableEntry(tableIdx);
-    calcRegVal = freqMhzToRegVal(freqVal);
-    tableRegVal = getChannelRegTableEntry(tableIdx);
+//Command step that shows the first or second half of the line for the
+// next entry in the report of calculated vs table values.
+// posPtr:  pointer to position in report.
+// Returns true if there is more to show; false if done.
+boolean checkReportTableStep(uint16_t *posPtr)
+{
+  const uint16_t pos = (*posPtr)++;
+//  const int tableIdx =                               //sort by MHz
+//            (int)getChannelSortTableEntry(CHANNEL_MIN_INDEX + pos/2);
+  const int tableIdx = CHANNEL_MIN_INDEX + pos/2;
+  const uint16_t freqVal = getChannelFreqTableEntry(tableIdx);
+  const uint16_t calcRegVal = freqMhzToRegVal(freqVal);
+  if((pos & 1) == 0)
+  {  //first half of line
     Serial.print(' ');
     Serial.print(freqVal);
     Serial.print(F("MHz : calc=0x"));
     Serial.print(itoa(calcRegVal,itoaBuff,16));
-    Serial.print(F(" table=0x"));
-    Serial.print(itoa(tableRegVal,itoaBuff,16));
-    Serial.print(F(" (="));
-    Serial.print(regValToFreqMhz(calcRegVal));
-    Serial.print(')');
-    if(calcRegVal == tableRegVal)
-      Serial.println(F("  OK"));
+    return true;
+  }
+  const uint16_t tableRegVal = getChannelRegTableEntry(tableIdx);
+  Serial.print(F(" table=0x"));
+  Serial.print(itoa(tableRegVal,itoaBuff,16));
+  Serial.print(F(" (="));
+  Serial.print(regValToFreqMhz(calcRegVal));
+  Serial.print(')');
+  if(calcRegVal == tableRegVal)
+    Serial.println(F("  OK"));
+  else
+  {
+    if(abs(calcRegVal-tableRegVal) == 1)
+      Serial.println(F("  Off by 1MHz"));
     else
-    {
-      if(abs(calcRegVal-tableRegVal) == 1)
-        Serial.println(F("  Off by 1MHz"));
-      else
-        Serial.println(F("  Mismatch"));
-    }
+      Serial.println(F("  Mismatch"));
   }
+  return (tableIdx < getChannelMaxIndex());
+}
+
+//Measures the time taken to send a tuning frame to the RX5808 module
+// and sends report (in microseconds) to serial port.
+void showTuneWriteTime()
+{
+  Serial.print(' ');
+  if(serialEchoFlag)
+    Serial.print(F("RX5808 tune-write time (us):  "));
+  Serial.println(measureRx5808TuneWriteUs(100));
 }
 
 //Sets tuner frequency to given frequency or frequency code word.
@@ -2376,6 +4186,7 @@ void setCurrentFreqByMhzOrCode(uint16_t freqMhzOrCode)
   else
     freqInMHz = freqMhzOrCode;         //given value is freq in MHz
   setChannelByFreq(freqInMHz);                   //set tuner
+  rssiRecAddTune(freqInMHz);                     //record tune
   currentTunerFreqMhzOrCode = freqMhzOrCode;     //save freq MHz or code
   currentTunerFreqInMhz = freqInMHz;             //save freq in MHz
 }
@@ -2421,6 +4232,33 @@ void setTunerChannelToFreq(uint16_t freqMhzOrCode)
 // This function should be called on a periodic basis.
 void updateRssiOutput()
 {
+#if RSSIOUT_TICKTASK_FLAG
+  if(tickSchedIsRunning() && rssiSamplerIsRunning())
+  {  //RSSI input sampled via tick task; process value when ready
+    if(!rssiOutTickAvgReadyFlag)
+      return;
+    const uint16_t rawAvgVal = rssiOutTickAvgVal;
+    const boolean curMarkFlag =
+                 (rssiOutTickAvgMarkSeqNum == rssiSamplerGetMarkSeqNum());
+    rssiOutTickAvgReadyFlag = false;        //allow next value from task
+    if(!curMarkFlag)      //if tuner changed since value taken then
+      return;             //discard value
+    updateRssiOutValue(scaleRawRssiValue(rawAvgVal));
+    if(autoRssiCalibEnabledFlag)            //if auto-calib enabled then
+      processAutoRssiCalValue(rawAvgVal);   //process received value
+    return;
+  }
+#endif
+#if RSSI_ADCSAMPLER_FLAG
+  if(rssiSamplerIsRunning())
+  {  //take sample every other sampler period (~208us, which is close to
+     // the rate of the blocking reads done without the sampler)
+    const uint16_t seqNum = rssiSamplerGetSeqNum();
+    if((uint16_t)(seqNum - rssiOutLastSampleSeqNum) < (uint16_t)2)
+      return;
+    rssiOutLastSampleSeqNum = seqNum;
+  }
+#endif
   rssiOutSamplingAvgrTotal += sampleRawRssiValue();
   if(++rssiOutSamplingAvgrCounter >= RSSI_SAMPAVG_COUNT)
   {  //enough samples received; send average to output
@@ -2439,9 +4277,44 @@ void clearRssiOutput()
 {
   rssiOutSamplingAvgrTotal = 0;
   rssiOutSamplingAvgrCounter = 0;
+#if RSSIOUT_TICKTASK_FLAG
+  rssiOutTickAvgReadyFlag = false;     //discard any value from tick task
+#endif
   updateRssiOutValue((uint16_t)0);
 }
 
+#if RSSIOUT_TICKTASK_FLAG
+//Tick task that samples the RSSI input for the analog-RSSI output.  The
+// sampler values taken over RSSIOUT_TICKTASK_RUNS runs are averaged (the
+// window is restarted when the tuner channel changes) and the result is
+// left for 'updateRssiOutput()'.  Called from the Timer1 tick interrupt.
+void rssiOutTickTask()
+{
+  const uint16_t markSeqNum = rssiSamplerGetMarkSeqNum();
+  if(markSeqNum != rssiOutTickMarkSeqNum)
+  {  //tuner channel changed; restart window
+    rssiOutTickMarkSeqNum = markSeqNum;
+    rssiOutTickTotal = 0;
+    rssiOutTickCount = 0;
+    rssiOutTickRunCount = 0;
+  }
+  rssiOutTickCount += rssiSamplerAddNewSamples(&rssiOutTickSeqNum,
+                                                         &rssiOutTickTotal);
+  if(++rssiOutTickRunCount >= RSSIOUT_TICKTASK_RUNS)
+  {  //end of window
+    if(rssiOutTickCount > 0 && !rssiOutTickAvgReadyFlag)
+    {  //samples taken and previous value was taken up
+      rssiOutTickAvgVal = (uint16_t)(rssiOutTickTotal/rssiOutTickCount);
+      rssiOutTickAvgMarkSeqNum = markSeqNum;
+      rssiOutTickAvgReadyFlag = true;
+    }
+    rssiOutTickTotal = 0;
+    rssiOutTickCount = 0;
+    rssiOutTickRunCount = 0;
+  }
+}
+#endif
+
 #if BUTTONS_ENABLED_FLAG
 
 //Processes command to set/show button mode.
@@ -2500,12 +4373,49 @@ byte fetchButtonsCurrentState()
 #elif BUTTONPINS_UP3DOWN2_FLAG
   return ((getD3InputCurrentState() == LOW) ? UP_BUTTON_MASK : (byte)0) |
            ((getD2InputCurrentState() == LOW) ? DOWN_BUTTON_MASK : (byte)0);
+#elif BUTTONPINS_TICKSAMPLED_FLAG   //if not using D2/D3 then use state
+  return buttonsTickCurrentMask;      // sampled via tick task
 #else         //if not using D2/D3 then do polling:
   return ((digitalRead(UP_BUTTON_PIN) == LOW) ? UP_BUTTON_MASK : (byte)0) |
        ((digitalRead(DOWN_BUTTON_PIN) == LOW) ? DOWN_BUTTON_MASK : (byte)0);
 #endif
 }
 
+#if BUTTONPINS_TICKSAMPLED_FLAG
+//Tick task that samples and debounces the button inputs (when not
+// tracked via the D2/D3 interrupts), so that presses are caught while
+// 'loop()' is busy.  A change to the inputs is accepted after they have
+// been steady for BUTTON_DEBOUNCE_TIMEMS, and the buttons task is then
+// woken to handle it.  Called from the Timer1 tick interrupt.
+void buttonsTickTask()
+{
+  const byte curMask =
+         ((digitalRead(UP_BUTTON_PIN) == LOW) ? UP_BUTTON_MASK : (byte)0) |
+       ((digitalRead(DOWN_BUTTON_PIN) == LOW) ? DOWN_BUTTON_MASK : (byte)0);
+  if(curMask != buttonsTickSampleMask)
+  {  //inputs changed since last sample; restart debounce
+    buttonsTickSampleMask = curMask;
+    buttonsTickSteadyCount = 0;
+    buttonsTickEdgeUs = micros() -     //(changed after previous sample)
+                   (unsigned long)TICKSCHED_PERIOD_BUTTONS*TICKSCHED_TICK_US;
+    return;
+  }
+  if(curMask == buttonsTickCurrentMask ||
+                  ++buttonsTickSteadyCount < BUTTONS_TICKTASK_DEBOUNCE_RUNS)
+  {  //no change from debounced state or not steady long enough
+    return;
+  }
+  const byte newMask = curMask & ~buttonsTickCurrentMask;
+  if((newMask & UP_BUTTON_MASK) != (byte)0)      //if high-to-low then
+    ++buttonsTickUpTrigCounter;                  //increment counter
+  if((newMask & DOWN_BUTTON_MASK) != (byte)0)
+    ++buttonsTickDownTrigCounter;
+  buttonsTickCurrentMask = curMask;
+  buttonsTickChangeUs = buttonsTickEdgeUs;       //time of input edge
+  runQueueWakeTask(RUNQ_TASK_BUTTONS);           //have buttons task run next
+}
+#endif
+
 //Fetches current trigger states of buttons.  A mask bit will be returned
 // if a high-to-low transition on a corresponding button has been detected
 // since the last time this function was called.
@@ -2519,6 +4429,24 @@ byte fetchButtonsTriggerState()
 #elif BUTTONPINS_UP3DOWN2_FLAG
   return (getD3InputTriggeredFlag() ? UP_BUTTON_MASK : (byte)0) |
                    (getD2InputTriggeredFlag() ? DOWN_BUTTON_MASK : (byte)0);
+#elif BUTTONPINS_TICKSAMPLED_FLAG
+  static byte buttonsUpTrackCounter = 0;
+  static byte buttonsDownTrackCounter = 0;
+
+  byte retMask = NO_BUTTONS_MASK;
+  const byte upVal = buttonsTickUpTrigCounter;   //fetch values (thread safe)
+  const byte downVal = buttonsTickDownTrigCounter;
+  if(upVal != buttonsUpTrackCounter)
+  {  //press detected via tick task
+    buttonsUpTrackCounter = upVal;
+    retMask |= UP_BUTTON_MASK;
+  }
+  if(downVal != buttonsDownTrackCounter)
+  {  //press detected via tick task
+    buttonsDownTrackCounter = downVal;
+    retMask |= DOWN_BUTTON_MASK;
+  }
+  return retMask;
 #else
   return NO_BUTTONS_MASK;    //if not using D2/D3 then no triggering
 #endif
@@ -2537,7 +4465,10 @@ byte readButtonsState(boolean clearButtonClickOnLongPressFlag)
   static byte buttonsInputTrackedMask = 0;       //tracked state for debounce
   static byte buttonsInputLongPressMask = 0;     //track held long-presses
   static unsigned long buttonsInputLastChangeTime = millis();
+  static unsigned long buttonsInputPrevPollUs = micros();
 
+  const unsigned long prevPollUs = buttonsInputPrevPollUs;
+  buttonsInputPrevPollUs = micros();
   const unsigned long curTimeMs = millis();
   const byte curMask = fetchButtonsCurrentState();     //get current state
   byte trigMask;             //check if any triggers since last time
@@ -2549,18 +4480,33 @@ byte readButtonsState(boolean clearButtonClickOnLongPressFlag)
   if(curMask != buttonsInputCurrentMask || trigMask != (byte)0)
   {  //buttons changed since last time through or trigger detected
     buttonsInputLastChangeTime = curTimeMs; //reset last-change time
+#if BUTTONPINS_TICKSAMPLED_FLAG       //use edge time from tick task
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+      buttonsInputChangeUs = buttonsTickChangeUs;
+    }
+#else         //change happened after previous poll
+    buttonsInputChangeUs = prevPollUs;
+#endif
          //if not using interrupts then detect triggers via polling:
-#if !BUTTONPINS_USEINTERRUPT_FLAG
+#if !BUTTONPINS_USEINTERRUPT_FLAG && !BUTTONPINS_TICKSAMPLED_FLAG
     if((curMask & BOTH_BUTTONS_MASK & ~buttonsInputCurrentMask) != (byte)0)
       trigMask = curMask & BOTH_BUTTONS_MASK & ~buttonsInputCurrentMask;
 #endif
     buttonsInputCurrentMask = curMask;      //update current-state mask
     buttonsInputDetectedMask |= trigMask;   //keep track of presses
+#if !BUTTONPINS_TICKSAMPLED_FLAG       //(tick task debounces its state)
     return buttonsInputLongPressMask;       //no change to long-presses
+#endif
   }
+#if BUTTONPINS_TICKSAMPLED_FLAG       //state already debounced
+  const boolean steadyFlag = true;
+#else
+  const boolean steadyFlag =
+          (curTimeMs - buttonsInputLastChangeTime >= BUTTON_DEBOUNCE_TIMEMS);
+#endif
   if((buttonsInputCurrentMask == buttonsInputTrackedMask &&
-                             buttonsInputDetectedMask == NO_BUTTONS_MASK) ||
-            curTimeMs - buttonsInputLastChangeTime < BUTTON_DEBOUNCE_TIMEMS)
+              buttonsInputDetectedMask == NO_BUTTONS_MASK) || !steadyFlag)
   {  //buttons not changed or not enough time elapsed since last change
     return buttonsInputLongPressMask;       //no change to long-presses
   }
@@ -2796,15 +4742,18 @@ void saveFreqValToEeprom(uint16_t freqVal)
   writeWordToEeprom(EEPROM_ADRW_FREQ,freqVal);
 }
 
-//Saves the current frequency value to EEPROM (if changed).
-void saveCurrentFreqToEeprom()
+//Saves the current frequency value to EEPROM (if changed), one byte
+// per call.
+// Returns true if the save is done; false if more remains to be written.
+boolean saveCurrentFreqToEepromStep()
 {
   const uint16_t curFreqVal = currentTunerFreqMhzOrCode;
-  if(curFreqVal != lastEepromFreqInMhzOrCode)
-  {  //different from saved value
-    saveFreqValToEeprom(curFreqVal);
-    lastEepromFreqInMhzOrCode = curFreqVal;
-  }
+  if(curFreqVal == lastEepromFreqInMhzOrCode)
+    return true;                       //same as saved value
+  if(writeWordToEepromStep(EEPROM_ADRW_FREQ,curFreqVal))
+    return false;                      //byte written; check again later
+  lastEepromFreqInMhzOrCode = curFreqVal;
+  return true;
 }
 
 //Loads and returns frequency value from EEPROM.
@@ -2859,6 +4808,26 @@ byte loadButtonModeFromEeprom()
 
 //Saves current min/max-raw-RSSI values for scaling to EEPROM.
 void saveRssiMinMaxValsToEeprom()
+{
+  showRssiMinMaxCalibValues();
+  writeWordToEeprom(EEPROM_ADRW_RSSIMIN,getRx5808RawRssiMinVal());
+  writeWordToEeprom(EEPROM_ADRW_RSSIMAX,getRx5808RawRssiMaxVal());
+}
+
+//Saves current min/max-raw-RSSI values for scaling to EEPROM, one byte
+// per call.
+// Returns true if the save is done; false if more remains to be written.
+boolean saveRssiMinMaxValsToEepromStep()
+{
+  return !writeWordToEepromStep(EEPROM_ADRW_RSSIMIN,
+                                               getRx5808RawRssiMinVal()) &&
+         !writeWordToEepromStep(EEPROM_ADRW_RSSIMAX,
+                                               getRx5808RawRssiMaxVal());
+}
+
+//Shows the current min/max-raw-RSSI values for scaling, if the auto
+// RSSI calibration debug output (and serial echo) is enabled.
+void showRssiMinMaxCalibValues()
 {
   if(autoRssiCalibShowOutputFlag && serialEchoFlag)
   {  //debug output (and serial echo) enabled
@@ -2868,8 +4837,6 @@ void saveRssiMinMaxValsToEeprom()
     Serial.print((int)getRx5808RawRssiMaxVal());
     Serial.println(']');
   }
-  writeWordToEeprom(EEPROM_ADRW_RSSIMIN,getRx5808RawRssiMinVal());
-  writeWordToEeprom(EEPROM_ADRW_RSSIMAX,getRx5808RawRssiMaxVal());
 }
 
 //Loads and stores current min/max-raw-RSSI values for scaling from EEPROM.
@@ -2954,6 +4921,15 @@ void saveListFreqsMHzArrToEeprom()
                                       listFreqsMHzArr,listFreqsMHzArrCount);
 }
 
+//Saves the list of values entered via the 'L' command to EEPROM, one
+// byte per call.
+// Returns true if the save is done; false if more remains to be written.
+boolean saveListFreqsMHzArrToEepromStep()
+{
+  return !writeUint16ArrayToEepromStep(EEPROM_ADRA_FREQLIST,
+               EEPROM_FLEN_FREQLIST,listFreqsMHzArr,listFreqsMHzArrCount);
+}
+
 //Loads the list of values entered via the 'L' command from EEPROM.
 void loadListFreqsMHzArrFromEeprom()
 {
@@ -2961,6 +4937,58 @@ void loadListFreqsMHzArrFromEeprom()
                                       listFreqsMHzArr,LISTFREQMHZ_ARR_SIZE);
 }
 
+//Saves the user-defined bands to EEPROM.  Each band is saved as its
+// band-code character followed by its frequency values (unused entries
+// are filled with 0xFF).
+void saveCustomBandsToEeprom()
+{
+  const int numCustom = getCustomBandsCount();
+  const int firstBandIdx = CUSTOM_FIRST_INDEX / CHANNEL_BAND_SIZE;
+  int addr = EEPROM_ADRA_CUSTBANDS;
+  for(int b=0; b<CUSTOM_BANDS_MAXCOUNT; ++b)
+  {  //for each user-defined band entry
+    if(b < numCustom)
+    {  //band in use; save code and frequencies
+      writeByteToEeprom(addr,(uint8_t)getFreqBandCode(firstBandIdx+b));
+      for(int i=0; i<CHANNEL_BAND_SIZE; ++i)
+      {
+        writeWordToEeprom(addr+1+i*2,getChannelFreqTableEntry(
+                  CUSTOM_FIRST_INDEX+b*CHANNEL_BAND_SIZE+i));
+      }
+    }
+    else if(readByteFromEeprom(addr) != (uint8_t)0xFF)
+      writeByteToEeprom(addr,(uint8_t)0xFF);     //mark entry unused
+    addr += EEPROM_FLEN_CUSTBAND;
+  }
+}
+
+//Loads the user-defined bands from EEPROM.  Entries with invalid
+// values are ignored.
+void loadCustomBandsFromEeprom()
+{
+  clearCustomBands();
+  uint16_t freqsArr[CHANNEL_BAND_SIZE];
+  int addr = EEPROM_ADRA_CUSTBANDS;
+  for(int b=0; b<CUSTOM_BANDS_MAXCOUNT; ++b)
+  {  //for each user-defined band entry
+    const char bandCh = (char)readByteFromEeprom(addr);
+    if(bandCh >= 'A' && bandCh <= 'Z')
+    {  //band code OK; load frequencies
+      int i = 0;
+      while(i < CHANNEL_BAND_SIZE)
+      {
+        freqsArr[i] = readWordFromEeprom(addr+1+i*2);
+        if(freqsArr[i] < MIN_CHANNEL_MHZ || freqsArr[i] > MAX_CHANNEL_MHZ)
+          break;        //if value out of range then ignore entry
+        ++i;
+      }
+      if(i >= CHANNEL_BAND_SIZE)
+        setCustomBand(bandCh,freqsArr);
+    }
+    addr += EEPROM_FLEN_CUSTBAND;
+  }
+}
+
 //Sets all EEPROM values to defaults (by setting all used bytes to 0xFF).
 void setEepromToDefaultsValues()
 {
@@ -3045,10 +5073,41 @@ void updateActivityIndicator(boolean activityFlag)
 // Returns:  An averaged RSSI value from MIN_RSSI_VAL to MAX_RSSI_VAL.
 uint16_t readRssiValue()
 {
+  TIMESTATS_START(startUs);
   uint16_t rawVal = readRawRssiValue();
+  TIMESTATS_END(TSTAT_RSSIREAD,startUs);
   if(autoRssiCalibEnabledFlag)         //if auto-calib enabled then
     processAutoRssiCalValue(rawVal);   //process received value
-  return scaleRawRssiValue(rawVal);    //scale MIN_RSSI_VAL to MAX_RSSI_VAL
+                             //scale MIN_RSSI_VAL to MAX_RSSI_VAL:
+  return scaleRawRssiValue(rawVal);
+}
+
+//Reads the RSSI value for the currently-tuned channel.  If continuous-
+// RSSI output is in progress then the number of readings set via the
+// 'O' command (averaging window) are averaged.  The value is recorded
+// (see RssiRecorder).
+// Returns:  A scaled RSSI value.
+uint16_t readAvgRssiValue()
+{
+  uint16_t rssiVal;
+  if(!contRssiOutFlag || contRssiWindowCount <= 1)
+  {
+    rssiVal = readRssiValue();
+    rssiRecAddReading(rssiVal);        //record value
+    return rssiVal;
+  }
+  uint16_t sumVal = 0;
+  for(uint8_t i=0; i<contRssiWindowCount; ++i)
+  {  //for each reading in averaging window
+#if RSSI_ADCSAMPLER_FLAG
+    if(i > 0)
+      rssiSamplerMarkTune();      //make next reading use new samples
+#endif
+    sumVal += readRssiValue();
+  }
+  rssiVal = (sumVal + contRssiWindowCount/2) / contRssiWindowCount;
+  rssiRecAddReading(rssiVal);          //record averaged value
+  return rssiVal;
 }
 
 //Does auto RSSI calibration with given value.
@@ -3100,7 +5159,7 @@ void processAutoRssiCalValue(uint16_t rawVal)
             return;          //if outside range then don't change
         }
         setRx5808RawRssiMinMax(minVal,maxVal);   //update values
-        saveRssiMinMaxValsToEeprom();            //save persistent values
+        delayedSaveRssiMinMaxFlag = true;        //save via EEPROM task
       }
       else
         ++autoRssiCalibCounterValue;
@@ -5,12 +5,15 @@
 
 #include <Arduino.h>
 #include <EEPROM.h>
+#include "Config.h"
 #include "ArduVidUtil.h"
+#include "LatencyHist.h"
 
 boolean serialEchoFlag = true;         //global flag for serial-echo mode
 
 char serialInputBuffer[RECV_BUFSIZ] = { '\0' };
 int serialInputBuffPos = 0;
+boolean serialInputOverflowFlag = false;     //true if line too long
 boolean serialInputPromptFlag = true;
 uint16_t serialInputLastTwoChars = 0;
 char lastCommandChar = '\0';
@@ -102,6 +105,23 @@ char *doRecvNextSerialLine(boolean flushingFlag)
                               serialInputBuffer[0] == SERIAL_LIGNORE_CHAR));
     if(ch == KEY_CR || ch == KEY_LF)
     {  //end of line
+      if(serialInputOverflowFlag)
+      {  //line was too long for buffer; discard it and show error
+        serialInputOverflowFlag = false;
+        serialInputBuffPos = 0;
+        serialInputBuffer[0] = '\0';
+        lastCommandChar = '\0';
+        serialInputLastTwoChars = (uint16_t)ch;  //set input tracker to char
+        if(!flushingFlag)
+        {  //not flushing lines of input data
+          Serial.println();
+          Serial.print(F(" Input line too long (max "));
+          Serial.print(RECV_BUFSIZ-2);
+          Serial.println(F(" chars); ignored"));
+          serialInputPromptFlag = true;
+        }
+        return NULL;
+      }
       if(!ignoreFlag)
       {  //input is not line that begins with '>' or ' '
               //if command entered then save command character
@@ -133,15 +153,19 @@ char *doRecvNextSerialLine(boolean flushingFlag)
       }
       return NULL;
     }
-    if(ch >= ' ' && ch <= 'z' && ch != KEY_ESCNXT &&
-                                         serialInputBuffPos < RECV_BUFSIZ-2)
-    {  //character is valid and enough room in buffer
+    if(ch >= ' ' && ch <= 'z' && ch != KEY_ESCNXT)
+    {  //character is valid
       if(!ignoreFlag)
       {  //input is not line that begins with '>' or ' '
-        serialInputBuffer[serialInputBuffPos++] = ch;    //add received char
-        serialInputBuffer[serialInputBuffPos] = '\0';
-        if(echoFlag)
-          Serial.write((int)ch);
+        if(serialInputBuffPos < RECV_BUFSIZ-2)
+        {  //enough room in buffer
+          serialInputBuffer[serialInputBuffPos++] = ch;  //add received char
+          serialInputBuffer[serialInputBuffPos] = '\0';
+          if(echoFlag)
+            Serial.write((int)ch);
+        }
+        else                           //no room; line will be rejected
+          serialInputOverflowFlag = true;     // (instead of truncated)
       }
       serialInputLastTwoChars = (uint16_t)ch;    //set input tracker to char
     }
@@ -184,6 +208,14 @@ char *getNextSerialLine()
   return doRecvNextSerialLine(false);
 }
 
+//Returns next line of data from the serial port, or NULL if not
+// available.  The input prompt is not shown (for use while the system
+// is busy with a command in progress).
+char *pollNextSerialLine()
+{
+  return doRecvNextSerialLine(false);
+}
+
 //Clears any queued lines of serial-input data.
 void flushSerialInputLines()
 {
@@ -303,10 +335,13 @@ void doSoftwareReset()
   asm volatile ("  jmp 0");
 }
 
-//Writes byte to EEPROM at address.
+//Writes byte to EEPROM at address.  The byte is only written if it
+// differs from the value already there (an EEPROM write takes about
+// 3.4 ms, while a read is nearly immediate).
 void writeByteToEeprom(int addr, uint8_t val)
 {
-  EEPROM.write(addr,val);
+  if(EEPROM.read(addr) != val)
+    EEPROM.write(addr,val);
 }
 
 //Reads byte at address from EEPROM.
@@ -318,8 +353,23 @@ uint8_t readByteFromEeprom(int addr)
 //Writes 2-byte word to EEPROM at address.
 void writeWordToEeprom(int addr, uint16_t val)
 {
-  EEPROM.write(addr,lowByte(val));
-  EEPROM.write(addr+1,highByte(val));
+  writeByteToEeprom(addr,lowByte(val));
+  writeByteToEeprom(addr+1,highByte(val));
+}
+
+//Writes the first byte of a 2-byte word that differs from the value
+// already in EEPROM at address, so that at most one EEPROM write is done
+// per call.
+// Returns true if a byte was written; false if the word is already there.
+boolean writeWordToEepromStep(int addr, uint16_t val)
+{
+  if(EEPROM.read(addr) != lowByte(val))
+    EEPROM.write(addr,lowByte(val));
+  else if(EEPROM.read(addr+1) != highByte(val))
+    EEPROM.write(addr+1,highByte(val));
+  else
+    return false;
+  return true;
 }
 
 //Reads 2-byte word at address from EEPROM.
@@ -341,14 +391,14 @@ void writeStringToEeprom(int addr, const char *str, int fieldLen)
   while(true)
   {  //for each byte written
     btVal = (uint8_t)str[i];
-    EEPROM.write(addr+i,btVal);
+    writeByteToEeprom(addr+i,btVal);
     if(++i >= fieldLen)      //if entire field filled then
       return;                //exit function
     if(btVal == (uint8_t)0)       //if end of string then
       break;                      //exit loop
   }
   do     //fill rest of field with nulls
-    EEPROM.write(addr+i,(uint8_t)0);
+    writeByteToEeprom(addr+i,(uint8_t)0);
   while(++i < fieldLen);
 }
 
@@ -421,6 +471,30 @@ boolean writeUint16ArrayToEeprom(int addr, int fieldLen,
   return true;
 }
 
+//Writes the first byte of an array of uint16 values (stored as via
+// 'writeUint16ArrayToEeprom()') that differs from the value already in
+// EEPROM, so that at most one EEPROM write is done per call.
+// addr:  EEPROM address.
+// fieldLen:  Length (in bytes) of storage field in EEPROM.
+// uintArr:  Array of uint16 values.
+// arrCount:  Number of entries in array.
+// Returns true if a byte was written; false if the array is already
+// there (or 'arrCount' value out of bounds).
+boolean writeUint16ArrayToEepromStep(int addr, int fieldLen,
+                                            uint16_t *uintArr, int arrCount)
+{
+  if(arrCount > (fieldLen-2)/2 || arrCount < 0)
+    return false;
+  if(writeWordToEepromStep(addr,(uint16_t)arrCount))
+    return true;
+  for(int i=0; i<arrCount; ++i)
+  {  //for each entry; check EEPROM location
+    if(writeWordToEepromStep(addr+2+i*2,uintArr[i]))
+      return true;
+  }
+  return false;
+}
+
 //Reads array of uint16 values from EEPROM at address.
 // addr:  EEPROM address.
 // uintArr:  Array to receive uint16 values.
@@ -446,10 +520,16 @@ int readUint16ArrayFromEeprom(int addr, uint16_t *uintArr, int maxArrCount)
 //Interrupt-service routine that tracks the D2 input pin.
 void d2InterruptRoutine()
 {
+#if LATENCYHIST_ENABLED_FLAG
+  const unsigned long isrEntryUs = micros();
+#endif
   const byte newState = digitalRead(2);
   if(trackedD2InputState == HIGH && newState == LOW)
     ++triggerD2LiveCounter;    //if high-to-low transition then change value
   trackedD2InputState = newState;           //save current state
+#if LATENCYHIST_ENABLED_FLAG
+  latencyHistAddValue(LHIST_PINISR,micros()-isrEntryUs);
+#endif
 }
 
 //Installs the interrupt-service routine for the D2 input pin.
@@ -488,10 +568,16 @@ boolean getD2InputTriggeredFlag()
 //Interrupt-service routine that tracks the D3 input pin.
 void d3InterruptRoutine()
 {
+#if LATENCYHIST_ENABLED_FLAG
+  const unsigned long isrEntryUs = micros();
+#endif
   const byte newState = digitalRead(3);
   if(trackedD3InputState == HIGH && newState == LOW)
     ++triggerD3LiveCounter;    //if high-to-low transition then change value
   trackedD3InputState = newState;           //save current state
+#if LATENCYHIST_ENABLED_FLAG
+  latencyHistAddValue(LHIST_PINISR,micros()-isrEntryUs);
+#endif
 }
 
 //Installs the interrupt-service routine for the D3 input pin.
@@ -32,10 +32,28 @@
 #define CMD_KEY_HOME 'S'
 #define CMD_KEY_END 'M'
 
+    //direct-port pin access for ATmega328/168 (Uno/Nano/Pro Mini) pin
+    // numbering; with a constant pin number each set resolves at compile
+    // time to a single 'sbi'/'cbi' instruction (which is interrupt safe):
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__) || \
+                                             defined(__AVR_ATmega168__)
+#define DIRECTPIN_SUPPORTED_FLAG true
+#else
+#define DIRECTPIN_SUPPORTED_FLAG false
+#endif
+#define DIRECTPIN_PORTREG(pin) \
+               (((pin) < 8) ? &PORTD : (((pin) < 14) ? &PORTB : &PORTC))
+#define DIRECTPIN_BITMASK(pin) ((uint8_t)(1 << (((pin) < 8) ? (pin) : \
+                              (((pin) < 14) ? ((pin) - 8) : ((pin) - 14)))))
+#define DIRECTPIN_SET_HIGH(pin) (*DIRECTPIN_PORTREG(pin) |= DIRECTPIN_BITMASK(pin))
+#define DIRECTPIN_SET_LOW(pin) \
+                   (*DIRECTPIN_PORTREG(pin) &= (uint8_t)~DIRECTPIN_BITMASK(pin))
+
 #define SERIAL_PROMPT_CHAR '>'         //prompt char for serial input
 #define SERIAL_LIGNORE_CHAR ' '        //ignore line if begins with this
 
 char *getNextSerialLine();
+char *pollNextSerialLine();
 void flushSerialInputLines();
 boolean getSerialInputAvailflag();
 void setSerialInputPromptFlag();
@@ -50,6 +68,7 @@ void doSoftwareReset();
 void writeByteToEeprom(int addr, uint8_t val);
 uint8_t readByteFromEeprom(int addr);
 void writeWordToEeprom(int addr, uint16_t val);
+boolean writeWordToEepromStep(int addr, uint16_t val);
 uint16_t readWordFromEeprom(int addr);
 void writeStringToEeprom(int addr, const char *str, int fieldLen);
 int readStringFromEeprom(int addr, char *outStr, int fieldLen);
@@ -57,6 +76,8 @@ boolean isStringFromEepromEmpty(int addr);
 int showStringFromEeprom(int addr, int fieldLen);
 boolean writeUint16ArrayToEeprom(int addr, int fieldLen,
                                            uint16_t *uintArr, int arrCount);
+boolean writeUint16ArrayToEepromStep(int addr, int fieldLen,
+                                            uint16_t *uintArr, int arrCount);
 int readUint16ArrayFromEeprom(int addr, uint16_t *uintArr, int maxArrCount);
 void installD2InterruptRoutine();
 void uninstallD2InterruptRoutine();
@@ -0,0 +1,95 @@
+//BinFrames.cpp:  Binary-framed serial output.  When enabled (via the
+//                'XO' command), scan and RSSI results are sent as
+//                compact frames (with sequence numbers and CRCs)
+//                instead of as ASCII text.  Frames are sent via the
+//                serial-output queue (see 'SerialOutQueue.h').
+//
+// 10/16/2026 -- [ET]
+//
+
+#include <Arduino.h>
+#include <util/crc16.h>
+#include "Config.h"
+#include "BinFrames.h"
+#include "SerialOutQueue.h"
+
+boolean binFramesEnabledFlag = false;  //true if binary frames enabled
+uint8_t binFrameSeqNum = 0;            //sequence # for next frame
+uint8_t binFrameCrcVal = 0;            //CRC of frame being sent
+uint8_t binFramePointsArr[BINFRAME_POINTS_MAXCOUNT*3];  //buffered points
+uint8_t binFramePointsCount = 0;       //# of points in buffer
+
+//Sends a byte and adds it to the CRC of the frame being sent.
+inline void binFrameSendCrcByte(uint8_t val)
+{
+  outQueueAddByte(val);
+  binFrameCrcVal = _crc8_ccitt_update(binFrameCrcVal,val);
+}
+
+//Begins sending a frame.  Exactly 'payloadLen' bytes must then be
+// added (via 'binFrameAddByte()' or 'binFrameAddWord()'), followed by
+// a call to 'binFrameEnd()'.
+// typeVal:  frame type (BINFRAME_TYPE_...).
+// payloadLen:  number of payload bytes.
+void binFrameBegin(uint8_t typeVal, uint8_t payloadLen)
+{
+  outQueueAddByte((uint8_t)BINFRAME_SYNC_BYTE);
+  binFrameCrcVal = 0;
+  binFrameSendCrcByte(typeVal);
+  binFrameSendCrcByte(binFrameSeqNum++);
+  binFrameSendCrcByte(payloadLen);
+}
+
+//Adds a payload byte to the frame being sent.
+void binFrameAddByte(uint8_t val)
+{
+  binFrameSendCrcByte(val);
+}
+
+//Adds a payload word (LSB first) to the frame being sent.
+void binFrameAddWord(uint16_t val)
+{
+  binFrameSendCrcByte((uint8_t)val);
+  binFrameSendCrcByte((uint8_t)(val >> 8));
+}
+
+//Ends the frame being sent (sends the CRC).
+void binFrameEnd()
+{
+  outQueueAddByte(binFrameCrcVal);
+}
+
+//Sends a frame with no payload.
+// typeVal:  frame type (BINFRAME_TYPE_...).
+void binFrameSendEmpty(uint8_t typeVal)
+{
+  binFrameBegin(typeVal,0);
+  binFrameEnd();
+}
+
+//Adds a frequency/RSSI point to the buffer for the next points frame.
+// The frame is sent when the buffer is full.
+// freqVal:  frequency in MHz.
+// rssiVal:  RSSI value.
+void binFrameAddPoint(uint16_t freqVal, uint8_t rssiVal)
+{
+  uint8_t *ptr = &binFramePointsArr[binFramePointsCount*3];
+  *ptr++ = (uint8_t)freqVal;
+  *ptr++ = (uint8_t)(freqVal >> 8);
+  *ptr = rssiVal;
+  if(++binFramePointsCount >= BINFRAME_POINTS_MAXCOUNT)
+    binFrameFlushPoints();
+}
+
+//Sends a points frame for any buffered frequency/RSSI points.
+void binFrameFlushPoints()
+{
+  if(binFramePointsCount == 0)
+    return;
+  const uint8_t len = binFramePointsCount * 3;
+  binFrameBegin(BINFRAME_TYPE_SCANPOINTS,len);
+  for(uint8_t i=0; i<len; ++i)
+    binFrameAddByte(binFramePointsArr[i]);
+  binFrameEnd();
+  binFramePointsCount = 0;
+}
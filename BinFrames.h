@@ -0,0 +1,39 @@
+//BinFrames.h:  Header file for binary-framed serial output.
+//
+// 10/16/2026 -- [ET]
+//
+
+#ifndef BINFRAMES_H_
+#define BINFRAMES_H_
+
+    //frame layout:  sync, type, seq, len, payload[len], CRC-8
+    // (CRC-8 poly 0x07, init 0, over type, seq, len and payload;
+    //  multi-byte payload values are sent LSB first):
+#define BINFRAME_SYNC_BYTE 0xA5
+#define BINFRAME_TYPE_SCANREPORT 0x01  //'S','F':  flags, then (idx,rssi) pairs
+#define BINFRAME_TYPE_SCANPOINTS 0x02  //'XF':  (freqLo,freqHi,rssi) triples
+#define BINFRAME_TYPE_SCANDONE 0x03    //'XF' finished (no payload)
+#define BINFRAME_TYPE_RSSI 0x04        //'R','O','XR':  freqLo,freqHi,rssi,flags
+#define BINFRAME_TYPE_RSSILIST 0x05    //'RL','OL':  RSSI for each 'L' freq
+#define BINFRAME_TYPE_SWEEPFREQS 0x06  //'XS' start:  freq words in sweep order
+#define BINFRAME_TYPE_SWEEP 0x07       //'XS':  sweep#, time (ms), RSSI values
+#define BINFRAME_TYPE_RSSITIMED 0x08   //'O rate':  sample#, time (ms), then
+                                       // freqLo,freqHi,rssi,flags
+#define BINFRAME_TYPE_RSSILISTTIMED 0x09  //'OL rate':  sample#, time (ms),
+                                          // then RSSI for each 'L' freq
+
+#define BINFRAME_SCANRPT_LISTFLAG 0x01 //report flag:  indices for 'L' list
+#define BINFRAME_RSSI_MONITORFLAG 0x01 //RSSI flag:  monitor mode active
+#define BINFRAME_POINTS_MAXCOUNT 8     //max # of points per points frame
+
+void binFrameBegin(uint8_t typeVal, uint8_t payloadLen);
+void binFrameAddByte(uint8_t val);
+void binFrameAddWord(uint16_t val);
+void binFrameEnd();
+void binFrameSendEmpty(uint8_t typeVal);
+void binFrameAddPoint(uint16_t freqVal, uint8_t rssiVal);
+void binFrameFlushPoints();
+
+extern boolean binFramesEnabledFlag;
+
+#endif /* BINFRAMES_H_ */
@@ -9,22 +9,72 @@
 #define DISP7SEG_ENABLED_FLAG true     //true to enable 7-segment displays
 #define BUTTONS_ENABLED_FLAG true      //true to enable button inputs
 #define USE_LBAND_FLAG true            //true to scan for 'L'-band frequencies
+#define RX5808_DIRECTPORT_FLAG true    //true for direct-port RX5808 writes
+#define DISP7SEG_DIRECTPORT_FLAG true  //true for direct-port display writes
+              //true to send RX5808 frames via the hardware-SPI peripheral
+              // and its interrupt, so the CPU is not held during a frame
+              // (needs RX5808 rewired to D11/D13, and 7-segment displays
+              // disabled because D13 is also the display DP line):
+#define RX5808_HWSPI_FLAG false
 
 #define DEFAULT_FREQ_MHZ 5800          //default freq if none saved in EEPROM
 #define SERIAL_BAUDRATE 115200         //serial-port baud rate
 
 #define DEF_MONITOR_INTERVAL_SECS 5    //default time for 'M' commend
 #define BUTTON_REPEATINTERVAL_MS 25    //speed of up/down-MHz via held buttons
-              //for commands with rescans ('N','P','M'), always rescan
-              // if this much time has elapsed since last scan:
+              //for commands with rescans ('N','P','M'), rescan spectrum-
+              // model entries that are this old (max 254 seconds):
 #define NEXT_CHAN_RESCANSECS 120L
+              //if only one channel found, rescan entries this old:
+#define NEXT_CHAN_SINGLE_RESCANSECS 10
 
 #define DEF_MIN_RSSI_LEVEL 30          //min RSSI for "active" channel
+              //max # of user-defined bands (via 'XE' command, stored
+              // in EEPROM); 0 to disable:
+#define CUSTOM_BANDS_MAXCOUNT 2
               //minimum spacing when squelching adjacent channels
               // for 'S','N','P','M' commands (but not 'F' command):
 #define ADJ_CHAN_MHZ 30
 
 #define RSSI_SAMPAVG_COUNT 50          //averaging size for RSSI out
+              //true to sample RSSI input via free-running ADC interrupt
+              // (one sample per 104us into ring buffer; see RssiSampler):
+#define RSSI_ADCSAMPLER_FLAG true
+              //true to queue serial output in a ring buffer that is moved
+              // to the serial port as space becomes available, so scans
+              // and streaming output are not held up by the serial port
+              // (see SerialOutQueue):
+#define SERIAL_OUTQUEUE_FLAG true
+              //true to record every tune and final RSSI value (per scanned
+              // channel or shown reading) into a RAM ring buffer (3 bytes
+              // per entry) that may be shown via the 'XV' command (see
+              // RssiRecorder); the default size holds a full sweep of 48
+              // channels (300 bytes of RAM):
+#define RSSI_RECORDER_FLAG false
+#define RSSI_RECORDER_SIZE 100         //# of entries in recorder
+              //true to measure the time taken by tune writes, RSSI waits
+              // and reads, sorts, report output and commands (shown via
+              // the 'XQ' command; see TimeStats):
+#define TIMESTATS_ENABLED_FLAG false
+              //true to keep histograms of 'loop()' pass times, display-
+              // and input-ISR execution times and display-ISR jitter
+              // (shown via the "XQ H" command; see LatencyHist); uses 128
+              // bytes of RAM and adds 'micros()' calls to the ISRs:
+#define LATENCYHIST_ENABLED_FLAG false
+              //true to run the display multiplexing, RSSI-output sampling
+              // and (if not via D2/D3 interrupts) button sampling as
+              // fixed-phase tasks on a 1ms Timer1 tick, on all boards
+              // (see TickSched); false for Timer1 used only by display:
+#define TICKSCHED_ENABLED_FLAG true
+
+              //adaptive detection of RSSI settling after a channel change
+              // (the RX5808 min-tune time ('XT') is used as the maximum):
+#define RSSI_SETTLE_DETECT_FLAG true   //true to enable settle detection
+#define RSSI_SETTLE_MINTIME_MS 10      //min time before first RSSI check
+#define RSSI_SETTLE_INTERVAL_MS 2      //time between RSSI checks
+#define RSSI_SETTLE_SAMPLES 4          //number of samples per RSSI check
+#define RSSI_SETTLE_TOLERANCE 3        //max raw-RSSI diff from reference
+#define RSSI_SETTLE_MATCHCOUNT 3       //# of matches needed after reference
 
 #define DEF_RAWRSSI_MIN 180            //min-raw-RSSI value for scaling
 #define DEF_RAWRSSI_MAX 200            //max-raw-RSSI value for scaling
@@ -33,7 +83,11 @@
 #define CHK_RAWRSSI_MAX 1000           //maximum raw-RSSI check value
 
               //output pin for activity-indicator LED if no 7-segment display:
+#if RX5808_HWSPI_FLAG
+#define NODISP_ACTIVITY_PIN ((unsigned char)12)       //12 == D12
+#else
 #define NODISP_ACTIVITY_PIN ((unsigned char)13)       //13 == D13
+#endif
 
               //hardware I/O mapping:
 #define RSSI_PRI_PIN A7                //RSSI input from RX5808 (primary)
@@ -42,9 +96,15 @@
 #define DOWN_BUTTON_PIN 3              //DOWN button
 #define RSSI_OUT_PIN 4                 //analog RSSI output (PWM)
 #define EXTRA_OUT_PIN 5                //extra output (maybe addressable LEDs)
+#if RX5808_HWSPI_FLAG
+#define RX5808_DATA_PIN 11             //DATA output line (SPI MOSI)
+#define RX5808_SEL_PIN 10              //SEL output line (SPI SS)
+#define RX5808_CLK_PIN 13              //CLK output line (SPI SCK)
+#else
 #define RX5808_DATA_PIN 10             //DATA output line to RX5808 module
-#define RX5808_SEL_PIN 11              //CLK output line to RX5808 module
-#define RX5808_CLK_PIN 12              //SEL output line to RX5808 module
+#define RX5808_SEL_PIN 11              //SEL output line to RX5808 module
+#define RX5808_CLK_PIN 12              //CLK output line to RX5808 module
+#endif
 
               //unused inputs to set to INPUT_PULLUP (can be commented out):
 #define PULLUP_1_PIN A5                //pin to set to INPUT_PULLUP
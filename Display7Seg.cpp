@@ -7,6 +7,9 @@
 #include "TimerOne.h"
 #include "Config.h"
 #include "Display7Seg.h"
+#include "ArduVidUtil.h"
+#include "LatencyHist.h"
+#include "TickSched.h"
 
 #if DISP7SEG_ENABLED_FLAG
 
@@ -16,52 +19,144 @@
 #define DISP7SEG_BITMSKARR_MINVAL 32        //min displayable ASCII value
 #define DISP7SEG_BITMSKARR_MAXVAL 127       //max displayable ASCII value
 #define DISP7SEG_BITMSKARR_LEN (DISP7SEG_BITMSKARR_MAXVAL-DISP7SEG_BITMSKARR_MINVAL+1)
-#define DISP7SEG_DISPWORDSARR_SIZE 30       //size for 'disp7SegDisplayWordsArr'
+#define DISP7SEG_DISPWORDSARR_SIZE 30       //max # of display-array entries
+#define DISP7SEG_DISPWORDS_NUMRUNS 3        //# of words in display array
+#define DISP7SEG_NUMSCHEDBUFFS 3            //# of display-schedule buffers
 #define DISP7SEG_DISPWORDSINTVL_MS 100      //interval btw displayed bitmasks
-
-    //array to convert ASCII codes to 7-segment-bitmask values:
-byte disp7SegAsciiToBitmaskArr[DISP7SEG_BITMSKARR_LEN];
+    //converts a time in ms to a number of interrupt-routine ticks:
+#define DISP7SEG_MS_TO_TICKS(ms) \
+        ((uint16_t)(((ms)+DISP7SEG_ISRINTERVAL_MS-1)/DISP7SEG_ISRINTERVAL_MS))
+    //returns true if the given tick count has been reached:
+#define DISP7SEG_TICK_REACHED(tickVal) \
+                        ((int16_t)(disp7SegTickCount - (tickVal)) >= 0)
+
+#if DISP7SEG_DIRECTPORT_FLAG && DIRECTPIN_SUPPORTED_FLAG
+#define DISP7SEG_USE_DIRECTPORT true
+    //port index for pin (0=PORTD, 1=PORTB, 2=PORTC; same as
+    // 'DIRECTPIN_PORTREG()'):
+#define DISP7SEG_PORTIDX(pin) (((pin) < 8) ? 0 : (((pin) < 14) ? 1 : 2))
+#define DISP7SEG_PINMASK_IF(pin,idx) \
+             ((DISP7SEG_PORTIDX(pin) == (idx)) ? DIRECTPIN_BITMASK(pin) : 0)
+    //mask of display-segment bits on the given port:
+#define DISP7SEG_SEGMASK(idx) ((uint8_t)(DISP7SEG_PINMASK_IF(DISP7SEG_A_PIN,idx) | \
+        DISP7SEG_PINMASK_IF(DISP7SEG_B_PIN,idx) | \
+        DISP7SEG_PINMASK_IF(DISP7SEG_C_PIN,idx) | \
+        DISP7SEG_PINMASK_IF(DISP7SEG_D_PIN,idx) | \
+        DISP7SEG_PINMASK_IF(DISP7SEG_E_PIN,idx) | \
+        DISP7SEG_PINMASK_IF(DISP7SEG_F_PIN,idx) | \
+        DISP7SEG_PINMASK_IF(DISP7SEG_G_PIN,idx) | \
+        DISP7SEG_PINMASK_IF(DISP7SEG_DP_PIN,idx)))
+#else
+#define DISP7SEG_USE_DIRECTPORT false
+#endif
+
+#if TICKSCHED_ENABLED_FLAG && \
+     (TICKSCHED_PERIOD_DISPLAY*TICKSCHED_TICK_US != DISP7SEG_ISRINTERVAL_MS*1000)
+#error TICKSCHED_PERIOD_DISPLAY does not match DISP7SEG_ISRINTERVAL_MS
+#endif
+
+    //array to convert ASCII codes (from DISP7SEG_BITMSKARR_MINVAL to
+    // DISP7SEG_BITMSKARR_MAXVAL) to 7-segment-bitmask values (held in
+    // program memory, to save RAM):
+#define DISP7SEG_BU DISP7SEG_BITMSK_UNDEF   //short names for table below
+#define DISP7SEG_BDP DISP7SEG_BITMSK_DP
+const byte disp7SegAsciiToBitmaskPArr[DISP7SEG_BITMSKARR_LEN] PROGMEM = {
+  0b00000000,  DISP7SEG_BU, 0b00100010,  DISP7SEG_BU,   //' ' ! " #
+  DISP7SEG_BU, DISP7SEG_BU, DISP7SEG_BU, 0b00000010,    //$ % & '
+  DISP7SEG_BU, DISP7SEG_BU, DISP7SEG_BU, DISP7SEG_BU,   //( ) * +
+  DISP7SEG_BU, 0b01000000,  DISP7SEG_BDP, 0b01010010,   //, - . /
+  0b00111111,  0b00000110,  0b01011011,  0b01001111,    //0 1 2 3
+  0b01100110,  0b01101101,  0b01111101,  0b00000111,    //4 5 6 7
+  0b01111111,  0b01101111,  DISP7SEG_BU, DISP7SEG_BU,   //8 9 : ;
+  DISP7SEG_BU, 0b01001000,  DISP7SEG_BU, DISP7SEG_BU,   //< = > ?
+  DISP7SEG_BU, 0b01110111,  0b01111100,  0b00111001,    //@ A B C
+  0b01011110,  0b01111001,  0b01110001,  DISP7SEG_BU,   //D E F G
+  0b01110110,  0b00000110,  0b00001110,  DISP7SEG_BU,   //H I J K
+  0b00111000,  DISP7SEG_BU, 0b01010100,  0b00111111,    //L M N O
+  0b01110011,  DISP7SEG_BU, 0b01010000,  DISP7SEG_BU,   //P Q R S
+  0b01111000,  0b00111110,  DISP7SEG_BU, DISP7SEG_BU,   //T U V W
+  DISP7SEG_BU, 0b01101110,  DISP7SEG_BU, 0b00111001,    //X Y Z [
+  0b01100100,  0b00001111,  DISP7SEG_BU, 0b00001000,    //\ ] ^ _
+  0b00100000,  0b01011111,  0b01111100,  0b01011000,    //` a b c
+  0b01011110,  0b01111001,  0b01110001,  DISP7SEG_BU,   //d e f g
+  0b01110100,  0b00000100,  0b00001100,  DISP7SEG_BU,   //h i j k
+  0b00111000,  DISP7SEG_BU, 0b01010100,  0b01011100,    //l m n o
+  0b01110011,  DISP7SEG_BU, 0b01010000,  DISP7SEG_BU,   //p q r s
+  0b01111000,  0b00011100,  DISP7SEG_BU, DISP7SEG_BU,   //t u v w
+  DISP7SEG_BU, 0b01101110,  DISP7SEG_BU, DISP7SEG_BU,   //x y z {
+  0b00110000,  DISP7SEG_BU, DISP7SEG_BU, DISP7SEG_BU    //| } ~ DEL
+};
+#undef DISP7SEG_BU
+#undef DISP7SEG_BDP
+
+    //display schedule; filled in by the main code and then published to
+    // the interrupt routine (which only reads it):
+struct Disp7SegSchedule
+{
+  uint32_t initDispBitmaskUint32;      //initial-display values (2 words)
+  uint16_t initDispDurationTicks;      //display time for each init value
+  uint16_t ovrDispBitmaskWord;         //override-display value
+  uint16_t ovrDispDurationTicks;       //override time (0=indefinite)
+  uint16_t dispWordsArr[DISP7SEG_DISPWORDS_NUMRUNS];  //display-array words
+  uint8_t dispWordsCountArr[DISP7SEG_DISPWORDS_NUMRUNS];  //# of instances
+  uint8_t dispWordsNumEntries;         //total # of display-array entries
+  uint8_t dispWordsStartIdx;           //display-array index to restart at
+  uint8_t initDispSeqNum;              //incremented when init values set
+  uint8_t ovrDispSeqNum;               //incremented when override set
+  uint8_t dispWordsSeqNum;             //incremented when array restarted
+};
+
+    //display-schedule buffers; the main code fills in a buffer that is
+    // neither published nor in use by the interrupt routine and then
+    // publishes it via a single-byte index write, so the routine never
+    // sees a partial update (three buffers so the main code never needs
+    // to wait for the routine to take up a previously-published one):
+Disp7SegSchedule disp7SegSchedArr[DISP7SEG_NUMSCHEDBUFFS];
+volatile uint8_t disp7SegSchedPublishedIdx = 0;  //set by main code
+volatile uint8_t disp7SegSchedActiveIdx = 0;     //set by interrupt routine
+uint8_t disp7SegSchedBuildIdx = 0;               //buffer being filled in
 
 volatile byte disp7SegLeftMaskOut = (byte)0;     //left display bitmask
 volatile byte disp7SegRightMaskOut = (byte)0;    //right display bitmask
 volatile boolean disp7SegLeftActiveFlag = false;      //toggle L/R
-boolean disp7SegDataUpdatingFlag = false;        //flag for thread safe
-
-    //value, duration and end-time for initial-display values:
-volatile uint32_t disp7SegInitDispBitmaskUint32 = 0;
-volatile boolean disp7SegInitDispBitmaskFlag = false;
-volatile int disp7SegInitDispDurationMs = 0;
-volatile unsigned long disp7SegInitDispEndTime = 0;
-
-    //value and end-time for override-display values:
-volatile uint16_t disp7SegOvrDispBitmaskWord = 0;
-volatile int disp7SegOvrDispDurationMs = 0;
-volatile unsigned long disp7SegOvrDispEndTime = 0;
-
-    //array of left/right-bitmask words to be sent to displays:
-uint16_t disp7SegDisplayWordsArr[DISP7SEG_DISPWORDSARR_SIZE];
-int disp7SegDisplayWordsNumEntries = 0;
-volatile int disp7SegDisplayWordsCurIdx = 0;
-volatile unsigned long disp7SegDisplayWordsNextTime = 0;
-
-
-//Sets a 'disp7Seg_asciiToBitmsk[]' array entry .
-// ch:  ASCII value for entry.
-// mskVal:  7-segment-bitmask value for entry.
-void setAsciiToBitmskEntry(char ch, byte mskVal)
-{
-  if(ch >= (char)DISP7SEG_BITMSKARR_MINVAL && ch <= DISP7SEG_BITMSKARR_MAXVAL)
-  {  //ASCII value is in range
-    disp7SegAsciiToBitmaskArr[ch-(char)DISP7SEG_BITMSKARR_MINVAL] = mskVal;
-  }
-}
+#if DISP7SEG_USE_DIRECTPORT
+    //segment-output values for PORTD/PORTB/PORTC, for left and right
+    // displays (built from the bitmasks when they change):
+uint8_t disp7SegPortFrameArr[2][3];
+#endif
+
+    //interrupt-routine tick count, and tick for next evaluation of
+    // display content (content is only evaluated when it has changed
+    // or a timed value has expired):
+volatile uint16_t disp7SegTickCount = 0;
+uint16_t disp7SegNextEvalTick = 0;
+boolean disp7SegTimedEvalFlag = false;           //true if next-eval tick set
+boolean disp7SegEvalNeededFlag = false;          //true if content changed
+
+    //interrupt-routine state for showing schedule values (the sequence
+    // numbers of the values being shown, and their progress):
+uint8_t disp7SegInitDispSeqNum = 0;
+uint8_t disp7SegOvrDispSeqNum = 0;
+uint8_t disp7SegDispWordsSeqNum = 0;
+uint32_t disp7SegInitDispBitmaskUint32 = 0;      //remaining init values
+boolean disp7SegInitDispBitmaskFlag = false;     //true while init shown
+boolean disp7SegInitDispStartedFlag = false;
+uint16_t disp7SegInitDispEndTick = 0;
+boolean disp7SegOvrDispActiveFlag = false;       //true while override shown
+boolean disp7SegOvrDispStartedFlag = false;
+uint16_t disp7SegOvrDispEndTick = 0;
+volatile uint8_t disp7SegDisplayWordsCurIdx = 0; //next display-array entry
+boolean disp7SegDisplayWordsStartedFlag = false;
+uint16_t disp7SegDisplayWordsNextTick = 0;
+
 
 //Returns bitmask for given ASCII code.
 byte disp7SegAsciiToBitmask(char ch)
 {
   return (ch >= (char)DISP7SEG_BITMSKARR_MINVAL &&
                                           ch <= DISP7SEG_BITMSKARR_MAXVAL) ?
-             disp7SegAsciiToBitmaskArr[ch-(char)DISP7SEG_BITMSKARR_MINVAL] :
+    pgm_read_byte_near(disp7SegAsciiToBitmaskPArr +
+                                  (ch-(char)DISP7SEG_BITMSKARR_MINVAL)) :
                                                       DISP7SEG_BITMSK_UNDEF;
 }
 
@@ -82,6 +177,32 @@ uint16_t disp7SegConvAsciiCharsToWord(char leftCh, boolean leftDpFlag,
   return (((uint16_t)leftMask)<<(uint16_t)8) | rightMask;
 }
 
+//Sets up a display-schedule buffer to be filled in by the main code.  The
+// buffer is one that is neither published nor in use by the interrupt
+// routine (which may only switch to the published one), and it is
+// initialized with the values in the published schedule.
+// Returns:  A pointer to the display-schedule buffer.
+Disp7SegSchedule *disp7SegBeginScheduleUpdate()
+{
+  const uint8_t pubIdx = disp7SegSchedPublishedIdx;
+  const uint8_t actIdx = disp7SegSchedActiveIdx;
+  uint8_t idx = 0;
+  while(idx == pubIdx || idx == actIdx)
+    ++idx;
+  disp7SegSchedBuildIdx = idx;
+  disp7SegSchedArr[idx] = disp7SegSchedArr[pubIdx];
+  return &disp7SegSchedArr[idx];
+}
+
+//Publishes the display schedule set up via 'disp7SegBeginScheduleUpdate()'
+// to the interrupt routine.
+void disp7SegPublishSchedule()
+{
+         //make sure buffer contents are written before index:
+  __asm__ __volatile__ ("" ::: "memory");
+  disp7SegSchedPublishedIdx = disp7SegSchedBuildIdx;
+}
+
 //Sets the displays to the given initial values; overrides values displayed
 // via 'disp7SegEnterToDisplayWordsArr()' or 'disp7SegSetOvrAsciiValues()'.
 // The leftCh1/rightCh1 values are shown first, the leftCh2/rightCh2 values
@@ -97,19 +218,18 @@ void disp7SegSetInitAsciiValues(char leftCh1, boolean leftDpFlag1,
                                         char rightCh2, boolean rightDpFlag2,
                                                              int dispTimeMs)
 {
-  disp7SegDataUpdatingFlag = true;     //indicate data update in progress
-  disp7SegInitDispDurationMs = dispTimeMs;        //save duration time
-  disp7SegInitDispEndTime = 0;                    //clear time for now
+  Disp7SegSchedule *schedPtr = disp7SegBeginScheduleUpdate();
+                                       //save duration time:
+  schedPtr->initDispDurationTicks = DISP7SEG_MS_TO_TICKS(dispTimeMs);
          //setup initial bitmask values (2 words):
-  disp7SegInitDispBitmaskUint32 = (((uint32_t)disp7SegConvAsciiCharsToWord(
+  schedPtr->initDispBitmaskUint32 = (((uint32_t)disp7SegConvAsciiCharsToWord(
                         leftCh2,leftDpFlag2,rightCh2,rightDpFlag2)) << 16) |
                            disp7SegConvAsciiCharsToWord(leftCh1,leftDpFlag1,
                                                      rightCh1,rightDpFlag1);
-                                       //indicate bitmask setup:
-  disp7SegInitDispBitmaskFlag = (disp7SegInitDispBitmaskUint32 != 0);
-  disp7SegDisplayWordsCurIdx = 0;      //make sure start at initial index
-  disp7SegDisplayWordsNextTime = 0;    //initialize next-entry time
-  disp7SegDataUpdatingFlag = false;    //indicate data update completed
+  ++schedPtr->initDispSeqNum;          //restart initial display
+  schedPtr->dispWordsStartIdx = 0;     //make sure start at initial index
+  ++schedPtr->dispWordsSeqNum;
+  disp7SegPublishSchedule();
 }
 
 //Sets the displays to the given values; overrides values displayed via
@@ -122,15 +242,16 @@ void disp7SegSetInitAsciiValues(char leftCh1, boolean leftDpFlag1,
 void disp7SegSetOvrAsciiValues(char leftCh, boolean leftDpFlag, char rightCh,
                                         boolean rightDpFlag, int dispTimeMs)
 {
-  disp7SegDataUpdatingFlag = true;     //indicate data update in progress
-  disp7SegOvrDispDurationMs = dispTimeMs;        //save duration time
-  disp7SegOvrDispEndTime = 0;                    //clear time for now
+  Disp7SegSchedule *schedPtr = disp7SegBeginScheduleUpdate();
+                                       //save duration time:
+  schedPtr->ovrDispDurationTicks = DISP7SEG_MS_TO_TICKS(dispTimeMs);
          //setup override bitmask values:
-  disp7SegOvrDispBitmaskWord = disp7SegConvAsciiCharsToWord(
+  schedPtr->ovrDispBitmaskWord = disp7SegConvAsciiCharsToWord(
                                      leftCh,leftDpFlag,rightCh,rightDpFlag);
-  disp7SegDisplayWordsCurIdx = 0;      //reset so will resume at start
-  disp7SegDisplayWordsNextTime = 0;    //initialize next-entry time
-  disp7SegDataUpdatingFlag = false;    //indicate data update completed
+  ++schedPtr->ovrDispSeqNum;           //restart override display
+  schedPtr->dispWordsStartIdx = 0;     //reset so will resume at start
+  ++schedPtr->dispWordsSeqNum;
+  disp7SegPublishSchedule();
 }
 
 //Sets the displays to the given values; overrides values displayed via
@@ -157,244 +278,287 @@ void disp7SegClearOvrDisplay()
   disp7SegSetOvrAsciiValues(' ',false,' ',false,0);
 }
 
-//Enters instances of the given bitmask-words into the
-// 'disp7SegDisplayWordsArr[]' array.  Each 'count' value
-// specifies the number of instances for the 'word' value.
+//Enters the given bitmask-words into the display array.  Each 'count'
+// value specifies the number of instances (100ms each) for the 'word'
+// value.
 void disp7SegEnterToDisplayWordsArr(uint16_t word1, int count1,
                      uint16_t word2, int count2, uint16_t word3, int count3)
 {
-  int c, firstIdx = 0, arrIdx = 0;
-  disp7SegDataUpdatingFlag = true;     //indicate data update in progress
-  c = 0;
-  while(++c <= count1)
-  {  //for each instance of the bitmask-word to be entered
-    if(arrIdx >= DISP7SEG_DISPWORDSARR_SIZE)
-      break;      //if beyond array size then exit loop
-              //enter an instance of the bitmask-word:
-    disp7SegDisplayWordsArr[arrIdx++] = word1;
-  }
-         //if first bitmask-word blank and is initial display then
-         // setup to show second one first (don't start with blank):
-  if(word1 == (uint16_t)0 && disp7SegDisplayWordsCurIdx == 0)
-    firstIdx = arrIdx;
-  c = 0;
-  while(++c <= count2)
-  {  //for each instance of the bitmask-word to be entered
-    if(arrIdx >= DISP7SEG_DISPWORDSARR_SIZE)
-      break;      //if beyond array size then exit loop
-              //enter an instance of the bitmask-word:
-    disp7SegDisplayWordsArr[arrIdx++] = word2;
-  }
-         //if first bitmask-word blank and not initial display then
-         // setup to show last one first (track fast frequency changes):
-  if(word1 == (uint16_t)0 && disp7SegDisplayWordsCurIdx > 0)
-    firstIdx = arrIdx;            //setup to show last one first
-  c = 0;
-  while(++c <= count3)
-  {  //for each instance of the bitmask-word to be entered
-    if(arrIdx >= DISP7SEG_DISPWORDSARR_SIZE)
-      break;      //if beyond array size then exit loop
-              //enter an instance of the bitmask-word:
-    disp7SegDisplayWordsArr[arrIdx++] = word3;
+  const uint16_t wordsArr[DISP7SEG_DISPWORDS_NUMRUNS] = { word1,word2,word3 };
+  const int countsArr[DISP7SEG_DISPWORDS_NUMRUNS] = { count1,count2,count3 };
+  int firstIdx = 0, arrIdx = 0;
+         //determine if display array is at its initial index (in the
+         // last-published schedule if not yet taken up by the ISR):
+  const uint8_t pubIdx = disp7SegSchedPublishedIdx;
+  const boolean atInitialFlag = (disp7SegSchedActiveIdx == pubIdx) ?
+                                       (disp7SegDisplayWordsCurIdx == 0) :
+                        (disp7SegSchedArr[pubIdx].dispWordsStartIdx == 0);
+  Disp7SegSchedule *schedPtr = disp7SegBeginScheduleUpdate();
+  for(uint8_t i=0; i<DISP7SEG_DISPWORDS_NUMRUNS; ++i)
+  {  //for each bitmask-word; enter its instances (within array size)
+    int c = countsArr[i];
+    if(c < 0)
+      c = 0;
+    if(c > DISP7SEG_DISPWORDSARR_SIZE - arrIdx)
+      c = DISP7SEG_DISPWORDSARR_SIZE - arrIdx;
+    schedPtr->dispWordsArr[i] = wordsArr[i];
+    schedPtr->dispWordsCountArr[i] = (uint8_t)c;
+    arrIdx += c;
+              //if first bitmask-word blank and is initial display then
+              // setup to show second one first (don't start with blank);
+              // if not initial display then setup to show last one first
+              // (track fast frequency changes):
+    if(word1 == (uint16_t)0 && ((i == 0 && atInitialFlag) ||
+                                                 (i == 1 && !atInitialFlag)))
+    {
+      firstIdx = arrIdx;
+    }
   }
-  disp7SegDisplayWordsNumEntries = arrIdx;  //set # of bitmask-words entered
+  schedPtr->dispWordsNumEntries = (uint8_t)arrIdx;  //set # of entries
          //reset start index (skip first bitmask-word if blank and next OK):
-  disp7SegDisplayWordsCurIdx = (firstIdx < arrIdx) ? firstIdx : 0;
-  disp7SegDisplayWordsNextTime = 0;         //initialize next-entry time
-  disp7SegDataUpdatingFlag = false;         //indicate data update completed
+  schedPtr->dispWordsStartIdx = (uint8_t)((firstIdx < arrIdx) ? firstIdx : 0);
+  ++schedPtr->dispWordsSeqNum;
+  disp7SegPublishSchedule();
 }
 
-//ISR Timer Routine for updating displays.
-void disp7SegTimerIsr()
+//Sets the left/right bitmasks to be sent to the displays and (if
+// direct-port output) builds the port values for them.  Called from the
+// interrupt routine (or before it is started).
+// dispWord:  left-display bitmask in upper byte, right in lower byte.
+void disp7SegSetOutputMasks(uint16_t dispWord)
 {
-         //toggle left/right display active:
-  disp7SegLeftActiveFlag = !disp7SegLeftActiveFlag;
-  if(!disp7SegDataUpdatingFlag)
-  {  //data update is not currently in progress
-    const unsigned long curTimeMs = millis();
-    if(disp7SegInitDispBitmaskFlag)
-    {  //initial display values should be shown
-      if(disp7SegInitDispDurationMs > 0)
-      {  //duration not zero
-        if(curTimeMs >= disp7SegInitDispEndTime)
-        {  //duration end-time reached (or first time through)
-          if(disp7SegInitDispEndTime > 0)
-          {  //not first time through; shift to next word
-            disp7SegInitDispBitmaskUint32 >>= 16;
-          }
-          if(disp7SegInitDispBitmaskUint32 != 0)
-          {  //initial-display values (still) available
-            const uint16_t dispWord = (uint16_t)disp7SegInitDispBitmaskUint32;
-                  //set output bitmasks to initial values:
-            disp7SegLeftMaskOut = (byte)(dispWord >> (uint16_t)8);
-            disp7SegRightMaskOut = (byte)dispWord;
-                  //set end time for display of values:
-            disp7SegInitDispEndTime = millis() + disp7SegInitDispDurationMs;
-          }
-          else  //no more initial-display values
-            disp7SegInitDispBitmaskFlag = false;
-        }
+  disp7SegLeftMaskOut = (byte)(dispWord >> (uint16_t)8);
+  disp7SegRightMaskOut = (byte)dispWord;
+#if DISP7SEG_USE_DIRECTPORT
+  for(uint8_t i=0; i<2; ++i)
+  {  //for left and right displays
+    const byte dispMsk = (byte)((i == 0) ? (dispWord >> (uint16_t)8) :
+                                                                dispWord);
+    uint8_t *framePtr = disp7SegPortFrameArr[i];
+    framePtr[0] = framePtr[1] = framePtr[2] = (uint8_t)0;
+              //segment outputs are active low; set bits for unlit segments:
+    if(!(dispMsk & (byte)0b00000001))
+      framePtr[DISP7SEG_PORTIDX(DISP7SEG_A_PIN)] |= DIRECTPIN_BITMASK(DISP7SEG_A_PIN);
+    if(!(dispMsk & (byte)0b00000010))
+      framePtr[DISP7SEG_PORTIDX(DISP7SEG_B_PIN)] |= DIRECTPIN_BITMASK(DISP7SEG_B_PIN);
+    if(!(dispMsk & (byte)0b00000100))
+      framePtr[DISP7SEG_PORTIDX(DISP7SEG_C_PIN)] |= DIRECTPIN_BITMASK(DISP7SEG_C_PIN);
+    if(!(dispMsk & (byte)0b00001000))
+      framePtr[DISP7SEG_PORTIDX(DISP7SEG_D_PIN)] |= DIRECTPIN_BITMASK(DISP7SEG_D_PIN);
+    if(!(dispMsk & (byte)0b00010000))
+      framePtr[DISP7SEG_PORTIDX(DISP7SEG_E_PIN)] |= DIRECTPIN_BITMASK(DISP7SEG_E_PIN);
+    if(!(dispMsk & (byte)0b00100000))
+      framePtr[DISP7SEG_PORTIDX(DISP7SEG_F_PIN)] |= DIRECTPIN_BITMASK(DISP7SEG_F_PIN);
+    if(!(dispMsk & (byte)0b01000000))
+      framePtr[DISP7SEG_PORTIDX(DISP7SEG_G_PIN)] |= DIRECTPIN_BITMASK(DISP7SEG_G_PIN);
+    if(!(dispMsk & (byte)0b10000000))
+      framePtr[DISP7SEG_PORTIDX(DISP7SEG_DP_PIN)] |= DIRECTPIN_BITMASK(DISP7SEG_DP_PIN);
+  }
+#endif
+}
+
+//Sets up the next tick at which the display content should be evaluated.
+void disp7SegScheduleEval(uint16_t tickVal)
+{
+  disp7SegNextEvalTick = tickVal;
+  disp7SegTimedEvalFlag = true;
+}
+
+//Evaluates the display content (the initial-display, override-display
+// and display-array values, in that order of priority), sets the output
+// bitmasks, and sets up the tick for the next evaluation (if any timed
+// value is in progress).  Called from the interrupt routine when the
+// content has changed or the next-evaluation tick has been reached.
+void disp7SegEvalDisplayContent()
+{
+  const Disp7SegSchedule *schedPtr = &disp7SegSchedArr[disp7SegSchedActiveIdx];
+  disp7SegEvalNeededFlag = false;
+  disp7SegTimedEvalFlag = false;
+  if(disp7SegInitDispBitmaskFlag)
+  {  //initial display values should be shown
+    if(schedPtr->initDispDurationTicks > 0)
+    {  //duration not zero
+      if(disp7SegInitDispStartedFlag &&
+                             !DISP7SEG_TICK_REACHED(disp7SegInitDispEndTick))
+      {  //duration end-time not yet reached
+        disp7SegScheduleEval(disp7SegInitDispEndTick);
+        return;
       }
-      else  //duration is zero; just clear flag
-        disp7SegInitDispBitmaskFlag = false;
-    }
-    else if(disp7SegOvrDispBitmaskWord != (uint16_t)0)
-    {  //display override value setup
-      if(disp7SegOvrDispDurationMs > 0)
-      {  //duration not zero for indefinite
-        if(disp7SegOvrDispEndTime == 0)
-        {  //display-override end time not yet setup; set it now
-          disp7SegOvrDispEndTime = millis() + disp7SegOvrDispDurationMs;
-                   //set output bitmask values to override values:
-          disp7SegLeftMaskOut =
-                          (byte)(disp7SegOvrDispBitmaskWord >> (uint16_t)8);
-          disp7SegRightMaskOut = (byte)disp7SegOvrDispBitmaskWord;
-        }
-        else
-        {  //non-indefinite display-override is in progress
-          if(curTimeMs >= disp7SegOvrDispEndTime)     //if end time reached
-            disp7SegOvrDispBitmaskWord = (uint16_t)0; // then clear override
-        }
+      if(disp7SegInitDispStartedFlag)
+      {  //not first time through; shift to next word
+        disp7SegInitDispBitmaskUint32 >>= 16;
       }
-      else
-      {  //indefinite duration; set output bitmask values to override values
-        disp7SegLeftMaskOut =
-                          (byte)(disp7SegOvrDispBitmaskWord >> (uint16_t)8);
-        disp7SegRightMaskOut = (byte)disp7SegOvrDispBitmaskWord;
+      if(disp7SegInitDispBitmaskUint32 != 0)
+      {  //initial-display values (still) available; show them
+        disp7SegSetOutputMasks((uint16_t)disp7SegInitDispBitmaskUint32);
+              //set end time for display of values:
+        disp7SegInitDispEndTick = disp7SegTickCount +
+                                            schedPtr->initDispDurationTicks;
+        disp7SegInitDispStartedFlag = true;
+        disp7SegScheduleEval(disp7SegInitDispEndTick);
+        return;
       }
     }
-    else if(disp7SegDisplayWordsNumEntries > 0)
-    {  //display init/override values not setup and display array not empty
-      if(curTimeMs >= disp7SegDisplayWordsNextTime)
-      {  //time reached for next entry in display array (or first)
-        const uint16_t dispWord =
-                        disp7SegDisplayWordsArr[disp7SegDisplayWordsCurIdx];
-              //set output bitmasks to values from display array:
-        disp7SegLeftMaskOut = (byte)(dispWord >> (uint16_t)8);
-        disp7SegRightMaskOut = (byte)dispWord;
+    disp7SegInitDispBitmaskFlag = false;    //no more initial-display values
+  }
+  if(disp7SegOvrDispActiveFlag)
+  {  //display override value setup
+    if(schedPtr->ovrDispDurationTicks == 0)
+    {  //indefinite duration; set output bitmask values to override values
+      disp7SegSetOutputMasks(schedPtr->ovrDispBitmaskWord);
+      return;
+    }
+    if(!disp7SegOvrDispStartedFlag)
+    {  //display-override end time not yet setup; set it now
+      disp7SegOvrDispEndTick = disp7SegTickCount +
+                                             schedPtr->ovrDispDurationTicks;
+      disp7SegOvrDispStartedFlag = true;
+               //set output bitmask values to override values:
+      disp7SegSetOutputMasks(schedPtr->ovrDispBitmaskWord);
+      disp7SegScheduleEval(disp7SegOvrDispEndTick);
+      return;
+    }
+    if(!DISP7SEG_TICK_REACHED(disp7SegOvrDispEndTick))
+    {  //non-indefinite display-override is in progress
+      disp7SegScheduleEval(disp7SegOvrDispEndTick);
+      return;
+    }
+    disp7SegOvrDispActiveFlag = false;      //end time reached; clear
+  }
+  if(schedPtr->dispWordsNumEntries > 0)
+  {  //display init/override values not setup and display array not empty
+    if(!disp7SegDisplayWordsStartedFlag ||
+                        DISP7SEG_TICK_REACHED(disp7SegDisplayWordsNextTick))
+    {  //time reached for next entry in display array (or first)
+      uint8_t curIdx = disp7SegDisplayWordsCurIdx;
+      if(curIdx >= schedPtr->dispWordsNumEntries)
+        curIdx = 0;
+              //find bitmask-word for entry and set output bitmasks to it:
+      uint8_t i = 0, idx = curIdx;
+      while(idx >= schedPtr->dispWordsCountArr[i])
+        idx -= schedPtr->dispWordsCountArr[i++];
+      disp7SegSetOutputMasks(schedPtr->dispWordsArr[i]);
               //increment display-array index, with wrap-around:
-        if(++disp7SegDisplayWordsCurIdx >= disp7SegDisplayWordsNumEntries)
-          disp7SegDisplayWordsCurIdx = 0;
+      if(++curIdx >= schedPtr->dispWordsNumEntries)
+        curIdx = 0;
+      disp7SegDisplayWordsCurIdx = curIdx;
               //setup next-entry time:
-        disp7SegDisplayWordsNextTime = curTimeMs + DISP7SEG_DISPWORDSINTVL_MS;
-      }
+      disp7SegDisplayWordsNextTick = disp7SegTickCount +
+                                DISP7SEG_MS_TO_TICKS(DISP7SEG_DISPWORDSINTVL_MS);
+      disp7SegDisplayWordsStartedFlag = true;
     }
+    disp7SegScheduleEval(disp7SegDisplayWordsNextTick);
+  }
+}
 
-    byte dispMsk;
-    if(disp7SegLeftActiveFlag)
-    {  //left display will now be active
-      digitalWrite(DISP7SEG_SELRIGHT_PIN,HIGH);  //turn off right display
-      dispMsk = disp7SegLeftMaskOut;
-    }
-    else
-    {  //right display will now be active
-      digitalWrite(DISP7SEG_SELLEFT_PIN,HIGH);   //turn off left display
-      dispMsk = disp7SegRightMaskOut;
-    }
-           //write bitmask value to display-segment outputs:
-    digitalWrite(DISP7SEG_A_PIN,
-                ((((dispMsk) & (byte)0b00000001) != (byte)0) ? LOW : HIGH));
-    digitalWrite(DISP7SEG_B_PIN,
-                ((((dispMsk) & (byte)0b00000010) != (byte)0) ? LOW : HIGH));
-    digitalWrite(DISP7SEG_C_PIN,
-                ((((dispMsk) & (byte)0b00000100) != (byte)0) ? LOW : HIGH));
-    digitalWrite(DISP7SEG_D_PIN,
-                ((((dispMsk) & (byte)0b00001000) != (byte)0) ? LOW : HIGH));
-    digitalWrite(DISP7SEG_E_PIN,
-                ((((dispMsk) & (byte)0b00010000) != (byte)0) ? LOW : HIGH));
-    digitalWrite(DISP7SEG_F_PIN,
-                ((((dispMsk) & (byte)0b00100000) != (byte)0) ? LOW : HIGH));
-    digitalWrite(DISP7SEG_G_PIN,
-                ((((dispMsk) & (byte)0b01000000) != (byte)0) ? LOW : HIGH));
-    digitalWrite(DISP7SEG_DP_PIN,
-                ((((dispMsk) & (byte)0b10000000) != (byte)0) ? LOW : HIGH));
-    if(disp7SegLeftActiveFlag)
-      digitalWrite(DISP7SEG_SELLEFT_PIN,LOW);    //turn on left display
-    else                                              // or
-      digitalWrite(DISP7SEG_SELRIGHT_PIN,LOW);   //turn on right display
+//Takes up the published display schedule, restarting the values in it
+// that have been changed.  Called from the interrupt routine when the
+// published schedule differs from the one in use.
+void disp7SegTakeUpSchedule()
+{
+  const uint8_t pubIdx = disp7SegSchedPublishedIdx;
+  const Disp7SegSchedule *schedPtr = &disp7SegSchedArr[pubIdx];
+  disp7SegSchedActiveIdx = pubIdx;
+  if(schedPtr->initDispSeqNum != disp7SegInitDispSeqNum)
+  {  //initial-display values changed
+    disp7SegInitDispSeqNum = schedPtr->initDispSeqNum;
+    disp7SegInitDispBitmaskUint32 = schedPtr->initDispBitmaskUint32;
+    disp7SegInitDispBitmaskFlag = (disp7SegInitDispBitmaskUint32 != 0);
+    disp7SegInitDispStartedFlag = false;
+  }
+  if(schedPtr->ovrDispSeqNum != disp7SegOvrDispSeqNum)
+  {  //override-display value changed
+    disp7SegOvrDispSeqNum = schedPtr->ovrDispSeqNum;
+    disp7SegOvrDispActiveFlag =
+                         (schedPtr->ovrDispBitmaskWord != (uint16_t)0);
+    disp7SegOvrDispStartedFlag = false;
+  }
+  if(schedPtr->dispWordsSeqNum != disp7SegDispWordsSeqNum)
+  {  //display array changed or restarted
+    disp7SegDispWordsSeqNum = schedPtr->dispWordsSeqNum;
+    disp7SegDisplayWordsCurIdx = schedPtr->dispWordsStartIdx;
+    disp7SegDisplayWordsStartedFlag = false;
+  }
+  disp7SegEvalNeededFlag = true;
+}
+
+//ISR Timer Routine for updating displays.  The display content is only
+// evaluated when it has changed or a timed value has expired; otherwise
+// the prebuilt output values for the active display are written.
+void disp7SegTimerIsr()
+{
+#if LATENCYHIST_ENABLED_FLAG
+  const unsigned long isrEntryUs = micros();
+  latencyHistMarkPeriodicIsr(isrEntryUs,DISP7SEG_ISRINTERVAL_MS*1000L);
+#endif
+  ++disp7SegTickCount;
+         //toggle left/right display active:
+  disp7SegLeftActiveFlag = !disp7SegLeftActiveFlag;
+  if(disp7SegSchedPublishedIdx != disp7SegSchedActiveIdx)
+    disp7SegTakeUpSchedule();          //new display schedule published
+  if(disp7SegEvalNeededFlag ||
+        (disp7SegTimedEvalFlag && DISP7SEG_TICK_REACHED(disp7SegNextEvalTick)))
+  {  //content changed or timed value due
+    disp7SegEvalDisplayContent();
+  }
+
+#if DISP7SEG_USE_DIRECTPORT
+         //turn off both displays, write segment outputs (three port
+         // writes), then turn on active display:
+  DIRECTPIN_SET_HIGH(DISP7SEG_SELLEFT_PIN);
+  DIRECTPIN_SET_HIGH(DISP7SEG_SELRIGHT_PIN);
+  const uint8_t *framePtr =
+                        disp7SegPortFrameArr[disp7SegLeftActiveFlag ? 0 : 1];
+  PORTD = (uint8_t)((PORTD & (uint8_t)~DISP7SEG_SEGMASK(0)) | framePtr[0]);
+  PORTB = (uint8_t)((PORTB & (uint8_t)~DISP7SEG_SEGMASK(1)) | framePtr[1]);
+  PORTC = (uint8_t)((PORTC & (uint8_t)~DISP7SEG_SEGMASK(2)) | framePtr[2]);
+  if(disp7SegLeftActiveFlag)
+    DIRECTPIN_SET_LOW(DISP7SEG_SELLEFT_PIN);     //turn on left display
+  else                                           // or
+    DIRECTPIN_SET_LOW(DISP7SEG_SELRIGHT_PIN);    //turn on right display
+#else
+  byte dispMsk;
+  if(disp7SegLeftActiveFlag)
+  {  //left display will now be active
+    digitalWrite(DISP7SEG_SELRIGHT_PIN,HIGH);  //turn off right display
+    dispMsk = disp7SegLeftMaskOut;
   }
   else
-  {  //data update is in progress; just do select-lines toggle
-    if(disp7SegLeftActiveFlag)
-    {  //left display will now be active
-      digitalWrite(DISP7SEG_SELRIGHT_PIN,HIGH);  //turn off right display
-      digitalWrite(DISP7SEG_SELLEFT_PIN,LOW);    //turn on left display
-    }
-    else
-    {  //right display will now be active
-      digitalWrite(DISP7SEG_SELLEFT_PIN,HIGH);   //turn off left display
-      digitalWrite(DISP7SEG_SELRIGHT_PIN,LOW);   //turn on right display
-    }
+  {  //right display will now be active
+    digitalWrite(DISP7SEG_SELLEFT_PIN,HIGH);   //turn off left display
+    dispMsk = disp7SegRightMaskOut;
   }
+         //write bitmask value to display-segment outputs:
+  digitalWrite(DISP7SEG_A_PIN,
+              ((((dispMsk) & (byte)0b00000001) != (byte)0) ? LOW : HIGH));
+  digitalWrite(DISP7SEG_B_PIN,
+              ((((dispMsk) & (byte)0b00000010) != (byte)0) ? LOW : HIGH));
+  digitalWrite(DISP7SEG_C_PIN,
+              ((((dispMsk) & (byte)0b00000100) != (byte)0) ? LOW : HIGH));
+  digitalWrite(DISP7SEG_D_PIN,
+              ((((dispMsk) & (byte)0b00001000) != (byte)0) ? LOW : HIGH));
+  digitalWrite(DISP7SEG_E_PIN,
+              ((((dispMsk) & (byte)0b00010000) != (byte)0) ? LOW : HIGH));
+  digitalWrite(DISP7SEG_F_PIN,
+              ((((dispMsk) & (byte)0b00100000) != (byte)0) ? LOW : HIGH));
+  digitalWrite(DISP7SEG_G_PIN,
+              ((((dispMsk) & (byte)0b01000000) != (byte)0) ? LOW : HIGH));
+  digitalWrite(DISP7SEG_DP_PIN,
+              ((((dispMsk) & (byte)0b10000000) != (byte)0) ? LOW : HIGH));
+  if(disp7SegLeftActiveFlag)
+    digitalWrite(DISP7SEG_SELLEFT_PIN,LOW);    //turn on left display
+  else                                              // or
+    digitalWrite(DISP7SEG_SELRIGHT_PIN,LOW);   //turn on right display
+#endif
+#if LATENCYHIST_ENABLED_FLAG
+  latencyHistAddValue(LHIST_DISPISR,micros()-isrEntryUs);
+#endif
 }
 
 //Sets up resources for display management, does hardware setup for Arduino
 // output pins, and starts timer interrupts.
 void disp7SegSetup()
 {
-    //setup array to convert ASCII codes to 7-segment-bitmask values
-              //initialize all values to "undefined" value:
-  for(int i=0; i<DISP7SEG_BITMSKARR_LEN; ++i)
-    disp7SegAsciiToBitmaskArr[i] = DISP7SEG_BITMSK_UNDEF;
-
-  setAsciiToBitmskEntry('0',0b00111111);
-  setAsciiToBitmskEntry('1',0b00000110);
-  setAsciiToBitmskEntry('2',0b01011011);
-  setAsciiToBitmskEntry('3',0b01001111);
-  setAsciiToBitmskEntry('4',0b01100110);
-  setAsciiToBitmskEntry('5',0b01101101);
-  setAsciiToBitmskEntry('6',0b01111101);
-  setAsciiToBitmskEntry('7',0b00000111);
-  setAsciiToBitmskEntry('8',0b01111111);
-  setAsciiToBitmskEntry('9',0b01101111);
-  setAsciiToBitmskEntry('A',0b01110111);
-  setAsciiToBitmskEntry('a',0b01011111);
-  setAsciiToBitmskEntry('b',0b01111100);
-  setAsciiToBitmskEntry('B',0b01111100);
-  setAsciiToBitmskEntry('c',0b01011000);
-  setAsciiToBitmskEntry('C',0b00111001);
-  setAsciiToBitmskEntry('D',0b01011110);
-  setAsciiToBitmskEntry('d',0b01011110);
-  setAsciiToBitmskEntry('E',0b01111001);
-  setAsciiToBitmskEntry('e',0b01111001);
-  setAsciiToBitmskEntry('F',0b01110001);
-  setAsciiToBitmskEntry('f',0b01110001);
-  setAsciiToBitmskEntry('H',0b01110110);
-  setAsciiToBitmskEntry('h',0b01110100);
-  setAsciiToBitmskEntry('I',0b00000110);
-  setAsciiToBitmskEntry('i',0b00000100);
-  setAsciiToBitmskEntry('J',0b00001110);
-  setAsciiToBitmskEntry('j',0b00001100);
-  setAsciiToBitmskEntry('L',0b00111000);
-  setAsciiToBitmskEntry('l',0b00111000);
-  setAsciiToBitmskEntry('n',0b01010100);
-  setAsciiToBitmskEntry('N',0b01010100);
-  setAsciiToBitmskEntry('O',0b00111111);
-  setAsciiToBitmskEntry('o',0b01011100);
-  setAsciiToBitmskEntry('P',0b01110011);
-  setAsciiToBitmskEntry('p',0b01110011);
-  setAsciiToBitmskEntry('r',0b01010000);
-  setAsciiToBitmskEntry('R',0b01010000);
-  setAsciiToBitmskEntry('t',0b01111000);
-  setAsciiToBitmskEntry('T',0b01111000);
-  setAsciiToBitmskEntry('U',0b00111110);
-  setAsciiToBitmskEntry('u',0b00011100);
-  setAsciiToBitmskEntry('y',0b01101110);
-  setAsciiToBitmskEntry('Y',0b01101110);
-  setAsciiToBitmskEntry(' ',0b00000000);
-  setAsciiToBitmskEntry('.',DISP7SEG_BITMSK_DP);
-  setAsciiToBitmskEntry('-',0b01000000);
-  setAsciiToBitmskEntry('=',0b01001000);
-  setAsciiToBitmskEntry('[',0b00111001);
-  setAsciiToBitmskEntry(']',0b00001111);
-  setAsciiToBitmskEntry('\'',0b00000010);
-  setAsciiToBitmskEntry('`',0b00100000);
-  setAsciiToBitmskEntry('\"',0b00100010);
-  setAsciiToBitmskEntry('/',0b01010010);
-  setAsciiToBitmskEntry('\\',0b01100100);
-  setAsciiToBitmskEntry('|',0b00110000);
-  setAsciiToBitmskEntry('_',0b00001000);
-
     //enable output pins for display segments:
   pinMode(DISP7SEG_A_PIN,OUTPUT);
   pinMode(DISP7SEG_B_PIN,OUTPUT);
@@ -411,17 +575,26 @@ void disp7SegSetup()
   digitalWrite(DISP7SEG_SELLEFT_PIN,HIGH);       //initialize both off
   digitalWrite(DISP7SEG_SELRIGHT_PIN,HIGH);
 
+         //set some initial values for displays:
+  disp7SegSetOutputMasks(disp7SegConvAsciiCharsToWord('0',false,'0',false));
+
+#if TICKSCHED_ENABLED_FLAG             //run as task on Timer1 tick
+  tickSchedAddTask(disp7SegTimerIsr,TICKSCHED_PERIOD_DISPLAY,
+                                                  TICKSCHED_PHASE_DISPLAY);
+#else
   Timer1.initialize(DISP7SEG_ISRINTERVAL_MS*1000L);   //set timer interval
   Timer1.attachInterrupt(disp7SegTimerIsr );       //attach service fn
-
-         //set some initial values for displays:
-  disp7SegLeftMaskOut = disp7SegRightMaskOut = disp7SegAsciiToBitmask('0');
+#endif
 }
 
 //Disconnects timer interrupt.
 void disp7SegShutdown()
 {
+#if TICKSCHED_ENABLED_FLAG
+  tickSchedRemoveTask(disp7SegTimerIsr);
+#else
   Timer1.detachInterrupt();
+#endif
 }
 
 //Determines mode for given pin.  Code from:
@@ -136,29 +136,42 @@ int freqListPresetLoadByName(const char *nameStr, uint16_t *freqArr,
   return i;
 }
 
-//Shows all frequency sets (output to serial port).
-void freqListPresetShowAllSets()
+//Shows the next part of the list of all frequency sets (output to serial
+// port):  the heading, or the name or the frequencies for a preset.  This
+// allows a long list to be shown in steps.
+// posPtr:  pointer to position in list (starting at zero), which is
+//          advanced by this function.
+// Returns true if there is more to show; false if done.
+boolean freqListPresetShowAllSetsStep(uint16_t *posPtr)
 {
+  const uint16_t pos = (*posPtr)++;
+  if(pos == 0)
+  {  //heading
+    Serial.println(F(" Frequency-list presets:"));
+    return true;
+  }
+  const int presetIdx = (pos-1) / 2;
+  if(((pos-1) & 1) != 0)
+  {  //show frequencies for preset
+    showFreqSetForPresetIdx(presetIdx);
+    return (presetIdx+1 < (int)(sizeof(freqListValuesPArray)/
+                                           sizeof(freqListValuesPArray[0])));
+  }
   int idx = 0, p = 0;
   char ch;
-  Serial.println(F(" Frequency-list presets:"));
-  Serial.print(' ');         //start first line with space
-  while(true)
-  {
-    ch = (char)pgm_read_byte_near(freqListNamesPArray+p);
-    if(ch != ',' && ch != '\0')
-    {  //not names separator and terminator char
-      Serial.print(ch);
-    }
-    else
-    {  //found names separator
-      Serial.print(": ");
-      showFreqSetForPresetIdx(idx);
-      if(ch == '\0')
-        break;
+  while(idx < presetIdx)
+  {  //scan to start of name for preset
+    if((char)pgm_read_byte_near(freqListNamesPArray+p) == ',')
       ++idx;
-      Serial.print(' ');     //start next line with space
-    }
     ++p;
   }
+  Serial.print(' ');         //start line with space
+  while((ch=(char)pgm_read_byte_near(freqListNamesPArray+p)) != ',' &&
+                                                                 ch != '\0')
+  {  //for each character of name
+    Serial.print(ch);
+    ++p;
+  }
+  Serial.print(": ");
+  return true;
 }
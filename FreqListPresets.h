@@ -9,6 +9,6 @@
 int freqListPresetShowForName(const char *nameStr);
 int freqListPresetLoadByName(const char *nameStr, uint16_t *freqArr,
                                                               int maxCount);
-void freqListPresetShowAllSets();
+boolean freqListPresetShowAllSetsStep(uint16_t *posPtr);
 
 #endif /* FREQLISTPRESETS_H_ */
@@ -0,0 +1,129 @@
+//LatencyHist.cpp:  Histograms (in log2 buckets) of the time taken by
+//                  each pass through 'loop()', the execution time of the
+//                  display and D2/D3 input interrupt-service routines
+//                  (kept separately), and the error in the entry
+//                  interval of the (periodic) display ISR.  They may be
+//                  shown via the "XQ H" command.  All of this is compiled
+//                  out if LATENCYHIST_ENABLED_FLAG is false.
+//
+// 10/16/2026 -- [ET]
+//
+
+#include <Arduino.h>
+#include <util/atomic.h>
+#include "Config.h"
+#include "LatencyHist.h"
+
+#if LATENCYHIST_ENABLED_FLAG
+    //bucket counts (ISR histograms are updated from interrupt context):
+volatile uint16_t latencyHistArr[LHIST_NUM_HISTS][LHIST_NUM_BUCKETS];
+unsigned long latencyHistLastLoopUs = 0;    //start time of last loop pass
+volatile unsigned long latencyHistLastIsrUs = 0;  //last periodic-ISR entry
+
+const char latencyHistNamesPArray[] PROGMEM =
+       "Loop pass,Display-ISR exec,Pin-ISR exec,Display-ISR jitter";
+#endif
+
+//Adds a time value to a histogram (may be called from an ISR).
+// histId:  histogram ID (LHIST_...).
+// timeUs:  time value, in microseconds.
+void latencyHistAddValue(uint8_t histId, unsigned long timeUs)
+{
+#if LATENCYHIST_ENABLED_FLAG
+  uint16_t val = (timeUs < (unsigned long)0xFFFF) ? (uint16_t)timeUs :
+                                                        (uint16_t)0xFFFF;
+  uint8_t bucketIdx = 0;
+  while(val > (uint16_t)1 && bucketIdx < LHIST_NUM_BUCKETS-1)
+  {  //find position of highest set bit
+    val >>= 1;
+    ++bucketIdx;
+  }
+  volatile uint16_t &countRef = latencyHistArr[histId][bucketIdx];
+  if(countRef < (uint16_t)0xFFFF)      //if not saturated then
+    ++countRef;                        //increment count
+#endif
+}
+
+//Marks the start of a pass through 'loop()' (adds the time since the
+// start of the previous pass to the loop-pass histogram).
+void latencyHistMarkLoopPass()
+{
+#if LATENCYHIST_ENABLED_FLAG
+  const unsigned long curUs = micros();
+  if(latencyHistLastLoopUs != 0)
+    latencyHistAddValue(LHIST_LOOPPASS,curUs-latencyHistLastLoopUs);
+  latencyHistLastLoopUs = curUs;
+#endif
+}
+
+//Marks the entry into a periodic ISR (called from the ISR).  The
+// difference between the time since the previous entry and the expected
+// period is added to the jitter histogram.
+// entryUs:  'micros()' value at entry into the ISR.
+// periodUs:  expected period between entries, in microseconds.
+void latencyHistMarkPeriodicIsr(unsigned long entryUs,
+                                                   unsigned long periodUs)
+{
+#if LATENCYHIST_ENABLED_FLAG
+  if(latencyHistLastIsrUs != 0)
+  {
+    const unsigned long intervalUs = entryUs - latencyHistLastIsrUs;
+    latencyHistAddValue(LHIST_ISRJITTER, (intervalUs >= periodUs) ?
+                       (intervalUs - periodUs) : (periodUs - intervalUs));
+  }
+  latencyHistLastIsrUs = entryUs;
+#endif
+}
+
+//Clears all histograms.
+void latencyHistClear()
+{
+#if LATENCYHIST_ENABLED_FLAG
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+  {
+    memset((void *)latencyHistArr,0,sizeof(latencyHistArr));
+  }
+#endif
+}
+
+//Shows the histograms, one line per histogram, with the non-zero
+// buckets shown as "minUs:count".
+void latencyHistShowValues()
+{
+#if LATENCYHIST_ENABLED_FLAG
+  int p = 0;
+  char ch;
+  uint16_t countVal;
+  for(uint8_t h=0; h<LHIST_NUM_HISTS; ++h)
+  {  //for each histogram
+    Serial.print(' ');
+    while((ch=(char)pgm_read_byte_near(latencyHistNamesPArray+p)) != ',' &&
+                                                               ch != '\0')
+    {  //show characters of histogram name
+      Serial.print(ch);
+      ++p;
+    }
+    ++p;                //skip past separator
+    Serial.print(F(" (us):"));
+    for(uint8_t b=0; b<LHIST_NUM_BUCKETS; ++b)
+    {  //for each bucket
+      ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+      {
+        countVal = latencyHistArr[h][b];
+      }
+      if(countVal > 0)
+      {  //bucket not empty; show min value for bucket and count
+        Serial.print(' ');
+        Serial.print((b > 0) ? ((uint16_t)1 << b) : (uint16_t)0);
+        if(b >= LHIST_NUM_BUCKETS-1)
+          Serial.print('+');
+        Serial.print(':');
+        Serial.print(countVal);
+      }
+    }
+    Serial.println();
+  }
+#else
+  Serial.println(F(" Latency histograms not enabled"));
+#endif
+}
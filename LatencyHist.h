@@ -0,0 +1,26 @@
+//LatencyHist.h:  Header file for loop and ISR latency histograms.
+//
+// 10/16/2026 -- [ET]
+//
+
+#ifndef LATENCYHIST_H_
+#define LATENCYHIST_H_
+
+    //histograms:
+#define LHIST_LOOPPASS 0               //time for each pass through 'loop()'
+#define LHIST_DISPISR 1                //execution time of display ISR
+#define LHIST_PINISR 2                 //execution time of D2/D3 input ISRs
+#define LHIST_ISRJITTER 3              //display-ISR entry-interval error
+#define LHIST_NUM_HISTS 4
+    //bucket 0 is for 0-1us; bucket n (n>0) is for 2^n to 2^(n+1)-1 us
+    // (last bucket also holds all larger values):
+#define LHIST_NUM_BUCKETS 16
+
+void latencyHistAddValue(uint8_t histId, unsigned long timeUs);
+void latencyHistMarkLoopPass();
+void latencyHistMarkPeriodicIsr(unsigned long entryUs,
+                                                 unsigned long periodUs);
+void latencyHistClear();
+void latencyHistShowValues();
+
+#endif /* LATENCYHIST_H_ */
@@ -0,0 +1,156 @@
+//RssiRecorder.cpp:  RSSI flight recorder.  Every tune and final RSSI value
+//                   is recorded (with its time) into a RAM ring buffer,
+//                   which may be shown via the 'XV' command to see what
+//                   the receiver was doing before an event.
+//
+// 10/16/2026 -- [ET]
+//
+
+#include <Arduino.h>
+#include "Config.h"
+#include "Rx5808Fns.h"
+#include "RssiRecorder.h"
+
+#if RSSI_RECORDER_FLAG
+uint8_t rssiRecEntriesArr[RSSI_RECORDER_SIZE*3];      //ring of entries
+uint8_t rssiRecNextPos = 0;            //position for next entry
+uint8_t rssiRecCount = 0;              //# of entries in ring
+uint8_t rssiRecChanIdx = RSSIREC_NOCHAN_IDX;     //channel idx for readings
+unsigned long rssiRecLastTimeMs = 0;   //time of last entry
+
+//Returns the time code for the time since the last entry.  The time of
+// the last entry is advanced by the amount represented by the code (so
+// rounding errors do not accumulate).
+uint8_t rssiRecMakeTimeCode()
+{
+  const unsigned long curTimeMs = millis();
+  const unsigned long diffMs = curTimeMs - rssiRecLastTimeMs;
+  if(diffMs <= RSSIREC_FINE_MAXCODE)
+  {  //short time; use milliseconds
+    rssiRecLastTimeMs = curTimeMs;
+    return (uint8_t)diffMs;
+  }
+  const unsigned long unitsVal = diffMs / RSSIREC_COARSE_MS;
+  if(unitsVal >= (unsigned long)(0xFF - RSSIREC_FINE_MAXCODE))
+  {  //very long time; use max code (time not kept)
+    rssiRecLastTimeMs = curTimeMs;
+    return (uint8_t)0xFF;
+  }
+  rssiRecLastTimeMs += unitsVal * RSSIREC_COARSE_MS;
+  return (uint8_t)(RSSIREC_FINE_MAXCODE + unitsVal);
+}
+
+//Adds an entry to the recorder.
+void rssiRecAddEntry(uint8_t val1, uint8_t val2)
+{
+  uint8_t *ptr = &rssiRecEntriesArr[rssiRecNextPos*3];
+  *ptr++ = rssiRecMakeTimeCode();
+  *ptr++ = val1;
+  *ptr = val2;
+  if(++rssiRecNextPos >= RSSI_RECORDER_SIZE)
+    rssiRecNextPos = 0;
+  if(rssiRecCount < RSSI_RECORDER_SIZE)
+    ++rssiRecCount;
+}
+
+//Returns the time (in ms) represented by the given time code (or
+// the max time for the max code).
+uint16_t rssiRecTimeCodeToMs(uint8_t codeVal)
+{
+  return (codeVal <= RSSIREC_FINE_MAXCODE) ? codeVal :
+            (uint16_t)(codeVal - RSSIREC_FINE_MAXCODE) * RSSIREC_COARSE_MS;
+}
+#endif  //RSSI_RECORDER_FLAG
+
+//Records a tuner-channel change.
+// freqInMhz:  new frequency in MHz.
+void rssiRecAddTune(uint16_t freqInMhz)
+{
+#if RSSI_RECORDER_FLAG
+  const int idx = getIdxForFreqInMhz(freqInMhz);
+  rssiRecChanIdx = (idx >= 0 && idx < RSSIREC_NOCHAN_IDX) ?
+                                    (uint8_t)idx : (uint8_t)RSSIREC_NOCHAN_IDX;
+  rssiRecAddEntry((uint8_t)(RSSIREC_TUNE_FLAG | (freqInMhz >> 8)),
+                                                      (uint8_t)freqInMhz);
+#endif
+}
+
+//Records a final RSSI value (for the currently-tuned channel).  The
+// individual readings that are averaged into the value are not recorded.
+// rssiVal:  scaled RSSI value.
+void rssiRecAddReading(uint16_t rssiVal)
+{
+#if RSSI_RECORDER_FLAG
+  rssiRecAddEntry(rssiRecChanIdx,
+                      (rssiVal < 255) ? (uint8_t)rssiVal : (uint8_t)255);
+#endif
+}
+
+//Clears all entries from the recorder.
+void rssiRecClear()
+{
+#if RSSI_RECORDER_FLAG
+  rssiRecCount = 0;
+#endif
+}
+
+//Shows the recorder entries (oldest first), one per line, as
+// "ageMs,T,freq" for tunes and "ageMs,R,freq,rssi" for readings, where
+// 'ageMs' is the time (in ms) before now.  Readings for frequencies
+// not in the channel tables show the frequency of the last tune (or
+// 0 if not known).  If an age is preceded by '>' then there was a gap
+// too long to be timed before it (or an earlier entry).
+void rssiRecShowEntries()
+{
+#if RSSI_RECORDER_FLAG
+  Serial.print(F(" Recorder entries="));
+  Serial.println((int)rssiRecCount);
+  if(rssiRecCount == 0)
+    return;
+  uint8_t pos = (rssiRecNextPos + RSSI_RECORDER_SIZE - rssiRecCount) %
+                                                          RSSI_RECORDER_SIZE;
+  unsigned long ageMs = millis() - rssiRecLastTimeMs;
+  uint8_t gapCount = 0;       //# of untimed gaps after current entry
+  uint8_t i;
+  for(i=rssiRecCount-1; i>0; --i)
+  {  //sum times for all entries after the oldest one
+    const uint8_t codeVal =
+             rssiRecEntriesArr[((pos + i) % RSSI_RECORDER_SIZE) * 3];
+    ageMs += rssiRecTimeCodeToMs(codeVal);
+    if(codeVal == (uint8_t)0xFF)
+      ++gapCount;
+  }
+  uint16_t tuneFreqVal = 0;
+  for(i=0; i<rssiRecCount; ++i)
+  {  //for each entry (oldest first)
+    const uint8_t *ptr = &rssiRecEntriesArr[pos*3];
+    if(i > 0)
+    {  //not oldest entry; reduce age by time since previous entry
+      ageMs -= rssiRecTimeCodeToMs(ptr[0]);
+      if(ptr[0] == (uint8_t)0xFF)
+        --gapCount;                //gap is before this entry
+    }
+    Serial.print((gapCount > 0) ? F(" >") : F(" "));
+    Serial.print(ageMs);
+    if(ptr[1] & RSSIREC_TUNE_FLAG)
+    {  //tune entry
+      tuneFreqVal = ((uint16_t)(ptr[1] & ~RSSIREC_TUNE_FLAG) << 8) | ptr[2];
+      Serial.print(F(",T,"));
+      Serial.println(tuneFreqVal);
+    }
+    else
+    {  //reading entry
+      Serial.print(F(",R,"));
+      Serial.print((ptr[1] < RSSIREC_NOCHAN_IDX &&
+                           (int)ptr[1] <= getChannelMaxIndex()) ?
+                        getChannelFreqTableEntry(ptr[1]) : tuneFreqVal);
+      Serial.print(',');
+      Serial.println((int)ptr[2]);
+    }
+    if(++pos >= RSSI_RECORDER_SIZE)
+      pos = 0;
+  }
+#else
+  Serial.println(F(" Recorder not enabled"));
+#endif
+}
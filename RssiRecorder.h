@@ -0,0 +1,23 @@
+//RssiRecorder.h:  Header file for RSSI flight recorder.
+//
+// 10/16/2026 -- [ET]
+//
+
+#ifndef RSSIRECORDER_H_
+#define RSSIRECORDER_H_
+
+    //entry layout (3 bytes):  time since previous entry, then either
+    // a tune (0x80 | freqHi, freqLo) or a reading (chanIdx, rssi):
+#define RSSIREC_TUNE_FLAG 0x80         //set in byte 1 for tune entries
+#define RSSIREC_NOCHAN_IDX 0x7F        //reading for non-table frequency
+    //time codes below this value are milliseconds; above it they are
+    // in units of RSSIREC_COARSE_MS (max code means a longer time):
+#define RSSIREC_FINE_MAXCODE 0x7F
+#define RSSIREC_COARSE_MS 64
+
+void rssiRecAddTune(uint16_t freqInMhz);
+void rssiRecAddReading(uint16_t rssiVal);
+void rssiRecClear();
+void rssiRecShowEntries();
+
+#endif /* RSSIRECORDER_H_ */
@@ -0,0 +1,187 @@
+//RssiSampler.cpp:  Interrupt-driven RSSI sampler.  The ADC is run in
+//                  free-running mode (prescaler 128, one sample every
+//                  104us at 16MHz), with each sample stored by the
+//                  ADC-complete interrupt into a small ring buffer.
+//                  The sample sequence number serves as the timestamp
+//                  for each sample.
+//
+// 10/16/2026 -- [ET]
+//
+
+#include <Arduino.h>
+#include <util/atomic.h>
+#include "Config.h"
+#include "RssiSampler.h"
+
+#if RSSI_ADCSAMPLER_FLAG
+
+    //ADCSRA value for ADC enabled with prescaler 128 (Arduino default):
+#define RSSISAMP_ADCSRA_IDLE (_BV(ADEN) | _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0))
+#define RSSISAMP_MARKCOUNT_MAX 127     //limit for count of samples since mark
+
+volatile uint16_t rssiSampRingArr[RSSISAMP_RING_SIZE];    //sample values
+volatile uint16_t rssiSampSeqNum = 0;  //sequence # of next sample (wraps)
+uint16_t rssiSampMarkSeqNum = 0;       //first sequence # after tune mark
+volatile int8_t rssiSampMarkCount = 0; //# of samples since mark (-1 until
+                                       // sample in progress at mark done)
+uint8_t rssiSampPinNum = 0;            //analog-input pin being sampled
+boolean rssiSampRunningFlag = false;   //true while sampler running
+
+//Interrupt routine for ADC-conversion complete.
+ISR(ADC_vect)
+{
+  const uint8_t lowVal = ADCL;         //ADCL must be read before ADCH
+  rssiSampRingArr[(uint8_t)rssiSampSeqNum & RSSISAMP_RING_MASK] =
+                                            ((uint16_t)ADCH << 8) | lowVal;
+  ++rssiSampSeqNum;
+  if(rssiSampMarkCount < RSSISAMP_MARKCOUNT_MAX)
+    ++rssiSampMarkCount;
+}
+
+//Starts the sampler on the given analog-input pin.
+// pinNum:  analog-input pin (i.e., A7).
+void rssiSamplerStart(uint8_t pinNum)
+{
+  rssiSamplerStop();
+  rssiSampPinNum = pinNum;
+  if(pinNum >= A0)                     //convert pin # to ADC channel
+    pinNum -= A0;
+  ADMUX = _BV(REFS0) | (pinNum & (uint8_t)0x07);      //AVcc reference
+  ADCSRB = 0;                                         //free-running mode
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+  {         //skip first sample (may be before input settled):
+    rssiSampMarkSeqNum = rssiSampSeqNum + 1;
+    rssiSampMarkCount = -1;
+  }
+  ADCSRA = RSSISAMP_ADCSRA_IDLE | _BV(ADATE) | _BV(ADIE) | _BV(ADSC);
+  rssiSampRunningFlag = true;
+}
+
+//Stops the sampler (so 'analogRead()' may be used).
+void rssiSamplerStop()
+{
+  ADCSRA = RSSISAMP_ADCSRA_IDLE;
+  while(ADCSRA & _BV(ADSC));           //wait for any conversion to finish
+  rssiSampRunningFlag = false;
+}
+
+//Restarts the sampler on the last pin given to 'rssiSamplerStart()'.
+void rssiSamplerRestart()
+{
+  if(rssiSampPinNum > 0)
+    rssiSamplerStart(rssiSampPinNum);
+}
+
+//Returns true if the sampler is running.
+boolean rssiSamplerIsRunning()
+{
+  return rssiSampRunningFlag;
+}
+
+//Marks the time of a tuner-channel change; samples taken before the
+// mark will not be used by 'rssiSamplerGetAverage()'.
+void rssiSamplerMarkTune()
+{
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+  {         //skip sample currently being converted:
+    rssiSampMarkSeqNum = rssiSampSeqNum + 1;
+    rssiSampMarkCount = -1;
+  }
+}
+
+//Returns the sequence number of the next sample to be taken.
+uint16_t rssiSamplerGetSeqNum()
+{
+  uint16_t seqNum;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+  {
+    seqNum = rssiSampSeqNum;
+  }
+  return seqNum;
+}
+
+//Returns the number of samples taken since the last tune mark (counting
+// stops at RSSISAMP_MARKCOUNT_MAX, so the value stays valid however long
+// the tuner stays on a channel).
+uint16_t rssiSamplerGetCountSinceMark()
+{
+  int8_t countVal;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+  {
+    countVal = rssiSampMarkCount;
+  }
+  return (countVal > 0) ? (uint16_t)countVal : (uint16_t)0;
+}
+
+//Returns the average of the most-recent samples taken since the last
+// tune mark.  If not enough samples are available then this function
+// waits for them (about 104us per sample).
+// count:  number of samples to average (1 to RSSISAMP_RING_SIZE).
+// Returns:  A raw RSSI value, or 0 if the sampler is not running.
+uint16_t rssiSamplerGetAverage(uint8_t count)
+{
+  if(!rssiSampRunningFlag)
+    return 0;
+  if(count > RSSISAMP_RING_SIZE)
+    count = RSSISAMP_RING_SIZE;
+  else if(count == 0)
+    count = 1;
+  while(rssiSamplerGetCountSinceMark() < count);
+  uint16_t sumVal = 0;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+  {
+    uint8_t pos = (uint8_t)rssiSampSeqNum;
+    for(uint8_t i=count; i>0; --i)
+      sumVal += rssiSampRingArr[--pos & RSSISAMP_RING_MASK];
+  }
+  return sumVal / count;
+}
+
+//Returns the sequence number of the first sample after the last tune
+// mark (changes whenever 'rssiSamplerMarkTune()' is called).
+uint16_t rssiSamplerGetMarkSeqNum()
+{
+  uint16_t seqNum;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+  {
+    seqNum = rssiSampMarkSeqNum;
+  }
+  return seqNum;
+}
+
+//Adds the samples taken since the given sequence number (and since the
+// last tune mark) to the given total.  Only the most recent
+// RSSISAMP_RING_SIZE samples are available.  Does not wait for samples,
+// so may be called from an interrupt routine.
+// seqNumPtr:  pointer to sequence number of next sample to be added;
+//             updated to the sequence number of the next sample taken.
+// totalPtr:  pointer to total to be added to.
+// Returns:  The number of samples added.
+uint8_t rssiSamplerAddNewSamples(uint16_t *seqNumPtr, uint32_t *totalPtr)
+{
+  if(!rssiSampRunningFlag)
+    return 0;
+  uint8_t count = 0;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+  {
+    const uint16_t nextSeqNum = rssiSampSeqNum;
+    uint16_t availVal = nextSeqNum - *seqNumPtr;
+    const int8_t markCount = rssiSampMarkCount;
+    if(markCount <= 0)                      //skip samples before mark
+      availVal = 0;
+    else if(availVal > (uint16_t)markCount)
+      availVal = (uint16_t)markCount;
+    if(availVal > (uint16_t)0)
+    {  //new samples available
+      count = (availVal < RSSISAMP_RING_SIZE) ? (uint8_t)availVal :
+                                                 (uint8_t)RSSISAMP_RING_SIZE;
+      uint8_t pos = (uint8_t)nextSeqNum;
+      for(uint8_t i=count; i>0; --i)
+        *totalPtr += rssiSampRingArr[--pos & RSSISAMP_RING_MASK];
+    }
+    *seqNumPtr = nextSeqNum;
+  }
+  return count;
+}
+
+#endif  //RSSI_ADCSAMPLER_FLAG
@@ -0,0 +1,24 @@
+//RssiSampler.h:  Header file for interrupt-driven RSSI sampler.
+//
+// 10/16/2026 -- [ET]
+//
+
+#ifndef RSSISAMPLER_H_
+#define RSSISAMPLER_H_
+
+#define RSSISAMP_RING_SIZE 16          //ring-buffer size (power of 2)
+#define RSSISAMP_RING_MASK ((uint8_t)(RSSISAMP_RING_SIZE-1))
+#define RSSISAMP_PERIOD_US 104         //time between samples (16MHz/128/13)
+
+void rssiSamplerStart(uint8_t pinNum);
+void rssiSamplerStop();
+void rssiSamplerRestart();
+boolean rssiSamplerIsRunning();
+void rssiSamplerMarkTune();
+uint16_t rssiSamplerGetSeqNum();
+uint16_t rssiSamplerGetCountSinceMark();
+uint16_t rssiSamplerGetAverage(uint8_t count);
+uint16_t rssiSamplerGetMarkSeqNum();
+uint8_t rssiSamplerAddNewSamples(uint16_t *seqNumPtr, uint32_t *totalPtr);
+
+#endif /* RSSISAMPLER_H_ */
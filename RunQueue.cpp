@@ -0,0 +1,226 @@
+//RunQueue.cpp:  Cooperative run queue for the main-loop tasks.  Each
+//               task has a maximum service latency, and each call to
+//               'runQueueRunNext()' runs the task whose deadline (time
+//               of its last run plus its latency, less the time allowed
+//               for a task run) is earliest, so every task is serviced
+//               within its latency as long as no task run takes longer
+//               than that allowance.  The max time between runs of each
+//               task, and the max response times to serial-input lines
+//               and button commands (from the arrival of the input to
+//               the sending of the first byte of the response), are
+//               kept and may be shown via the "XQ T" command.
+//
+// 10/16/2026 -- [ET]
+//
+
+#include <Arduino.h>
+#include "Config.h"
+#include "RunQueue.h"
+#include "SerialOutQueue.h"
+
+#ifndef SERIAL_TX_BUFFER_SIZE          //(defined by newer Arduino cores)
+#define SERIAL_TX_BUFFER_SIZE 64       //size of serial transmit buffer
+#endif
+    //time allowed for one task run (ms); tasks are scheduled this much
+    // ahead of their latency limits, so task runs should not take longer:
+#define RUNQ_TASKRUN_MS 4
+    //time to send a byte via the serial port (10 bits per byte), in us:
+#define RUNQ_SERIAL_BYTEUS ((10000000L+SERIAL_BAUDRATE-1)/SERIAL_BAUDRATE)
+
+struct RunQueueTask
+{
+  RunQueueTaskFn fnPtr;                //function for task (NULL if none)
+  uint16_t maxLatencyMs;               //max time between runs (ms)
+  uint16_t lastRunMs;                  //millis() (low 16 bits) at last run
+  uint16_t maxGapMs;                   //max time between runs seen (ms)
+  volatile boolean wakeFlag;           //true to run before other tasks
+};
+
+struct RunQueueInput
+{
+  unsigned long arrivedUs;             //time input arrived (earliest)
+  unsigned long sentUs;                //time prior output will be sent
+  unsigned long maxResponseUs;         //max response time seen
+  uint16_t countVal;                   //# of responses
+  boolean pendingFlag;                 //true if awaiting response
+};
+
+RunQueueTask runQueueTasksArr[RUNQ_NUM_TASKS];
+RunQueueInput runQueueInputsArr[RUNQ_NUM_INPUTS];
+uint16_t runQueueCurGapMs = 0;         //time since last run of cur task
+
+    //names of tasks (in RUNQ_TASK_... order):
+const char runQueueNamesPArray[] PROGMEM = "Serial RX,Buttons,Command,"
+                "Scan step,Cont RSSI,Monitor,RSSI out,EEPROM save,Indicator";
+
+//Sets up a task in the run queue.
+// taskId:  task ID (RUNQ_TASK_...).
+// fnPtr:  function to be run for task.
+// maxLatencyMs:  maximum time between runs of the task, in ms (0 for
+//                a task that should be run as often as possible); it
+//                should be more than RUNQ_TASKRUN_MS.
+void runQueueSetTask(uint8_t taskId, RunQueueTaskFn fnPtr,
+                                                     uint16_t maxLatencyMs)
+{
+  RunQueueTask &task = runQueueTasksArr[taskId];
+  task.fnPtr = fnPtr;
+  task.maxLatencyMs = maxLatencyMs;
+  task.lastRunMs = (uint16_t)millis();
+  task.maxGapMs = 0;
+  task.wakeFlag = false;
+}
+
+//Runs the task with the earliest deadline (or, if more than one, the
+// one with the lowest ID).  This function should be called on a
+// periodic basis (i.e., from 'loop()').
+void runQueueRunNext()
+{
+  const uint16_t curMs = (uint16_t)millis();
+  uint8_t selId = RUNQ_NUM_TASKS;
+  int16_t selSlackMs = 0;
+  for(uint8_t i=0; i<RUNQ_NUM_TASKS; ++i)
+  {  //for each task; find the one with the least time to its deadline
+    const RunQueueTask &task = runQueueTasksArr[i];
+    if(task.fnPtr == NULL)
+      continue;
+    const uint16_t schedMs = (task.maxLatencyMs > RUNQ_TASKRUN_MS) ?
+                              (task.maxLatencyMs - RUNQ_TASKRUN_MS) : 0;
+    const int16_t slackMs = task.wakeFlag ? (int16_t)-32768 :
+                                 (int16_t)(task.lastRunMs + schedMs - curMs);
+    if(selId >= RUNQ_NUM_TASKS || slackMs < selSlackMs)
+    {
+      selId = i;
+      selSlackMs = slackMs;
+    }
+  }
+  if(selId >= RUNQ_NUM_TASKS)
+    return;
+  RunQueueTask &task = runQueueTasksArr[selId];
+  runQueueCurGapMs = curMs - task.lastRunMs;
+  if(runQueueCurGapMs > task.maxGapMs)
+    task.maxGapMs = runQueueCurGapMs;
+  task.lastRunMs = curMs;
+  task.wakeFlag = false;
+  (*task.fnPtr)();
+}
+
+//Sets up the given task to be run before any other task (that has not
+// also been woken) on the next call to 'runQueueRunNext()'.  May be
+// called from an interrupt routine.
+// taskId:  task ID (RUNQ_TASK_...).
+void runQueueWakeTask(uint8_t taskId)
+{
+  runQueueTasksArr[taskId].wakeFlag = true;
+}
+
+//Marks the detection of an input (called by the task that detects it).
+// The output already waiting to be sent via the serial port (which will
+// go out ahead of the response) is also noted.
+// inputId:  input source (RUNQ_INPUT_...).
+// arrivedUs:  'micros()' time at which the input arrived (or the
+//             earliest time at which it may have arrived, i.e., the
+//             previous check for the input).
+void runQueueMarkInput(uint8_t inputId, unsigned long arrivedUs)
+{
+  RunQueueInput &input = runQueueInputsArr[inputId];
+  input.arrivedUs = arrivedUs;
+  input.sentUs = micros() + (unsigned long)(SERIAL_TX_BUFFER_SIZE - 1 -
+                Serial.availableForWrite() + outQueueGetUsedCount()) *
+                                                        RUNQ_SERIAL_BYTEUS;
+  input.pendingFlag = true;
+}
+
+//Marks the response to an input (the end of the first run of the
+// command for it, by which time the first byte of its output has been
+// written) and updates the max response time.  The response time runs
+// to when that byte has been sent via the serial port, after the output
+// that was waiting when the input was detected.
+// inputId:  input source (RUNQ_INPUT_...).
+void runQueueMarkResponse(uint8_t inputId)
+{
+  RunQueueInput &input = runQueueInputsArr[inputId];
+  if(!input.pendingFlag)
+    return;
+  input.pendingFlag = false;
+  const unsigned long curUs = micros();
+  const unsigned long sendUs =
+                    ((long)(input.sentUs - curUs) > 0) ? input.sentUs : curUs;
+  const unsigned long respUs = sendUs + RUNQ_SERIAL_BYTEUS - input.arrivedUs;
+  if(respUs > input.maxResponseUs)
+    input.maxResponseUs = respUs;
+  if(input.countVal < (uint16_t)0xFFFF)
+    ++input.countVal;
+}
+
+//Clears the max times between task runs and the response times.
+void runQueueClearStats()
+{
+  for(uint8_t i=0; i<RUNQ_NUM_TASKS; ++i)
+    runQueueTasksArr[i].maxGapMs = 0;
+  memset(runQueueInputsArr,0,sizeof(runQueueInputsArr));
+}
+
+//Shows the next part of the run-queue statistics (output to serial
+// port):  the heading, the max time between runs (and the limit, if any)
+// for a task, as "name=max/limit", or the max response time to
+// serial-input lines or button presses.  This allows the statistics to be
+// shown in steps (so showing them does not stretch the gaps measured).
+// posPtr:  pointer to position in statistics (starting at zero), which
+//          is advanced by this function.
+// Returns true if there is more to show; false if done.
+boolean runQueueShowStatsStep(uint16_t *posPtr)
+{
+  const uint16_t pos = (*posPtr)++;
+  if(pos == 0)
+  {  //heading
+    Serial.print(F(" Task max gap/limit (ms):"));
+    return true;
+  }
+  if(pos <= RUNQ_NUM_TASKS)
+  {  //show entry for task (if task is setup)
+    const uint8_t taskId = (uint8_t)(pos - 1);
+    const RunQueueTask &task = runQueueTasksArr[taskId];
+    if(task.fnPtr != NULL)
+    {
+      int p = 0, idx = 0;
+      char ch;
+      while(idx < taskId)
+      {  //scan to start of name for task
+        if((char)pgm_read_byte_near(runQueueNamesPArray+p) == ',')
+          ++idx;
+        ++p;
+      }
+      Serial.print(' ');
+      while((ch=(char)pgm_read_byte_near(runQueueNamesPArray+p)) != ',' &&
+                                                               ch != '\0')
+      {  //for each character of name
+        Serial.print(ch);
+        ++p;
+      }
+      Serial.print('=');
+      Serial.print(task.maxGapMs);
+      if(task.maxLatencyMs > 0)
+      {  //task has limit; show it
+        Serial.print('/');
+        Serial.print(task.maxLatencyMs);
+      }
+    }
+    if(pos == RUNQ_NUM_TASKS)
+      Serial.println();
+    return true;
+  }
+  const uint8_t inputId = (pos == RUNQ_NUM_TASKS+1) ?
+                                      RUNQ_INPUT_SERIAL : RUNQ_INPUT_BUTTON;
+  if(inputId == RUNQ_INPUT_SERIAL)
+    Serial.print(F(" Max response (us):  serial="));
+  else
+    Serial.print(F(", button="));
+  Serial.print(runQueueInputsArr[inputId].maxResponseUs);
+  Serial.print(F(" (n="));
+  Serial.print(runQueueInputsArr[inputId].countVal);
+  Serial.print(')');
+  if(inputId == RUNQ_INPUT_SERIAL)
+    return true;
+  Serial.println();
+  return false;
+}
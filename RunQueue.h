@@ -0,0 +1,37 @@
+//RunQueue.h:  Header file for cooperative run queue.
+//
+// 10/16/2026 -- [ET]
+//
+
+#ifndef RUNQUEUE_H_
+#define RUNQUEUE_H_
+
+    //tasks (in priority order for tasks that are equally due):
+#define RUNQ_TASK_SERIALRX 0           //serial-input polling
+#define RUNQ_TASK_BUTTONS 1            //button inputs
+#define RUNQ_TASK_COMMAND 2            //command execution
+#define RUNQ_TASK_SCANSTEP 3           //scan-job stepping
+#define RUNQ_TASK_CONTRSSI 4           //continuous-RSSI output
+#define RUNQ_TASK_MONITOR 5            //auto-tune-monitor timing
+#define RUNQ_TASK_RSSIOUT 6            //analog-RSSI output
+#define RUNQ_TASK_EEPROM 7             //delayed EEPROM writeback
+#define RUNQ_TASK_INDICATOR 8          //activity indicator
+#define RUNQ_NUM_TASKS 9
+
+    //input sources (for response times):
+#define RUNQ_INPUT_SERIAL 0            //serial-input line
+#define RUNQ_INPUT_BUTTON 1            //button press
+#define RUNQ_NUM_INPUTS 2
+
+typedef void (*RunQueueTaskFn)();
+
+void runQueueSetTask(uint8_t taskId, RunQueueTaskFn fnPtr,
+                                                     uint16_t maxLatencyMs);
+void runQueueRunNext();
+void runQueueWakeTask(uint8_t taskId);
+void runQueueMarkInput(uint8_t inputId, unsigned long arrivedUs);
+void runQueueMarkResponse(uint8_t inputId);
+void runQueueClearStats();
+boolean runQueueShowStatsStep(uint16_t *posPtr);
+
+#endif /* RUNQUEUE_H_ */
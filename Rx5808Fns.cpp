@@ -41,75 +41,176 @@ SOFTWARE.
 #include <Arduino.h>
 #include <avr/pgmspace.h>
 #include "Config.h"
+#include "ArduVidUtil.h"
+#include "RssiSampler.h"
+#include "SerialOutQueue.h"
+#include "TimeStats.h"
 #include "Rx5808Fns.h"
 
-// Channels to send to the SPI registers
-const uint16_t channelRegTable[] PROGMEM = {
-  // Channel 1 - 8
-  0x2A05,    0x299B,    0x2991,    0x2987,    0x291D,    0x2913,    0x2909,    0x289F,    // Band A
-  0x2903,    0x290C,    0x2916,    0x291F,    0x2989,    0x2992,    0x299C,    0x2A05,    // Band B
-  0x2895,    0x288B,    0x2881,    0x2817,    0x2A0F,    0x2A19,    0x2A83,    0x2A8D,    // Band E
-  0x2906,    0x2910,    0x291A,    0x2984,    0x298E,    0x2998,    0x2A02,    0x2A0C,    // Band F / Airwave
+// Band plan:  band-code character and channel frequencies (MHz) for each
+// band.  The frequency, register, sorted-index and band-code tables below
+// are all generated (and verified) from this list at compile time.
+#define RX5808_BAND_PLAN_BASE(BAND) \
+  BAND('A', 5865, 5845, 5825, 5805, 5785, 5765, 5745, 5725)  /* Band A */ \
+  BAND('B', 5733, 5752, 5771, 5790, 5809, 5828, 5847, 5866)  /* Band B */ \
+  BAND('E', 5705, 5685, 5665, 5645, 5885, 5905, 5925, 5945)  /* Band E */ \
+  BAND('F', 5740, 5760, 5780, 5800, 5820, 5840, 5860, 5880)  /* Airwave */ \
+  BAND('R', 5658, 5695, 5732, 5769, 5806, 5843, 5880, 5917)  /* Raceband */
 #if USE_LBAND_FLAG
-  0x281D,    0x288F,    0x2902,    0x2914,    0x2987,    0x2999,    0x2A0C,    0x2A1E,    // Band C / Immersion Raceband
-  0x2609,    0x261C,    0x268E,    0x2701,    0x2713,    0x2786,    0x2798,    0x280B     // Band D / 5.3
+#define RX5808_BAND_PLAN(BAND) RX5808_BAND_PLAN_BASE(BAND) \
+  BAND('L', 5362, 5399, 5436, 5473, 5510, 5547, 5584, 5621)  /* Band D/5.3 */
 #else
-  0x281D,    0x288F,    0x2902,    0x2914,    0x2987,    0x2999,    0x2A0C,    0x2A1E     // Band C / Immersion Raceband
+#define RX5808_BAND_PLAN(BAND) RX5808_BAND_PLAN_BASE(BAND)
 #endif
+
+    //band-plan expanders for frequency, register and band-code tables:
+#define BANDPLAN_FREQS(ch,f1,f2,f3,f4,f5,f6,f7,f8) \
+                                          f1, f2, f3, f4, f5, f6, f7, f8,
+#define BANDPLAN_REGS(ch,f1,f2,f3,f4,f5,f6,f7,f8) \
+  freqMhzToRegValConst(f1), freqMhzToRegValConst(f2), \
+  freqMhzToRegValConst(f3), freqMhzToRegValConst(f4), \
+  freqMhzToRegValConst(f5), freqMhzToRegValConst(f6), \
+  freqMhzToRegValConst(f7), freqMhzToRegValConst(f8),
+#define BANDPLAN_CHAR(ch,...) ch,
+
+//Converts frequency in MHz to register value (compile-time version):
+// FreqMHz = 2*(N*32+A) + 479
+constexpr uint16_t freqMhzToRegValConst(uint16_t freqInMhz)
+{
+  return ((((freqInMhz - 479) / 2) / 32) << 7) +
+                                            (((freqInMhz - 479) / 2) % 32);
+}
+
+    //compile-time copy of band-plan frequencies (not stored in program):
+constexpr uint16_t bandPlanFreqsArr[] = { RX5808_BAND_PLAN(BANDPLAN_FREQS) };
+#define BANDPLAN_NUM_CHANS ((int)(sizeof(bandPlanFreqsArr)/sizeof(uint16_t)))
+constexpr char bandPlanCharsArr[] = { RX5808_BAND_PLAN(BANDPLAN_CHAR) '\0' };
+
+//Returns true if channel 'idxA' is sorted before channel 'idxB' (lower
+// frequency, or same frequency and lower index).
+constexpr bool bandPlanSortsBefore(int idxA, int idxB)
+{
+  return (bandPlanFreqsArr[idxA] < bandPlanFreqsArr[idxB] ||
+         (bandPlanFreqsArr[idxA] == bandPlanFreqsArr[idxB] && idxA < idxB));
+}
+
+//Returns the MHz-sorted position of the given channel (the number of
+// channels sorted before it, counting from 'idxB').
+constexpr int bandPlanSortPosOf(int idx, int idxB = 0)
+{
+  return (idxB >= BANDPLAN_NUM_CHANS) ? 0 :
+                             ((bandPlanSortsBefore(idxB,idx) ? 1 : 0) +
+                                           bandPlanSortPosOf(idx,idxB+1));
+}
+
+//Returns the index of the channel at the given MHz-sorted position
+// (searching from 'idx').
+constexpr uint8_t bandPlanIdxAtSortPos(int sortPos, int idx = 0)
+{
+  return (idx >= BANDPLAN_NUM_CHANS || bandPlanSortPosOf(idx) == sortPos) ?
+                      (uint8_t)idx : bandPlanIdxAtSortPos(sortPos,idx+1);
+}
+
+//Returns true if the band-plan frequencies (starting at 'idx') are in
+// the range supported by commands and are tuned by their register values
+// to within the 2 MHz synthesizer resolution.
+constexpr bool bandPlanFreqsValid(int idx = 0)
+{
+  return (idx >= BANDPLAN_NUM_CHANS) ? true :
+           (bandPlanFreqsArr[idx] >= MIN_CHANNEL_MHZ &&
+            bandPlanFreqsArr[idx] <= MAX_CHANNEL_MHZ &&
+            bandPlanFreqsArr[idx] -
+                 (2*(((freqMhzToRegValConst(bandPlanFreqsArr[idx]) >> 7) * 32) +
+                   (freqMhzToRegValConst(bandPlanFreqsArr[idx]) & 0x1F)) + 479)
+                                                                       <= 1 &&
+            bandPlanFreqsValid(idx+1));
+}
+
+//Returns true if the generated sort positions (starting at 'sortPos')
+// are in ascending-frequency order.
+constexpr bool bandPlanSortValid(int sortPos = 0)
+{
+  return (sortPos >= BANDPLAN_NUM_CHANS-1) ? true :
+                    (bandPlanSortsBefore(bandPlanIdxAtSortPos(sortPos),
+                                     bandPlanIdxAtSortPos(sortPos+1)) &&
+                                              bandPlanSortValid(sortPos+1));
+}
+
+    //compile-time list of indices (for generating sorted-index table):
+template<int... Is> struct BandPlanIdxSeq {};
+template<int N, int... Is> struct BandPlanMakeIdxSeq :
+                                   BandPlanMakeIdxSeq<N-1, N-1, Is...> {};
+template<int... Is> struct BandPlanMakeIdxSeq<0, Is...>
+{
+  typedef BandPlanIdxSeq<Is...> type;
+};
+
+    //holder for sorted-index table (so it can be generated via template):
+struct BandPlanSortTable
+{
+  uint8_t idxArr[BANDPLAN_NUM_CHANS];
+};
+
+//Generates the sorted-index table for the given list of positions.
+template<int... Is>
+constexpr BandPlanSortTable makeBandPlanSortTable(BandPlanIdxSeq<Is...>)
+{
+  return BandPlanSortTable{ { bandPlanIdxAtSortPos(Is)... } };
+}
+
+static_assert(BANDPLAN_NUM_CHANS == CHANNEL_MAX_INDEX+1,
+                         "Band plan does not match CHANNEL_MAX_INDEX");
+static_assert(BANDPLAN_NUM_CHANS % CHANNEL_BAND_SIZE == 0,
+                           "Band plan has partial band");
+static_assert(bandPlanFreqsValid(), "Band-plan frequency out of range");
+static_assert(bandPlanSortValid(), "Band-plan sorted index not in order");
+static_assert(!USE_LBAND_FLAG ||
+               bandPlanCharsArr[LBAND_FIRST_INDEX/CHANNEL_BAND_SIZE] == 'L',
+                         "LBAND_FIRST_INDEX does not match band plan");
+
+// Channels to send to the SPI registers
+const uint16_t channelRegTable[] PROGMEM = {
+  RX5808_BAND_PLAN(BANDPLAN_REGS)
 };
 
 // Channels with their Mhz Values
 const uint16_t channelFreqTable[] PROGMEM = {
-  // Channel 1 - 8
-  5865, 5845, 5825, 5805, 5785, 5765, 5745, 5725, // Band A
-  5733, 5752, 5771, 5790, 5809, 5828, 5847, 5866, // Band B
-  5705, 5685, 5665, 5645, 5885, 5905, 5925, 5945, // Band E
-  5740, 5760, 5780, 5800, 5820, 5840, 5860, 5880, // Band F / Airwave
-#if USE_LBAND_FLAG
-  5658, 5695, 5732, 5769, 5806, 5843, 5880, 5917, // Band C / Immersion Raceband
-  5362, 5399, 5436, 5473, 5510, 5547, 5584, 5621  // Band D / 5.3
-#else
-  5658, 5695, 5732, 5769, 5806, 5843, 5880, 5917  // Band C / Immersion Raceband
-#endif
+  RX5808_BAND_PLAN(BANDPLAN_FREQS)
 };
 
-// do coding as simple hex value to save memory.
-//const uint8_t channelNames[] PROGMEM = {
-//  0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, // Band A
-//  0xB1, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, // Band B
-//  0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, // Band E
-//  0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, // Band F / Airwave
-//#if USE_LBAND_FLAG
-//  0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, // Band C / Immersion Raceband
-//  0xD1, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8  // BAND D / 5.3
-//#else
-//  0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8  // Band C / Immersion Raceband
-//#endif
-//};
-
 // All Channels of the above List ordered by Mhz
-const uint8_t channelSortTable[] PROGMEM = {
-#if USE_LBAND_FLAG
-  40, 41, 42, 43, 44, 45, 46, 47, 19, 32, 18, 17, 33, 16, 7, 34, 8, 24, 6, 9, 25, 5, 35, 10, 26, 4, 11, 27, 3, 36, 12, 28, 2, 13, 29, 37, 1, 14, 30, 0, 15, 31, 38, 20, 21, 39, 22, 23
-#else
-  19, 32, 18, 17, 33, 16, 7, 34, 8, 24, 6, 9, 25, 5, 35, 10, 26, 4, 11, 27, 3, 36, 12, 28, 2, 13, 29, 37, 1, 14, 30, 0, 15, 31, 38, 20, 21, 39, 22, 23
-#endif
-};
+const BandPlanSortTable channelSortTable PROGMEM =
+   makeBandPlanSortTable(BandPlanMakeIdxSeq<BANDPLAN_NUM_CHANS>::type());
 
      //array of band codes in 'channelFreqTable[]' order:
-#if USE_LBAND_FLAG
-const char freqBandCodesArray[] = "ABEFRL";
-#else
-const char freqBandCodesArray[] = "ABEFR";
-#endif
+const char freqBandCodesArray[] = { RX5808_BAND_PLAN(BANDPLAN_CHAR) '\0' };
 #define NUM_FREQBAND_CODES ((CHANNEL_MAX_INDEX+1)/CHANNEL_BAND_SIZE)
+static_assert(sizeof(freqBandCodesArray) == NUM_FREQBAND_CODES+1,
+                            "Band-code array does not match band plan");
 
 uint8_t rx5808RssiInPin = RSSI_PRI_PIN;
 uint8_t rx5808MinTuneTimeMs = RX5808_MIN_TUNETIME;
 uint8_t lastChannelIndex = 0;
 unsigned long timeOfLastTune = 0;      //time of last tuner-channel change
+boolean rx5808RssiReadyFlag = false;   //true if RSSI settled after tune
+uint8_t rx5808LastSettleTimeMs = 0;    //time for RSSI to settle after tune
+#if RSSI_SETTLE_DETECT_FLAG
+uint8_t rssiSettleLastCheckMs = 0;     //tune-relative time of last check
+uint8_t rssiSettleMatchCount = 0;      //# of checks matching reference
+uint16_t rssiSettleRefValue = 0;       //reference value for settle checks
+#endif
 uint16_t rx5808RawRssiMin = DEF_RAWRSSI_MIN;
 uint16_t rx5808RawRssiMax = DEF_RAWRSSI_MAX;
+#if CUSTOM_BANDS_MAXCOUNT > 0
+    //user-defined bands (channel indices start at CUSTOM_FIRST_INDEX):
+uint8_t customBandsCount = 0;          //# of user-defined bands
+char customBandCodesArr[CUSTOM_BANDS_MAXCOUNT];     //band-code characters
+uint16_t customFreqTableArr[CUSTOM_BANDS_MAXCOUNT*CHANNEL_BAND_SIZE];
+    //indices of user-defined channels sorted by MHz, and their positions
+    // in the combined sorted order (with the built-in channels):
+uint8_t customSortIdxArr[CUSTOM_BANDS_MAXCOUNT*CHANNEL_BAND_SIZE];
+uint8_t customSortPosArr[CUSTOM_BANDS_MAXCOUNT*CHANNEL_BAND_SIZE];
+#endif
 //uint16_t rssi_setup_min_a=RAW_RSSI_MIN;
 //uint16_t rssi_setup_max_a=RAW_RSSI_MAX;
 
@@ -137,49 +238,346 @@ uint16_t rx5808RawRssiMax = DEF_RAWRSSI_MAX;
 //Returns the value from the channel-frequency table for the given index.
 uint16_t getChannelFreqTableEntry(int idx)
 {
+#if CUSTOM_BANDS_MAXCOUNT > 0
+  if(idx >= CUSTOM_FIRST_INDEX)        //if user-defined channel then
+    return customFreqTableArr[idx-CUSTOM_FIRST_INDEX];   //use RAM table
+#endif
   return pgm_read_word_near(channelFreqTable + idx);
 }
 
-//Returns the value from the channel-register table for the given index.
+//Returns the value from the channel-register table for the given index
+// (for user-defined channels the value is calculated from the freq).
 uint16_t getChannelRegTableEntry(int idx)
 {
+#if CUSTOM_BANDS_MAXCOUNT > 0
+  if(idx >= CUSTOM_FIRST_INDEX)        //if user-defined channel then
+    return freqMhzToRegVal(customFreqTableArr[idx-CUSTOM_FIRST_INDEX]);
+#endif
   return pgm_read_word_near(channelRegTable + idx);
 }
 
-//Returns the value from the channel-sorted-indices table for the given index.
+//Returns the value from the channel-sorted-indices table for the given
+// index.  Any user-defined channels are merged in (by MHz value).
 uint8_t getChannelSortTableEntry(int idx)
 {
-  return pgm_read_word_near(channelSortTable + idx);
+#if CUSTOM_BANDS_MAXCOUNT > 0
+  if(customBandsCount > 0)
+  {  //user-defined channels in use; check their positions
+    const uint8_t numCustom = customBandsCount * CHANNEL_BAND_SIZE;
+    uint8_t i = 0;
+    while(i < numCustom && customSortPosArr[i] < idx)
+      ++i;
+    if(i < numCustom && customSortPosArr[i] == idx)
+      return customSortIdxArr[i];      //position is user-defined channel
+    idx -= i;           //adjust to position in built-in table
+  }
+#endif
+  return pgm_read_byte_near(channelSortTable.idxArr + idx);
+}
+
+//Returns the highest channel index in use (including any user-defined
+// channels).
+int getChannelMaxIndex()
+{
+#if CUSTOM_BANDS_MAXCOUNT > 0
+  return CHANNEL_MAX_INDEX + customBandsCount*CHANNEL_BAND_SIZE;
+#else
+  return CHANNEL_MAX_INDEX;
+#endif
+}
+
+//Returns the number of frequency bands in use (including any
+// user-defined bands).
+int getNumFreqBands()
+{
+  return (getChannelMaxIndex()+1) / CHANNEL_BAND_SIZE;
+}
+
+//Returns the band-code character for the given band index (built-in
+// bands are first, followed by any user-defined bands).
+char getFreqBandCode(int bandIdx)
+{
+#if CUSTOM_BANDS_MAXCOUNT > 0
+  if(bandIdx >= NUM_FREQBAND_CODES)
+    return customBandCodesArr[bandIdx-NUM_FREQBAND_CODES];
+#endif
+  return freqBandCodesArray[bandIdx];
+}
+
+//Returns true if the given band-code character is for a built-in band.
+boolean isBuiltinFreqBandCode(char bandCh)
+{
+  return (strchr(freqBandCodesArray,bandCh) != NULL && bandCh != '\0');
+}
+
+#if CUSTOM_BANDS_MAXCOUNT > 0
+//Loads the sorted-index arrays for the user-defined channels.  Each
+// user-defined channel is placed after any built-in channels with the
+// same frequency.
+void loadCustomSortArrays()
+{
+  const uint8_t numCustom = customBandsCount * CHANNEL_BAND_SIZE;
+  uint8_t i, j, idx;
+  for(i=0; i<numCustom; ++i)
+  {  //for each user-defined channel; insert into sorted list
+    idx = (uint8_t)(CUSTOM_FIRST_INDEX + i);
+    j = i;
+    while(j > 0 && customFreqTableArr[customSortIdxArr[j-1]-
+                        CUSTOM_FIRST_INDEX] > customFreqTableArr[i])
+    {  //shift entries with higher frequencies up
+      customSortIdxArr[j] = customSortIdxArr[j-1];
+      --j;
+    }
+    customSortIdxArr[j] = idx;
+  }
+  int loPos, hiPos, midPos;
+  uint16_t freqVal;
+  for(i=0; i<numCustom; ++i)
+  {  //for each sorted user-defined channel; find # of built-in chans before
+    freqVal = customFreqTableArr[customSortIdxArr[i]-CUSTOM_FIRST_INDEX];
+    loPos = CHANNEL_MIN_INDEX;
+    hiPos = CHANNEL_MAX_INDEX+1;
+    while(loPos < hiPos)
+    {  //binary search for first built-in channel above frequency
+      midPos = (loPos + hiPos) / 2;
+      if(pgm_read_word_near(channelFreqTable +
+                  pgm_read_byte_near(channelSortTable.idxArr + midPos)) <= freqVal)
+      {
+        loPos = midPos + 1;
+      }
+      else
+        hiPos = midPos;
+    }
+    customSortPosArr[i] = (uint8_t)(loPos + i);
+  }
+}
+#endif
+
+//Sets (adds or replaces) a user-defined band.  Only the frequencies are
+// stored; the register values for its channels are computed from their
+// frequencies when looked up (via 'getChannelRegTableEntry()').
+// bandCh:  band-code character (must not be a built-in band code).
+// freqArr:  array of CHANNEL_BAND_SIZE frequency values (MHz).
+//Returns true if successful; false if too many bands or bad band code.
+boolean setCustomBand(char bandCh, const uint16_t *freqArr)
+{
+#if CUSTOM_BANDS_MAXCOUNT > 0
+  if(isBuiltinFreqBandCode(bandCh) || bandCh < 'A' || bandCh > 'Z')
+    return false;
+  uint8_t bandIdx = 0;
+  while(bandIdx < customBandsCount && customBandCodesArr[bandIdx] != bandCh)
+    ++bandIdx;          //find existing band with same code (if any)
+  if(bandIdx >= CUSTOM_BANDS_MAXCOUNT)
+    return false;       //no room for new band
+  customBandCodesArr[bandIdx] = bandCh;
+  const uint8_t offs = bandIdx * CHANNEL_BAND_SIZE;
+  for(uint8_t i=0; i<CHANNEL_BAND_SIZE; ++i)
+    customFreqTableArr[offs+i] = freqArr[i];     //store freq for channel
+
+  if(bandIdx >= customBandsCount)      //if new band then
+    customBandsCount = bandIdx + 1;    //increase count
+  loadCustomSortArrays();
+  return true;
+#else
+  return false;
+#endif
+}
+
+//Removes the user-defined band with the given band-code character.
+//Returns true if successful; false if band not found.
+boolean removeCustomBand(char bandCh)
+{
+#if CUSTOM_BANDS_MAXCOUNT > 0
+  uint8_t bandIdx = 0;
+  while(bandIdx < customBandsCount && customBandCodesArr[bandIdx] != bandCh)
+    ++bandIdx;
+  if(bandIdx >= customBandsCount)
+    return false;
+  --customBandsCount;
+  while(bandIdx < customBandsCount)
+  {  //shift following bands down
+    customBandCodesArr[bandIdx] = customBandCodesArr[bandIdx+1];
+    const uint8_t offs = bandIdx * CHANNEL_BAND_SIZE;
+    for(uint8_t i=0; i<CHANNEL_BAND_SIZE; ++i)
+      customFreqTableArr[offs+i] = customFreqTableArr[offs+CHANNEL_BAND_SIZE+i];
+    ++bandIdx;
+  }
+  loadCustomSortArrays();
+  return true;
+#else
+  return false;
+#endif
+}
+
+//Removes all user-defined bands.
+void clearCustomBands()
+{
+#if CUSTOM_BANDS_MAXCOUNT > 0
+  customBandsCount = 0;
+#endif
+}
+
+//Returns the number of user-defined bands.
+int getCustomBandsCount()
+{
+#if CUSTOM_BANDS_MAXCOUNT > 0
+  return customBandsCount;
+#else
+  return 0;
+#endif
+}
+
+//Returns the frequency (MHz) for the given position in the
+// channel-sorted-indices table.
+inline uint16_t getSortedFreqTableEntry(int sortPos)
+{
+  return getChannelFreqTableEntry(getChannelSortTableEntry(sortPos));
+}
+
+//Returns the position in the channel-sorted-indices table of the first
+// entry with a frequency at or above the given frequency (via binary
+// search), or getChannelMaxIndex()+1 if all are below.  For entries with
+// the same frequency the lowest table index is first.
+// freqVal:  Frequency value in MHz.
+int getSortPosForFreqInMhz(uint16_t freqVal)
+{
+  int loPos = CHANNEL_MIN_INDEX, hiPos = getChannelMaxIndex()+1, midPos;
+  while(loPos < hiPos)
+  {  //narrow range until entry found
+    midPos = (loPos + hiPos) / 2;
+    if(getSortedFreqTableEntry(midPos) < freqVal)
+      loPos = midPos + 1;
+    else
+      hiPos = midPos;
+  }
+  return loPos;
 }
 
 //Returns the 'channelFreqTable[]' index corresponding to the given
-// frequency in MHz, or -1 if no match.
+// frequency in MHz, or -1 if no match.  If more than one entry matches
+// then the lowest index is returned.
 int getIdxForFreqInMhz(uint16_t freqVal)
 {
-  for(int idx=CHANNEL_MIN_INDEX; idx<=CHANNEL_MAX_INDEX; ++idx)
+  const int sortPos = getSortPosForFreqInMhz(freqVal);
+  if(sortPos <= getChannelMaxIndex() &&
+                                 getSortedFreqTableEntry(sortPos) == freqVal)
   {
-    if(getChannelFreqTableEntry(idx) == freqVal)
-      return idx;
+    return (int)getChannelSortTableEntry(sortPos);
   }
   return -1;
 }
 
-void waitRssiReady()
+//Returns the 'channelFreqTable[]' index for the table frequency nearest
+// to the given frequency in the given direction (or equal to it), with
+// wrap-around past the lowest/highest table frequency.  If more than
+// one entry has the frequency then the lowest index is returned.
+// freqVal:  Frequency value in MHz.
+// upFlag:  true for nearest at or above; false for nearest at or below.
+int getIdxForNearestFreqInMhz(uint16_t freqVal, boolean upFlag)
+{
+  const int maxIdx = getChannelMaxIndex();
+  int sortPos = getSortPosForFreqInMhz(freqVal);
+  if(upFlag)
+  {  //nearest at or above
+    if(sortPos > maxIdx)
+      sortPos = CHANNEL_MIN_INDEX;     //if beyond max, wrap to min
+  }
+  else if(sortPos > maxIdx ||
+                                   getSortedFreqTableEntry(sortPos) != freqVal)
+  {  //no exact match; use nearest below
+    if(--sortPos < CHANNEL_MIN_INDEX)
+      sortPos = maxIdx;                //if beyond min, wrap to max
+    const uint16_t nearFreq = getSortedFreqTableEntry(sortPos);
+    while(sortPos > CHANNEL_MIN_INDEX &&
+                            getSortedFreqTableEntry(sortPos-1) == nearFreq)
+    {  //move to first entry with same frequency
+      --sortPos;
+    }
+  }
+  return (int)getChannelSortTableEntry(sortPos);
+}
+
+//Checks if the RSSI input has settled since the last tuner-channel
+// change.  This function does not block.  If RSSI_SETTLE_DETECT_FLAG is
+// enabled then (after RSSI_SETTLE_MINTIME_MS) short RSSI averages are
+// taken at RSSI_SETTLE_INTERVAL_MS intervals, and the RSSI is considered
+// settled after RSSI_SETTLE_MATCHCOUNT successive averages are within
+// RSSI_SETTLE_TOLERANCE of the reference (first) average of the run.
+// In any case the RSSI is considered settled once the min-tune time
+// ('rx5808MinTuneTimeMs') has elapsed.
+// Returns true if settled; false if not.
+boolean isRx5808RssiReady()
 {
-  // CHECK FOR MINIMUM DELAY
-  // check if RSSI is stable after tune by checking the time
-  uint16_t tune_time = (uint16_t)(millis() - timeOfLastTune);
-  if(tune_time < rx5808MinTuneTimeMs)
+  if(rx5808RssiReadyFlag)
+    return true;
+  const unsigned long tuneTimeMs = millis() - timeOfLastTune;
+  if(tuneTimeMs >= rx5808MinTuneTimeMs)
+  {  //min-tune time reached (or exceeded)
+    rx5808LastSettleTimeMs = (uint8_t)rx5808MinTuneTimeMs;
+    rx5808RssiReadyFlag = true;
+    return true;
+  }
+#if RSSI_SETTLE_DETECT_FLAG
+  if(tuneTimeMs < RSSI_SETTLE_MINTIME_MS || (rssiSettleMatchCount > 0 &&
+              (uint8_t)tuneTimeMs - rssiSettleLastCheckMs <
+                                            (uint8_t)RSSI_SETTLE_INTERVAL_MS))
+  {  //not yet time for a check
+    return false;
+  }
+  rssiSettleLastCheckMs = (uint8_t)tuneTimeMs;
+  uint16_t rssiVal = 0;
+#if RSSI_ADCSAMPLER_FLAG
+  if(rssiSamplerIsRunning())
+    rssiVal = rssiSamplerGetAverage(RSSI_SETTLE_SAMPLES);
+  else
+#endif
   {
-      // wait until tune time is full filled
-    delay(rx5808MinTuneTimeMs-tune_time);
+    for(uint8_t i=RSSI_SETTLE_SAMPLES; i>0; --i)
+      rssiVal += analogRead(rx5808RssiInPin);
+    rssiVal /= RSSI_SETTLE_SAMPLES;
+  }
+  if(rssiSettleMatchCount == 0 ||
+              abs((int)rssiVal - (int)rssiSettleRefValue) > RSSI_SETTLE_TOLERANCE)
+  {  //first check or not within tolerance; start new run
+    rssiSettleRefValue = rssiVal;
+    rssiSettleMatchCount = 1;
+    return false;
   }
+  if(++rssiSettleMatchCount <= RSSI_SETTLE_MATCHCOUNT)
+    return false;
+  rx5808LastSettleTimeMs = (uint8_t)tuneTimeMs;
+  rx5808RssiReadyFlag = true;
+  return true;
+#else
+  return false;
+#endif
+}
+
+//Waits (if needed) until the RSSI input has settled since the last
+// tuner-channel change.
+void waitRssiReady()
+{
+  TIMESTATS_START(startUs);
+  while(!isRx5808RssiReady())
+    outQueuePump();          //send queued output while waiting
+  TIMESTATS_END(TSTAT_RSSIWAIT,startUs);
+}
+
+//Returns the time (in ms) taken for the RSSI input to settle after the
+// last tuner-channel change.
+uint8_t getRx5808LastSettleTimeMs()
+{
+  return rx5808LastSettleTimeMs;
 }
 
 //Reads and averages a set of RSSI samples for the currently-tuned channel.
 // Returns:  A raw RSSI value.
 uint16_t readRawRssiValue()
 {
+#if RSSI_ADCSAMPLER_FLAG
+  if(rssiSamplerIsRunning())      //if sampler running then use its buffer
+    return rssiSamplerGetAverage(RSSISAMP_RING_SIZE);
+#endif
   int rssiA = 0;
 
   analogRead(rx5808RssiInPin);              //pre-read to improve I/O
@@ -220,129 +618,210 @@ uint16_t scaleRawRssiValue(uint16_t rawRssiVal)
 // Returns:  An raw RSSI value.
 uint16_t sampleRawRssiValue()
 {
+#if RSSI_ADCSAMPLER_FLAG
+  if(rssiSamplerIsRunning())      //if sampler running then use its buffer
+    return rssiSamplerGetAverage(1);
+#endif
   analogRead(rx5808RssiInPin);         //pre-read to improve I/O
   return analogRead(rx5808RssiInPin);
 }
 
-void SERIAL_SENDBIT1()
-{
-  digitalWrite(RX5808_CLK_PIN, LOW);
-  delayMicroseconds(1);
+#if RX5808_HWSPI_FLAG
+#if !DIRECTPIN_SUPPORTED_FLAG
+#error RX5808_HWSPI_FLAG requires an ATmega328/168 board
+#endif
+#if RX5808_DATA_PIN != 11 || RX5808_CLK_PIN != 13 || RX5808_SEL_PIN != 10
+#error RX5808_HWSPI_FLAG requires DATA=D11 (MOSI), CLK=D13 (SCK), SEL=D10
+#endif
+#if DISP7SEG_ENABLED_FLAG
+#error RX5808_HWSPI_FLAG conflicts with 7-segment display DP line (D13)
+#endif
+    //SPI master, mode 0, LSB first, transfer-complete interrupt enabled;
+    // the RX5808 samples DATA on the rising edge of CLK.  The clock is
+    // fosc/8 (2MHz at 16MHz), about twice the rate of the bit-bang
+    // transport, for margin with the series resistors and wiring on RX5808
+    // boards; the CPU is only busy for the interrupt entries, so a faster
+    // clock would shorten the frame without freeing more CPU time:
+#define RX5808_SPCR_VAL (_BV(SPE) | _BV(SPIE) | _BV(MSTR) | _BV(DORD) | \
+                                                                 _BV(SPR0))
+#define RX5808_SPSR_VAL _BV(SPI2X)
+#endif
 
-  digitalWrite(RX5808_DATA_PIN, HIGH);
-  delayMicroseconds(1);
-  digitalWrite(RX5808_CLK_PIN, HIGH);
-  delayMicroseconds(1);
+#if (RX5808_DIRECTPORT_FLAG || RX5808_HWSPI_FLAG) && DIRECTPIN_SUPPORTED_FLAG
+    //RX5808 pin writes via direct port access (with the pin numbers being
+    // compile-time constants each resolves to a single 'sbi'/'cbi'):
+#define RX5808_PIN_HIGH(pin) DIRECTPIN_SET_HIGH(pin)
+#define RX5808_PIN_LOW(pin) DIRECTPIN_SET_LOW(pin)
+    //pin settling time between changes (4 cycles == 250ns at 16MHz):
+#define RX5808_PIN_DELAY() __builtin_avr_delay_cycles(4)
+#else
+#define RX5808_PIN_HIGH(pin) digitalWrite(pin, HIGH)
+#define RX5808_PIN_LOW(pin) digitalWrite(pin, LOW)
+#define RX5808_PIN_DELAY() delayMicroseconds(1)
+#endif
 
-  digitalWrite(RX5808_CLK_PIN, LOW);
-  delayMicroseconds(1);
-}
+#define RX5808_SYNTHB_REGADDR ((uint8_t)0x1)     //synthesizer-B register
 
-void SERIAL_SENDBIT0()
+uint16_t rx5808LastRegVal = 0;         //reg value of last tune (0 == none)
+
+//Clocks out a single bit to the RX5808 module.
+inline void sendRx5808Bit(boolean bitFlag)
 {
-  digitalWrite(RX5808_CLK_PIN, LOW);
-  delayMicroseconds(1);
+  if(bitFlag)
+    RX5808_PIN_HIGH(RX5808_DATA_PIN);
+  else
+    RX5808_PIN_LOW(RX5808_DATA_PIN);
+  RX5808_PIN_DELAY();
+  RX5808_PIN_HIGH(RX5808_CLK_PIN);
+  RX5808_PIN_DELAY();
+  RX5808_PIN_LOW(RX5808_CLK_PIN);
+  RX5808_PIN_DELAY();
+}
+
+#if RX5808_HWSPI_FLAG
+
+uint8_t rx5808SpiFrameBytesArr[2];     //2nd and 3rd bytes of SPI frame
+volatile uint8_t rx5808SpiBytesLeft = 0;    //# of bytes still to load
+volatile boolean rx5808SpiBusyFlag = false; //true while frame being sent
 
-  digitalWrite(RX5808_DATA_PIN, LOW);
-  delayMicroseconds(1);
-  digitalWrite(RX5808_CLK_PIN, HIGH);
-  delayMicroseconds(1);
+//Waits for any SPI frame in progress to be completed.
+void waitRx5808FrameDone()
+{
+  while(rx5808SpiBusyFlag);
+}
 
-  digitalWrite(RX5808_CLK_PIN, LOW);
-  delayMicroseconds(1);
+//Starts sending a 25-bit register-write frame to the RX5808 module.
+// Bits are sent LSB first; order:  A0-3, !R/W (1 == write), D0-D19.  The
+// first 24 bits are shifted out via the SPI peripheral, with each byte
+// after the first loaded by the transfer-complete interrupt (so the CPU
+// is not held while the frame is sent).  After the last byte the
+// interrupt disables the SPI (returning the pins to port control),
+// clocks out the final bit directly and latches the frame.  Any frame
+// still in progress is completed first.
+// regAddr:  register address (0-15).
+// dataVal:  data value for D0-D15 (D16-D19 are sent as zeros).
+void sendRx5808RegFrame(uint8_t regAddr, uint16_t dataVal)
+{
+  waitRx5808FrameDone();
+  RX5808_PIN_HIGH(RX5808_SEL_PIN);
+  RX5808_PIN_DELAY();
+  RX5808_PIN_LOW(RX5808_SEL_PIN);
+  RX5808_PIN_DELAY();
+  rx5808SpiFrameBytesArr[0] = (uint8_t)(dataVal >> 3);     //D3-D10
+  rx5808SpiFrameBytesArr[1] = (uint8_t)(dataVal >> 11);    //D11-D18
+  rx5808SpiBytesLeft = 2;
+  rx5808SpiBusyFlag = true;
+  SPSR = RX5808_SPSR_VAL;
+  SPCR = RX5808_SPCR_VAL;
+                   //A0-3, write bit, D0-D2:
+  SPDR = (regAddr & (uint8_t)0x0F) | (uint8_t)0x10 | (uint8_t)(dataVal << 5);
 }
 
-void SERIAL_ENABLE_LOW()
+//Interrupt for SPI transfer complete; loads the next byte of the frame
+// or, after the last one, finishes the frame.
+ISR(SPI_STC_vect)
 {
-  delayMicroseconds(1);
-  digitalWrite(RX5808_SEL_PIN, LOW);
-  delayMicroseconds(1);
+  const uint8_t leftVal = rx5808SpiBytesLeft;
+  if(leftVal > 0)
+  {  //more bytes to send
+    SPDR = rx5808SpiFrameBytesArr[2-leftVal];
+    rx5808SpiBytesLeft = leftVal - 1;
+    return;
+  }
+  SPCR = 0;                            //release MOSI/SCK to port control
+  sendRx5808Bit(false);                //D19
+
+  RX5808_PIN_HIGH(RX5808_SEL_PIN);     //finished clocking data in
+  RX5808_PIN_DELAY();
+  RX5808_PIN_LOW(RX5808_SEL_PIN);
+  RX5808_PIN_LOW(RX5808_CLK_PIN);
+  RX5808_PIN_LOW(RX5808_DATA_PIN);
+  rx5808SpiBusyFlag = false;
 }
 
-void SERIAL_ENABLE_HIGH()
+#else
+
+//Waits for any frame in progress to be completed (frames are sent
+// synchronously by the bit-bang transport).
+inline void waitRx5808FrameDone()
 {
-  delayMicroseconds(1);
-  digitalWrite(RX5808_SEL_PIN, HIGH);
-  delayMicroseconds(1);
 }
 
-void setChannelByRegVal(uint16_t regVal, uint16_t freqInMhz)
+//Sends a 25-bit register-write frame to the RX5808 module.  Bits are
+// sent LSB first; order:  A0-3, !R/W (1 == write), D0-D19.
+// regAddr:  register address (0-15).
+// dataVal:  data value for D0-D15 (D16-D19 are sent as zeros).
+void sendRx5808RegFrame(uint8_t regAddr, uint16_t dataVal)
 {
   uint8_t i;
 
-  // bit bash out 25 bits of data
-  // Order: A0-3, !R/W, D0-D19
-  // A0=0, A1=0, A2=0, A3=1, RW=0, D0-19=0
-  SERIAL_ENABLE_HIGH();
-  delayMicroseconds(1);
-  //delay(2);
-  SERIAL_ENABLE_LOW();
-
-  SERIAL_SENDBIT0();
-  SERIAL_SENDBIT0();
-  SERIAL_SENDBIT0();
-  SERIAL_SENDBIT1();
-
-  SERIAL_SENDBIT0();
-
-  // remaining zeros
-  for (i = 20; i > 0; i--)
-    SERIAL_SENDBIT0();
-
-  // Clock the data in
-  SERIAL_ENABLE_HIGH();
-  //delay(2);
-  delayMicroseconds(1);
-  SERIAL_ENABLE_LOW();
-
-  // Second is the channel data from the lookup table
-  // 20 bytes of register data are sent, but the MSB 4 bits are zeros
-  // register address = 0x1, write, data0-15=channelData data15-19=0x0
-  SERIAL_ENABLE_HIGH();
-  SERIAL_ENABLE_LOW();
-
-  // Register 0x1
-  SERIAL_SENDBIT1();
-  SERIAL_SENDBIT0();
-  SERIAL_SENDBIT0();
-  SERIAL_SENDBIT0();
-
-  // Write to register
-  SERIAL_SENDBIT1();
-
-  // D0-D15
-  //   note: loop runs backwards as more efficent on AVR
-  for (i = 16; i > 0; i--)
+  RX5808_PIN_HIGH(RX5808_SEL_PIN);
+  RX5808_PIN_DELAY();
+  RX5808_PIN_LOW(RX5808_SEL_PIN);
+  RX5808_PIN_DELAY();
+                   //address bits plus write bit:
+  regAddr = (regAddr & (uint8_t)0x0F) | (uint8_t)0x10;
+  for(i=5; i>0; --i)
   {
-    // Is bit high or low?
-    if (regVal & 0x1)
-    {
-      SERIAL_SENDBIT1();
-    }
-    else
-    {
-      SERIAL_SENDBIT0();
-    }
-
-    // Shift bits along to check the next one
-    regVal >>= 1;
+    sendRx5808Bit(regAddr & (uint8_t)0x01);
+    regAddr >>= 1;
   }
+  for(i=16; i>0; --i)
+  {  //D0-D15 (note: loop runs backwards as more efficent on AVR)
+    sendRx5808Bit(dataVal & (uint16_t)0x01);
+    dataVal >>= 1;
+  }
+  for(i=4; i>0; --i)                   //D16-D19
+    sendRx5808Bit(false);
+
+  RX5808_PIN_HIGH(RX5808_SEL_PIN);     //finished clocking data in
+  RX5808_PIN_DELAY();
+  RX5808_PIN_LOW(RX5808_SEL_PIN);
+  RX5808_PIN_LOW(RX5808_CLK_PIN);
+  RX5808_PIN_LOW(RX5808_DATA_PIN);
+}
 
-  // Remaining D16-D19
-  for (i = 4; i > 0; i--)
-    SERIAL_SENDBIT0();
-
-  // Finished clocking data in
-  SERIAL_ENABLE_HIGH();
-  delayMicroseconds(1);
-  //delay(2);
+#endif  //RX5808_HWSPI_FLAG
 
-  digitalWrite(RX5808_SEL_PIN, LOW);
-  digitalWrite(RX5808_CLK_PIN, LOW);
-  digitalWrite(RX5808_DATA_PIN, LOW);
+//Tunes the RX5808 module via the given register value.  The write is
+// skipped if the module is already tuned to the value (so the RSSI
+// settle time is also not restarted).
+void setChannelByRegVal(uint16_t regVal, uint16_t freqInMhz)
+{
+  if(regVal == rx5808LastRegVal)
+    return;
+         //(the read-cycle frame to register 0x8 sent here by the original
+         // code was a no-op for the module and has been removed)
+  TIMESTATS_START(startUs);
+  sendRx5808RegFrame(RX5808_SYNTHB_REGADDR, regVal);
+  TIMESTATS_END(TSTAT_TUNEWRITE,startUs);
+  rx5808LastRegVal = regVal;
 
     //keep time of tune to make sure that RSSI is stable when required
   timeOfLastTune = millis();
+  rx5808RssiReadyFlag = false;
+#if RSSI_ADCSAMPLER_FLAG
+  rssiSamplerMarkTune();               //ignore samples from before tune
+#endif
+#if RSSI_SETTLE_DETECT_FLAG
+  rssiSettleMatchCount = 0;
+#endif
+}
+
+//Measures the time taken to send a tuning frame to the RX5808 module
+// (by re-sending the current tuning value, so the channel is unchanged).
+// count:  number of frames to send and average over.
+// Returns:  The average time per frame in microseconds, or 0 if the
+//           module has not yet been tuned.
+uint16_t measureRx5808TuneWriteUs(uint8_t count)
+{
+  if(rx5808LastRegVal == 0 || count == 0)
+    return 0;
+  const unsigned long startUs = micros();
+  for(uint8_t i=count; i>0; --i)
+    sendRx5808RegFrame(RX5808_SYNTHB_REGADDR, rx5808LastRegVal);
+  waitRx5808FrameDone();
+  return (uint16_t)((micros() - startUs) / count);
 }
 
 //void setChannelByIdx(uint8_t idx, uint16_t freqInMhz)
@@ -354,11 +833,7 @@ void setChannelByRegVal(uint16_t regVal, uint16_t freqInMhz)
 //  https://github.com/sheaivey/rx5808-pro-diversity/issues/75
 uint16_t freqMhzToRegVal(uint16_t freqInMhz)
 {
-  uint16_t tf, N, A;
-  tf = (freqInMhz - 479) / 2;
-  N = tf / 32;
-  A = tf % 32;
-  return (N<<7) + A;
+  return freqMhzToRegValConst(freqInMhz);     //same formula as tables
 }
 
 //Convert register value to frequency in MHz
@@ -380,7 +855,7 @@ void setChannelByFreq(uint16_t freqInMhz)
 //Returns true if the given index is for an L-band frequency.
 boolean isLBandChannelIndex(int idx)
 {
-  return (idx >= LBAND_FIRST_INDEX);
+  return (idx >= LBAND_FIRST_INDEX && idx <= CHANNEL_MAX_INDEX);
 }
 
 
@@ -425,6 +900,9 @@ void rx5808setup()
     }
   }
 #endif
+#if RSSI_ADCSAMPLER_FLAG
+  rssiSamplerStart(rx5808RssiInPin);   //start interrupt-driven sampling
+#endif
 }
 
 //Sets min/max-raw-RSSI values for scaling (from analog inputs to 0-100).
@@ -471,12 +949,13 @@ boolean isPriRx5808RssiInPinInUse()
 // Returns corresponding frequency (MHz) value, or zero if no match.
 uint16_t freqCodeCharsToFreqInMhz(char bandCh, char chanCh)
 {
+  const int numBands = getNumFreqBands();
   int bandIdx = 0;
   while(true)
   {  //match band-code character to array entry
-    if(bandIdx >= NUM_FREQBAND_CODES)
+    if(bandIdx >= numBands)
       return 0;         //if no match then return 0
-    if(freqBandCodesArray[bandIdx] == bandCh)
+    if(getFreqBandCode(bandIdx) == bandCh)
       break;
     ++bandIdx;
   }
@@ -525,9 +1004,9 @@ uint16_t freqIdxToFreqCode(int freqIdx, char *outStr)
 {
   char bandCh,offsCh;
   uint16_t retVal;
-  if(freqIdx >= 0 && freqIdx <= CHANNEL_MAX_INDEX)
+  if(freqIdx >= 0 && freqIdx <= getChannelMaxIndex())
   {  //index value OK; convert to band and offset characters
-    bandCh = freqBandCodesArray[freqIdx/CHANNEL_BAND_SIZE];
+    bandCh = getFreqBandCode(freqIdx/CHANNEL_BAND_SIZE);
     offsCh = (char)(freqIdx%CHANNEL_BAND_SIZE + (int)'1');
          //pack two characters into returned word:
     retVal = (((uint16_t)bandCh) << 8) | offsCh;
@@ -569,30 +1048,7 @@ uint16_t freqInMhzToFreqCode(uint16_t freqVal, char *outStr)
 uint16_t freqInMhzToNearestFreqCode(uint16_t freqVal, boolean upFlag,
                                                                char *outStr)
 {
-  int freqIdx, fChkVal = freqVal;
-  uint16_t codeVal;
-  do
-  {
-    freqIdx = getIdxForFreqInMhz(fChkVal);
-    if(freqIdx >= 0)
-    {  //table-index value found for frequency; check for matching code
-      codeVal = freqIdxToFreqCode(freqIdx,outStr);
-      if(codeVal > 0)             //if code for freq found then
-        return codeVal;           //return code
-    }
-    if(upFlag)
-    {  //increment
-      if(++fChkVal > MAX_CHANNEL_MHZ)       //increment frequency by 1 MHz
-        fChkVal = MIN_CHANNEL_MHZ;          //if beyond max, wrap to min
-    }
-    else
-    {  //decrement
-      if(--fChkVal < MIN_CHANNEL_MHZ)       //decrement frequency by 1 MHz
-        fChkVal = MAX_CHANNEL_MHZ;          //if beyond min, wrap to max
-    }
-  }
-  while(fChkVal != freqVal);   //loop unless wrapped around to original freq
-  return (uint16_t)0;
+  return freqIdxToFreqCode(getIdxForNearestFreqInMhz(freqVal,upFlag),outStr);
 }
 
 //Increments (or decrements) band or channel on given two-character
@@ -610,31 +1066,32 @@ uint16_t incDecFreqCodeValue(uint16_t codeWordVal, boolean bandFlag,
   char chanCh = (char)codeWordVal;
   if(bandFlag)
   {  //increment or decrement band character, with wrap-around
+    const int numBands = getNumFreqBands();
     int bandIdx = 0;
     while(true)
     {  //match band-code character to array entry
-      if(bandIdx >= NUM_FREQBAND_CODES)
+      if(bandIdx >= numBands)
       {  //no more entries in array to check (no match)
         bandIdx = 0;    //use first one
         break;          //exit loop
       }
-      if(freqBandCodesArray[bandIdx] == bandCh)
+      if(getFreqBandCode(bandIdx) == bandCh)
       {  //array-entry match found
         if(upFlag)
         {  //increment
-          if(++bandIdx >= NUM_FREQBAND_CODES)    //increment to next entry
+          if(++bandIdx >= numBands)    //increment to next entry
             bandIdx = 0;       //if beyond last then wrap-around to first
         }
         else
         {  //decrement
           if(--bandIdx < 0 )      //decrement to next entry, with wrap-around
-            bandIdx = NUM_FREQBAND_CODES - 1;
+            bandIdx = numBands - 1;
         }
         break;          //exit loop
       }
       ++bandIdx;
     }
-    bandCh = freqBandCodesArray[bandIdx];        //new band character
+    bandCh = getFreqBandCode(bandIdx);           //new band character
   }
   else
   {  //increment or decrement channel character, with wrap-around
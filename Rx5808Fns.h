@@ -34,6 +34,10 @@
     #define CHANNEL_MAX_INDEX 39
 #endif
 #define LBAND_FIRST_INDEX 40
+    //user-defined bands (if any) follow the built-in channels:
+#define CUSTOM_FIRST_INDEX (CHANNEL_MAX_INDEX+1)
+#define CHANNEL_TOTAL_MAXCOUNT \
+                  (CHANNEL_MAX_INDEX+1+CUSTOM_BANDS_MAXCOUNT*CHANNEL_BAND_SIZE)
 
 #ifdef rx5808
     // rx5808 module need >20ms to tune.
@@ -60,11 +64,24 @@ boolean isPriRx5808RssiInPinInUse();
 uint16_t freqMhzToRegVal(uint16_t freqInMhz);
 uint16_t regValToFreqMhz(uint16_t regVal);
 void setChannelByFreq(uint16_t freqInMhz);
+uint16_t measureRx5808TuneWriteUs(uint8_t count);
 uint16_t getChannelFreqTableEntry(int idx);
 uint16_t getChannelRegTableEntry(int idx);
 uint8_t getChannelSortTableEntry(int idx);
+int getChannelMaxIndex();
+int getNumFreqBands();
+char getFreqBandCode(int bandIdx);
+boolean isBuiltinFreqBandCode(char bandCh);
+int getCustomBandsCount();
+boolean setCustomBand(char bandCh, const uint16_t *freqArr);
+boolean removeCustomBand(char bandCh);
+void clearCustomBands();
+int getSortPosForFreqInMhz(uint16_t freqVal);
 int getIdxForFreqInMhz(uint16_t freqVal);
+int getIdxForNearestFreqInMhz(uint16_t freqVal, boolean upFlag);
+boolean isRx5808RssiReady();
 void waitRssiReady();
+uint8_t getRx5808LastSettleTimeMs();
 uint16_t readRawRssiValue();
 uint16_t scaleRawRssiValue(uint16_t rawRssiVal);
 uint16_t sampleRawRssiValue();
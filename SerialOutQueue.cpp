@@ -0,0 +1,235 @@
+//SerialOutQueue.cpp:  Queued serial output.  Output is placed into a
+//                     ring buffer and moved to the serial port (whose
+//                     transmit buffer is drained by the core's UDRE
+//                     interrupt) only as space becomes available, so
+//                     scans and streaming output do not wait on the
+//                     serial port.  Streaming lines may be marked as
+//                     "droppable" and are then discarded (and counted)
+//                     when the serial port is falling behind.
+//
+// 10/16/2026 -- [ET]
+//
+
+#include <Arduino.h>
+#include "Config.h"
+#include "SerialOutQueue.h"
+
+#if SERIAL_OUTQUEUE_FLAG
+uint8_t outQueueRingArr[OUTQUEUE_RING_SIZE];     //ring buffer for output
+uint8_t outQueueHeadPos = 0;           //position for next byte added
+uint8_t outQueueTailPos = 0;           //position for next byte sent
+uint8_t outQueueMaxUsedCount = 0;      //max # of bytes waiting to be sent
+#endif
+boolean outQueueDroppingFlag = false;  //true while discarding a line
+uint16_t outQueueDroppedCount = 0;     //# of droppable lines discarded
+uint16_t outQueueStallCount = 0;       //# of times waited for free space
+
+const uint16_t outQueuePow10Arr[] PROGMEM = { 10000, 1000, 100, 10 };
+
+//Adds a byte to the output queue.  If the queue is full then waits
+// (while sending bytes) until space is available; this is counted as a
+// stall (shown via 'XQ').  Streaming producers avoid it by deferring
+// their output until 'outQueueHasRoom()' (or by making it droppable).
+void outQueueAddByte(uint8_t val)
+{
+  if(outQueueDroppingFlag)             //if discarding line then
+    return;                            //ignore byte
+#if SERIAL_OUTQUEUE_FLAG
+  const uint8_t nextPos = (outQueueHeadPos + 1) & OUTQUEUE_RING_MASK;
+  if(nextPos == outQueueTailPos)
+  {  //queue is full
+    outQueuePump();
+    if(nextPos == outQueueTailPos)
+    {  //still full; wait for space
+      ++outQueueStallCount;
+      do
+        outQueuePump();
+      while(nextPos == outQueueTailPos);
+    }
+  }
+  outQueueRingArr[outQueueHeadPos] = val;
+  outQueueHeadPos = nextPos;
+  const uint8_t usedCount = (outQueueHeadPos - outQueueTailPos) &
+                                                       OUTQUEUE_RING_MASK;
+  if(usedCount > outQueueMaxUsedCount)
+    outQueueMaxUsedCount = usedCount;
+#else
+  Serial.write(val);
+#endif
+}
+
+//Adds a character to the output queue.
+void outQueueAddChar(char ch)
+{
+  outQueueAddByte((uint8_t)ch);
+}
+
+//Adds the decimal digits for the given value to the output queue.
+// The digits are generated by subtracting powers of ten (avoids the
+// division used by 'itoa()' and 'Serial.print()').
+void outQueueAddUint(uint16_t val)
+{
+  boolean digitFlag = false;
+  for(uint8_t i=0; i<sizeof(outQueuePow10Arr)/sizeof(uint16_t); ++i)
+  {  //for each power of ten (except one)
+    const uint16_t pVal = pgm_read_word_near(outQueuePow10Arr + i);
+    char ch = '0';
+    while(val >= pVal)
+    {
+      val -= pVal;
+      ++ch;
+    }
+    if(ch > '0' || digitFlag)
+    {  //not a leading zero
+      outQueueAddChar(ch);
+      digitFlag = true;
+    }
+  }
+  outQueueAddChar((char)('0' + val));
+}
+
+//Adds the decimal digits for the given long value to the output queue.
+void outQueueAddULong(unsigned long val)
+{
+  if(val <= (unsigned long)0xFFFF)
+  {  //value fits in 16 bits; use faster function
+    outQueueAddUint((uint16_t)val);
+    return;
+  }
+  outQueueAddULong(val / 10);
+  outQueueAddChar((char)('0' + (uint8_t)(val % 10)));
+}
+
+//Adds a carriage return and line feed to the output queue (same line
+// ending as 'Serial.println()').
+void outQueueAddNewline()
+{
+  outQueueAddByte((uint8_t)'\r');
+  outQueueAddByte((uint8_t)'\n');
+}
+
+//Sends a droppable line (or binary frame).  If the serial port is
+// falling behind (more than OUTQUEUE_DROP_LEVEL bytes waiting to be
+// sent) then the output added by the given function is discarded.
+// addFn:  function that adds the output (via the 'outQueueAdd...()' and
+//         'binFrame...()' functions).
+// val:  value passed to 'addFn'.
+// Returns:  true if the output was queued; false if it was discarded.
+boolean outQueueSendDroppable(void (*addFn)(uint16_t), uint16_t val)
+{
+#if SERIAL_OUTQUEUE_FLAG
+  outQueuePump();
+  outQueueDroppingFlag = (((outQueueHeadPos - outQueueTailPos) &
+                              OUTQUEUE_RING_MASK) > OUTQUEUE_DROP_LEVEL);
+#else
+  outQueueDroppingFlag = (Serial.availableForWrite() <= 0);
+#endif
+  addFn(val);
+  if(!outQueueDroppingFlag)
+    return true;
+  outQueueDroppingFlag = false;
+  ++outQueueDroppedCount;
+  return false;
+}
+
+//Determines if there is room in the output queue for the given number
+// of bytes (after sending what the serial port will take).  Producers of
+// output that may not be dropped (like scan results) use this to defer
+// their work until the queue has room, instead of waiting on it.
+// count:  number of bytes.
+// Returns:  true if the bytes can be added without waiting.
+boolean outQueueHasRoom(uint8_t count)
+{
+#if SERIAL_OUTQUEUE_FLAG
+  outQueuePump();
+  return (((outQueueHeadPos - outQueueTailPos) & OUTQUEUE_RING_MASK) +
+                                          count < (uint8_t)OUTQUEUE_RING_SIZE);
+#else
+  return (Serial.availableForWrite() >= (int)count);
+#endif
+}
+
+//Determines if the given number of bytes may be sent directly to the
+// serial port (via 'Serial.print()') without waiting:  the output queue
+// must be empty (so the output stays in order) and the serial-port
+// transmit buffer must have room for the bytes.
+// count:  number of bytes.
+// Returns:  true if the bytes can be sent without waiting.
+boolean outQueueDirectHasRoom(uint8_t count)
+{
+#if SERIAL_OUTQUEUE_FLAG
+  outQueuePump();
+  if(outQueueTailPos != outQueueHeadPos)
+    return false;
+#endif
+  return (Serial.availableForWrite() >= (int)count);
+}
+
+//Moves bytes from the output queue to the serial port, for as long as
+// the serial-port transmit buffer has space.  This function should be
+// called on a periodic basis.
+void outQueuePump()
+{
+#if SERIAL_OUTQUEUE_FLAG
+  int freeCount = Serial.availableForWrite();
+  while(outQueueTailPos != outQueueHeadPos && freeCount > 0)
+  {
+    Serial.write(outQueueRingArr[outQueueTailPos]);
+    outQueueTailPos = (outQueueTailPos + 1) & OUTQUEUE_RING_MASK;
+    --freeCount;
+  }
+#endif
+}
+
+//Sends all bytes in the output queue to the serial port.  This function
+// should be called before any output is sent directly to the serial
+// port (so the output stays in order).
+void outQueueFlush()
+{
+#if SERIAL_OUTQUEUE_FLAG
+  while(outQueueTailPos != outQueueHeadPos)
+    outQueuePump();
+#endif
+}
+
+//Returns the number of droppable lines that were discarded.
+uint16_t outQueueGetDroppedCount()
+{
+  return outQueueDroppedCount;
+}
+
+//Returns the number of times output waited for space in the queue.
+uint16_t outQueueGetStallCount()
+{
+  return outQueueStallCount;
+}
+
+//Returns the number of bytes waiting in the queue to be sent.
+uint8_t outQueueGetUsedCount()
+{
+#if SERIAL_OUTQUEUE_FLAG
+  return (outQueueHeadPos - outQueueTailPos) & OUTQUEUE_RING_MASK;
+#else
+  return 0;
+#endif
+}
+
+//Returns the maximum number of bytes that were waiting to be sent.
+uint8_t outQueueGetMaxUsed()
+{
+#if SERIAL_OUTQUEUE_FLAG
+  return outQueueMaxUsedCount;
+#else
+  return 0;
+#endif
+}
+
+//Clears the output-queue statistics.
+void outQueueClearStats()
+{
+  outQueueDroppedCount = 0;
+  outQueueStallCount = 0;
+#if SERIAL_OUTQUEUE_FLAG
+  outQueueMaxUsedCount = 0;
+#endif
+}
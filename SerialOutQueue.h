@@ -0,0 +1,31 @@
+//SerialOutQueue.h:  Header file for queued serial output.
+//
+// 10/16/2026 -- [ET]
+//
+
+#ifndef SERIALOUTQUEUE_H_
+#define SERIALOUTQUEUE_H_
+
+#define OUTQUEUE_RING_SIZE 64          //ring-buffer size (power of 2)
+#define OUTQUEUE_RING_MASK ((uint8_t)(OUTQUEUE_RING_SIZE-1))
+    //droppable lines are discarded if more than this many bytes are
+    // waiting to be sent when the line is started:
+#define OUTQUEUE_DROP_LEVEL (OUTQUEUE_RING_SIZE/2)
+
+void outQueueAddByte(uint8_t val);
+void outQueueAddChar(char ch);
+void outQueueAddUint(uint16_t val);
+void outQueueAddULong(unsigned long val);
+void outQueueAddNewline();
+boolean outQueueSendDroppable(void (*addFn)(uint16_t), uint16_t val);
+boolean outQueueHasRoom(uint8_t count);
+boolean outQueueDirectHasRoom(uint8_t count);
+void outQueuePump();
+void outQueueFlush();
+uint16_t outQueueGetDroppedCount();
+uint16_t outQueueGetStallCount();
+uint8_t outQueueGetUsedCount();
+uint8_t outQueueGetMaxUsed();
+void outQueueClearStats();
+
+#endif /* SERIALOUTQUEUE_H_ */
@@ -0,0 +1,120 @@
+//TickSched.cpp:  Timer1 tick scheduler.  Timer1 interrupts at a fixed
+//                rate (TICKSCHED_TICK_US) and each registered task is
+//                run from the interrupt routine once per period, at a
+//                fixed phase (tick offset) within that period.  Tasks
+//                should be short and must not use the serial port or
+//                wait on other interrupts.
+//
+// 10/16/2026 -- [ET]
+//
+
+#include <Arduino.h>
+#include <util/atomic.h>
+#include "TimerOne.h"
+#include "Config.h"
+#include "TickSched.h"
+
+#if TICKSCHED_ENABLED_FLAG
+
+struct TickSchedTask
+{
+  TickSchedTaskFn fnPtr;               //function to be run
+  uint8_t periodTicks;                 //# of ticks between runs
+  uint8_t countdownVal;                //# of ticks until next run
+};
+
+TickSchedTask tickSchedTasksArr[TICKSCHED_MAX_TASKS];
+volatile uint8_t tickSchedNumTasks = 0;     //# of entries in array
+volatile uint16_t tickSchedTickCount = 0;   //tick count (wraps)
+boolean tickSchedRunningFlag = false;       //true while Timer1 running
+
+//Interrupt routine for Timer1; runs the tasks that are due.
+void tickSchedTimerIsr()
+{
+  const uint16_t tickVal = tickSchedTickCount + 1;
+  tickSchedTickCount = tickVal;
+  const uint8_t numTasks = tickSchedNumTasks;
+  for(uint8_t i=0; i<numTasks; ++i)
+  {  //for each registered task
+    TickSchedTask *const taskPtr = &tickSchedTasksArr[i];
+    if(--taskPtr->countdownVal == 0)
+    {  //task is due; run it
+      taskPtr->countdownVal = taskPtr->periodTicks;
+      (*taskPtr->fnPtr)();
+    }
+  }
+}
+
+//Starts the Timer1 tick interrupts.
+void tickSchedStart()
+{
+  Timer1.initialize(TICKSCHED_TICK_US);          //set timer interval
+  Timer1.attachInterrupt(tickSchedTimerIsr);     //attach service fn
+  tickSchedRunningFlag = true;
+}
+
+//Stops the Timer1 tick interrupts.
+void tickSchedStop()
+{
+  Timer1.detachInterrupt();
+  tickSchedRunningFlag = false;
+}
+
+//Returns true if the Timer1 tick interrupts are running.
+boolean tickSchedIsRunning()
+{
+  return tickSchedRunningFlag;
+}
+
+//Registers a task to be run from the tick interrupt routine.  The task
+// is run on the ticks where the tick count modulo the period equals the
+// phase.  May be called while the ticks are running.
+// fnPtr:  function to be run.
+// periodTicks:  number of ticks between runs (1-255).
+// phaseTicks:  tick offset within period (0 to periodTicks-1).
+// Returns true if successful; false if too many tasks or bad values.
+boolean tickSchedAddTask(TickSchedTaskFn fnPtr, uint8_t periodTicks,
+                                                         uint8_t phaseTicks)
+{
+  if(fnPtr == NULL || periodTicks == 0 || phaseTicks >= periodTicks ||
+                                    tickSchedNumTasks >= TICKSCHED_MAX_TASKS)
+  {
+    return false;
+  }
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+  {  //setup entry and then include it in count
+    TickSchedTask *const taskPtr = &tickSchedTasksArr[tickSchedNumTasks];
+    taskPtr->fnPtr = fnPtr;
+    taskPtr->periodTicks = periodTicks;
+              //ticks until next tick with matching phase:
+    uint8_t cVal = (uint8_t)((phaseTicks + periodTicks -
+                            (uint8_t)(tickSchedTickCount % periodTicks)) %
+                                                               periodTicks);
+    taskPtr->countdownVal = (cVal > 0) ? cVal : periodTicks;
+    ++tickSchedNumTasks;
+  }
+  return true;
+}
+
+//Removes a task registered via 'tickSchedAddTask()'.
+// fnPtr:  function for task.
+void tickSchedRemoveTask(TickSchedTaskFn fnPtr)
+{
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+  {
+    uint8_t numTasks = tickSchedNumTasks;
+    for(uint8_t i=0; i<numTasks; ++i)
+    {  //for each registered task
+      if(tickSchedTasksArr[i].fnPtr == fnPtr)
+      {  //matching entry found; shift remaining entries down
+        --numTasks;
+        for(uint8_t j=i; j<numTasks; ++j)
+          tickSchedTasksArr[j] = tickSchedTasksArr[j+1];
+        tickSchedNumTasks = numTasks;
+        break;
+      }
+    }
+  }
+}
+
+#endif  //TICKSCHED_ENABLED_FLAG
@@ -0,0 +1,33 @@
+//TickSched.h:  Header file for Timer1 tick scheduler.
+//
+// 10/16/2026 -- [ET]
+//
+
+#ifndef TICKSCHED_H_
+#define TICKSCHED_H_
+
+#define TICKSCHED_TICK_US 1000         //time between ticks (us)
+#define TICKSCHED_MAX_TASKS 4          //max # of registered tasks
+    //converts a time in ms to a number of ticks:
+#define TICKSCHED_MS_TO_TICKS(ms) ((uint8_t)(((ms)*1000L)/TICKSCHED_TICK_US))
+
+    //periods and phases (tick offsets within period) for tasks; tasks
+    // with the same period are given different phases so that no more
+    // than one of them runs on any tick:
+#define TICKSCHED_PERIOD_DISPLAY 5     //display multiplexing (ticks)
+#define TICKSCHED_PHASE_DISPLAY 0
+#define TICKSCHED_PERIOD_RSSIOUT 5     //RSSI-output sampling (ticks)
+#define TICKSCHED_PHASE_RSSIOUT 2
+#define TICKSCHED_PERIOD_BUTTONS 5     //button sampling (ticks)
+#define TICKSCHED_PHASE_BUTTONS 4
+
+typedef void (*TickSchedTaskFn)();
+
+void tickSchedStart();
+void tickSchedStop();
+boolean tickSchedIsRunning();
+boolean tickSchedAddTask(TickSchedTaskFn fnPtr, uint8_t periodTicks,
+                                                        uint8_t phaseTicks);
+void tickSchedRemoveTask(TickSchedTaskFn fnPtr);
+
+#endif /* TICKSCHED_H_ */
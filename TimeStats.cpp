@@ -0,0 +1,113 @@
+//TimeStats.cpp:  Operation-timing statistics.  The time taken by each
+//                instrumented operation (see 'TimeStats.h') is measured
+//                via 'micros()' and its count, min, max and mean are
+//                kept, to be shown via the 'XQ' command.  All of this
+//                is compiled out if TIMESTATS_ENABLED_FLAG is false.
+//
+// 10/16/2026 -- [ET]
+//
+
+#include <Arduino.h>
+#include "Config.h"
+#include "TimeStats.h"
+
+#if TIMESTATS_ENABLED_FLAG
+struct TimeStatsEntry
+{
+  uint16_t countVal;                   //# of times measured
+  unsigned long minUs;                 //min time (us)
+  unsigned long maxUs;                 //max time (us)
+  unsigned long totalUs;               //sum of times (us)
+};
+
+TimeStatsEntry timeStatsArr[TSTAT_NUM_OPS];
+char timeStatsCurCmdChar = ' ';        //command being timed
+char timeStatsMaxCmdChar = ' ';        //command with max time
+
+    //names of timed operations (in TSTAT_... order):
+const char timeStatsNamesPArray[] PROGMEM = "Tune write,RSSI wait,"
+                          "RSSI read,Rank sort,Squelch,Report out,Command";
+#endif
+
+//Adds a measured time for an operation.
+// opId:  operation ID (TSTAT_...).
+// timeUs:  time taken, in microseconds.
+void timeStatsAddValue(uint8_t opId, unsigned long timeUs)
+{
+#if TIMESTATS_ENABLED_FLAG
+  TimeStatsEntry &entry = timeStatsArr[opId];
+  if(entry.countVal == 0 || timeUs < entry.minUs)
+    entry.minUs = timeUs;
+  if(timeUs > entry.maxUs)
+  {  //new max time
+    entry.maxUs = timeUs;
+    if(opId == TSTAT_COMMAND)
+      timeStatsMaxCmdChar = timeStatsCurCmdChar;
+  }
+  if(entry.countVal < (uint16_t)0xFFFF)
+  {  //not saturated; add to count and total
+    ++entry.countVal;
+    entry.totalUs += timeUs;
+  }
+#endif
+}
+
+//Sets the character for the command being timed (so the command with
+// the max time may be shown).
+void timeStatsSetCommandChar(char cmdChar)
+{
+#if TIMESTATS_ENABLED_FLAG
+  timeStatsCurCmdChar = cmdChar;
+#endif
+}
+
+//Clears all timing statistics.
+void timeStatsClear()
+{
+#if TIMESTATS_ENABLED_FLAG
+  memset(timeStatsArr,0,sizeof(timeStatsArr));
+  timeStatsMaxCmdChar = ' ';
+#endif
+}
+
+//Shows the timing statistics, one line per operation, as
+// "name:  n=count, min=us, max=us, mean=us".
+void timeStatsShowValues()
+{
+#if TIMESTATS_ENABLED_FLAG
+  int p = 0;
+  char ch;
+  for(uint8_t i=0; i<TSTAT_NUM_OPS; ++i)
+  {  //for each timed operation
+    const TimeStatsEntry &entry = timeStatsArr[i];
+    Serial.print(' ');
+    while((ch=(char)pgm_read_byte_near(timeStatsNamesPArray+p)) != ',' &&
+                                                               ch != '\0')
+    {  //show characters of operation name
+      Serial.print(ch);
+      ++p;
+    }
+    ++p;                //skip past separator
+    Serial.print(F(":  n="));
+    Serial.print(entry.countVal);
+    if(entry.countVal > 0)
+    {
+      Serial.print(F(", min="));
+      Serial.print(entry.minUs);
+      Serial.print(F(", max="));
+      Serial.print(entry.maxUs);
+      if(i == TSTAT_COMMAND)
+      {  //show command with max time
+        Serial.print(F(" ("));
+        Serial.print(timeStatsMaxCmdChar);
+        Serial.print(')');
+      }
+      Serial.print(F(", mean="));
+      Serial.print(entry.totalUs / entry.countVal);
+    }
+    Serial.println();
+  }
+#else
+  Serial.println(F(" Timing statistics not enabled"));
+#endif
+}
@@ -0,0 +1,35 @@
+//TimeStats.h:  Header file for operation-timing statistics.
+//
+// 10/16/2026 -- [ET]
+//
+
+#ifndef TIMESTATS_H_
+#define TIMESTATS_H_
+
+    //timed operations:
+#define TSTAT_TUNEWRITE 0              //RX5808 tune write
+#define TSTAT_RSSIWAIT 1               //wait for RSSI to settle
+#define TSTAT_RSSIREAD 2               //raw-RSSI read
+#define TSTAT_RANKSORT 3               //rebuild of RSSI ranking (sort)
+#define TSTAT_SQUELCH 4                //squelch of adjacent channels
+#define TSTAT_REPORTOUT 5              //formatting of report/sweep output
+#define TSTAT_COMMAND 6                //dispatched serial/button command
+#define TSTAT_NUM_OPS 7
+
+#if TIMESTATS_ENABLED_FLAG
+    //marks start of timed operation (declares local variable):
+#define TIMESTATS_START(varName) const unsigned long varName = micros()
+    //marks end of timed operation:
+#define TIMESTATS_END(opId,varName) \
+                              timeStatsAddValue(opId,micros()-(varName))
+#else
+#define TIMESTATS_START(varName)
+#define TIMESTATS_END(opId,varName)
+#endif
+
+void timeStatsAddValue(uint8_t opId, unsigned long timeUs);
+void timeStatsSetCommandChar(char cmdChar);
+void timeStatsClear();
+void timeStatsShowValues();
+
+#endif /* TIMESTATS_H_ */
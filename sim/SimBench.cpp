@@ -0,0 +1,647 @@
+//SimBench.cpp:  Benchmark suite for the ArduVidRx firmware, run against
+//               the simulated RX5808.  For each scenario (a set of
+//               virtual transmitters) the 'S', 'A', 'N' and 'M' commands
+//               are run and the simulated sweep time, channel-switch
+//               latency and detection accuracy are reported.  Each run
+//               is done in a forked process, so the firmware starts from
+//               its power-up state every time.  In replay mode the 'A'
+//               and 'M' commands are instead run against a raw-RSSI trace
+//               (captured via 'XY') and scored on switch latency, time on
+//               the strongest channel and number of rescans.
+//
+// 10/16/2026 -- [ET]
+//
+
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <Arduino.h>
+#include "Config.h"
+#include "Display7Seg.h"
+#include "SimCore.h"
+#include "SimRx5808.h"
+
+#define SIMBENCH_MAX_TUNES 65536       //max # of tune events logged
+#define SIMBENCH_OUTBUFSIZ 16384       //size of captured-output buffer
+#define SIMBENCH_QUIET_US 300000       //quiet time that ends a command
+#define SIMBENCH_CMDMAX_US 30000000    //max run time per command
+#define SIMBENCH_MON_SECS 2            //interval for monitor ('M') runs
+#define SIMBENCH_DWELL_US 500000       //min time on channel for "dwell"
+#define SIMBENCH_NOISE_RAW 1.0         //RSSI noise for all scenarios
+#define SIMBENCH_SEED 1234             //noise-generator seed
+#define SIMBENCH_MAX_TX 8              //max transmitters per scenario
+#define SIMBENCH_MATCH_MHZ 5           //max offset for detection match
+#define SIMBENCH_SAMPLE_US 10000       //interval for time-on-best sampling
+#define SIMBENCH_SCAN_GAP_US 100000    //max gap between tunes in a scan
+#define SIMBENCH_SCAN_MINTUNES 4       //min # of tunes counted as a scan
+
+    //benchmark scenario (transmitter freqs and levels; 0 ends list):
+struct SimBenchScenario
+{
+  const char *nameStr;
+  uint16_t freqArr[SIMBENCH_MAX_TX];
+  uint8_t levelArr[SIMBENCH_MAX_TX];
+};
+
+const SimBenchScenario simBenchScenariosArr[] = {
+  { "single",   { 5800 },                   { 80 } },
+  { "race4",    { 5658, 5732, 5843, 5917 }, { 70, 60, 50, 40 } },
+  { "adjacent", { 5740, 5760, 5880 },       { 80, 55, 60 } },
+  { "weak",     { 5705, 5800, 5880 },       { 35, 25, 32 } },
+  { "race8",    { 5658, 5695, 5732, 5769, 5806, 5843, 5880, 5917 },
+                { 90, 45, 75, 60, 85, 35, 70, 50 } },
+  { "lband",    { 5362, 5621, 5865 },       { 65, 50, 75 } }
+};
+#define SIMBENCH_NUM_SCENARIOS \
+                 ((int)(sizeof(simBenchScenariosArr)/sizeof(SimBenchScenario)))
+
+const char simBenchCommandsArr[] = "SANM";
+const char simBenchReplayCmdsArr[] = "AM";  //commands run in replay mode
+
+    //results for one scenario/command run:
+struct SimBenchResult
+{
+  double sweepMs;            //time for scan sweep (<0 if none)
+  double switchMs;           //channel-switch latency (<0 if none)
+  unsigned long tuneCount;   //number of tune writes
+  int hitCount;              //expected channels detected
+  int expCount;              //number of expected channels
+  int falseCount;            //channels detected but not expected
+  double onBestPct;          //replay:  % of time on strongest channel
+  int rescanCount;           //replay:  number of scans after the first
+};
+
+    //tune-event log:
+uint16_t simBenchTuneFreqArr[SIMBENCH_MAX_TUNES];
+uint64_t simBenchTuneUsArr[SIMBENCH_MAX_TUNES];
+int simBenchTuneCount = 0;
+
+char simBenchOutBuff[SIMBENCH_OUTBUFSIZ];   //captured serial output
+int simBenchOutLen = 0;
+
+//Logs a tune of the simulated module.
+void simBenchTuneFn(uint16_t freqMhz, uint64_t timeUs)
+{
+  if(simBenchTuneCount < SIMBENCH_MAX_TUNES)
+  {
+    simBenchTuneFreqArr[simBenchTuneCount] = freqMhz;
+    simBenchTuneUsArr[simBenchTuneCount++] = timeUs;
+  }
+}
+
+//Captures a firmware output byte.
+void simBenchOutputFn(uint8_t ch, uint64_t timeUs)
+{
+  if(simBenchOutLen < SIMBENCH_OUTBUFSIZ-1)
+    simBenchOutBuff[simBenchOutLen++] = (char)ch;
+}
+
+//Clears the tune-event log and captured output.
+void simBenchClearLogs()
+{
+  simBenchTuneCount = 0;
+  simBenchOutLen = 0;
+}
+
+//Sends a command and runs the firmware until it is idle.
+void simBenchRunCommand(const char *cmdStr)
+{
+  simSerialQueueInput(cmdStr);
+  simSerialQueueInput("\r");
+  simRunLoopUntilIdle(SIMBENCH_QUIET_US,SIMBENCH_CMDMAX_US);
+}
+
+//Returns true if the given frequency is close enough to the given
+// transmitter frequency to count as a detection of it.
+bool simBenchFreqMatches(uint16_t freqVal, uint16_t txFreq)
+{
+  return (abs((int)freqVal - (int)txFreq) <= SIMBENCH_MATCH_MHZ);
+}
+
+//Returns true if the given frequency is a channel expected to be
+// detected (transmitter level at or above the default min RSSI).
+bool simBenchIsExpectedFreq(const SimBenchScenario &scen, uint16_t freqVal)
+{
+  for(int i=0; i<SIMBENCH_MAX_TX && scen.freqArr[i] > 0; ++i)
+  {
+    if(scen.levelArr[i] >= DEF_MIN_RSSI_LEVEL &&
+                               simBenchFreqMatches(freqVal,scen.freqArr[i]))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+//Scores a set of detected frequencies against the scenario.
+void simBenchScoreFreqs(const SimBenchScenario &scen,
+         const uint16_t *freqArr, int freqCount, SimBenchResult *pResult)
+{
+  pResult->expCount = 0;
+  pResult->hitCount = 0;
+  for(int i=0; i<SIMBENCH_MAX_TX && scen.freqArr[i] > 0; ++i)
+  {
+    if(scen.levelArr[i] < DEF_MIN_RSSI_LEVEL)
+      continue;
+    ++pResult->expCount;
+    for(int j=0; j<freqCount; ++j)
+    {
+      if(simBenchFreqMatches(freqArr[j],scen.freqArr[i]))
+      {
+        ++pResult->hitCount;
+        break;
+      }
+    }
+  }
+  pResult->falseCount = 0;
+  for(int j=0; j<freqCount; ++j)
+  {
+    if(!simBenchIsExpectedFreq(scen,freqArr[j]))
+      ++pResult->falseCount;
+  }
+}
+
+//Adds a frequency to a set (if not already present).
+// Returns the new set count.
+int simBenchAddToSet(uint16_t *setArr, int setCount, uint16_t freqVal)
+{
+  for(int i=0; i<setCount; ++i)
+  {
+    if(setArr[i] == freqVal)
+      return setCount;
+  }
+  setArr[setCount] = freqVal;
+  return setCount + 1;
+}
+
+//Returns the time of the given tune-log entry relative to the given
+// start time, in milliseconds.
+double simBenchTuneMs(int idx, uint64_t startUs)
+{
+  return (simBenchTuneUsArr[idx] - startUs) / 1000.0;
+}
+
+//Runs the 'S' command and parses the channels it reports
+// ("freq=rssi" items).
+void simBenchRunScan(const SimBenchScenario &scen, SimBenchResult *pResult)
+{
+  simBenchRunCommand("S");
+  if(simBenchTuneCount > 1)
+    pResult->sweepMs = simBenchTuneMs(simBenchTuneCount-1,simBenchTuneUsArr[0]);
+  uint16_t freqArr[SIMBENCH_MAX_TUNES];
+  int freqCount = 0;
+  simBenchOutBuff[simBenchOutLen] = '\0';
+  const char *ptr = simBenchOutBuff;
+  unsigned int freqVal, rssiVal;
+  int len;
+  while(*ptr != '\0')
+  {
+    if(sscanf(ptr,"%u=%u%n",&freqVal,&rssiVal,&len) == 2)
+    {
+      freqCount = simBenchAddToSet(freqArr,freqCount,(uint16_t)freqVal);
+      ptr += len;
+    }
+    else
+      ++ptr;
+  }
+  simBenchScoreFreqs(scen,freqArr,freqCount,pResult);
+}
+
+//Runs the 'A' command; checks that it tunes to the strongest channel.
+void simBenchRunAutoTune(const SimBenchScenario &scen,
+                                                    SimBenchResult *pResult)
+{
+  const uint64_t startUs = simGetTimeUs();
+  simBenchRunCommand("A");
+  if(simBenchTuneCount <= 0)
+    return;
+  const int lastIdx = simBenchTuneCount - 1;
+  if(lastIdx > 0)
+    pResult->sweepMs = simBenchTuneMs(lastIdx-1,simBenchTuneUsArr[0]);
+  pResult->switchMs = simBenchTuneMs(lastIdx,startUs);
+  int bestIdx = 0;
+  for(int i=1; i<SIMBENCH_MAX_TX && scen.freqArr[i] > 0; ++i)
+  {
+    if(scen.levelArr[i] > scen.levelArr[bestIdx])
+      bestIdx = i;
+  }
+  pResult->expCount = 1;
+  if(simBenchFreqMatches(simBenchTuneFreqArr[lastIdx],
+                                                 scen.freqArr[bestIdx]))
+  {
+    pResult->hitCount = 1;
+  }
+  else
+    pResult->falseCount = 1;
+}
+
+//Runs the 'N' command enough times to step through all expected
+// channels (plus one).  The sweep time is for the scan done by the
+// first step, and the switch latency is the mean over the later steps.
+void simBenchRunNextChan(const SimBenchScenario &scen,
+                                                    SimBenchResult *pResult)
+{
+  int expCount = 0;
+  for(int i=0; i<SIMBENCH_MAX_TX && scen.freqArr[i] > 0; ++i)
+  {
+    if(scen.levelArr[i] >= DEF_MIN_RSSI_LEVEL)
+      ++expCount;
+  }
+  const int numSteps = (expCount > 1) ? expCount+1 : 2;
+  uint16_t freqArr[SIMBENCH_MAX_TX*2];
+  int freqCount = 0;
+  double sumMs = 0.0;
+  int sumCount = 0;
+  for(int step=0; step<numSteps; ++step)
+  {
+    simBenchClearLogs();
+    const uint64_t startUs = simGetTimeUs();
+    simBenchRunCommand("N");
+    if(simBenchTuneCount <= 0)
+      continue;
+    const int lastIdx = simBenchTuneCount - 1;
+    freqCount = simBenchAddToSet(freqArr,freqCount,
+                                         simBenchTuneFreqArr[lastIdx]);
+    if(step == 0)
+    {
+      if(lastIdx > 0)
+        pResult->sweepMs = simBenchTuneMs(lastIdx-1,simBenchTuneUsArr[0]);
+    }
+    else
+    {
+      sumMs += simBenchTuneMs(lastIdx,startUs);
+      ++sumCount;
+    }
+  }
+  if(sumCount > 0)
+    pResult->switchMs = sumMs / sumCount;
+  simBenchClearLogs();
+  simBenchScoreFreqs(scen,freqArr,freqCount,pResult);
+}
+
+//Finds the monitored channels in the tune log (tunes held for at least
+// SIMBENCH_DWELL_US) and enters the sweep time (for the scan before the
+// first of these) and the mean switch latency (time spent off a
+// monitored channel when moving to the next one) into the result.
+// endUs:  end time for the last tune.
+// freqArr:  array to receive the set of monitored frequencies.
+// Returns the number of frequencies entered into 'freqArr'.
+int simBenchFindDwells(uint64_t endUs, uint16_t *freqArr,
+                                                    SimBenchResult *pResult)
+{
+  int freqCount = 0;
+  int prevDwellIdx = -1;
+  double sumMs = 0.0;
+  int sumCount = 0;
+  for(int i=0; i<simBenchTuneCount; ++i)
+  {
+    const uint64_t nextUs = (i+1 < simBenchTuneCount) ?
+                                        simBenchTuneUsArr[i+1] : endUs;
+    if(nextUs - simBenchTuneUsArr[i] < SIMBENCH_DWELL_US)
+      continue;              //not held long enough to be monitored channel
+    freqCount = simBenchAddToSet(freqArr,freqCount,simBenchTuneFreqArr[i]);
+    if(prevDwellIdx < 0)
+    {  //first monitored channel; measure initial scan
+      if(i > 0)
+        pResult->sweepMs = simBenchTuneMs(i-1,simBenchTuneUsArr[0]);
+    }
+    else
+    {  //time from leaving previous monitored channel to this one
+      sumMs += simBenchTuneMs(i,simBenchTuneUsArr[prevDwellIdx+1]);
+      ++sumCount;
+    }
+    prevDwellIdx = i;
+  }
+  if(sumCount > 0)
+    pResult->switchMs = sumMs / sumCount;
+  return freqCount;
+}
+
+//Runs the 'M' command long enough to cycle through all expected
+// channels.  Tunes held for at least SIMBENCH_DWELL_US are taken as
+// the monitored channels; the sweep time is for the scan before the
+// first of these, and the switch latency is the mean time spent off a
+// monitored channel when moving to the next one.
+void simBenchRunMonitor(const SimBenchScenario &scen,
+                                                    SimBenchResult *pResult)
+{
+  int expCount = 0;
+  for(int i=0; i<SIMBENCH_MAX_TX && scen.freqArr[i] > 0; ++i)
+  {
+    if(scen.levelArr[i] >= DEF_MIN_RSSI_LEVEL)
+      ++expCount;
+  }
+  char cmdStr[16];
+  snprintf(cmdStr,sizeof(cmdStr),"M %d",SIMBENCH_MON_SECS);
+  simSerialQueueInput(cmdStr);
+  simSerialQueueInput("\r");
+  simRunLoopForUs((unsigned long)(expCount+2) * SIMBENCH_MON_SECS*1000000);
+  uint16_t freqArr[SIMBENCH_MAX_TUNES];
+  const int freqCount = simBenchFindDwells(simGetTimeUs(),freqArr,pResult);
+  simBenchScoreFreqs(scen,freqArr,freqCount,pResult);
+}
+
+//Returns the number of scans in the tune log after the first (a scan
+// being at least SIMBENCH_SCAN_MINTUNES tunes with gaps of less than
+// SIMBENCH_SCAN_GAP_US).
+int simBenchCountRescans()
+{
+  int scanCount = 0, runLen = 1;
+  for(int i=1; i<=simBenchTuneCount; ++i)
+  {
+    if(i < simBenchTuneCount &&
+          simBenchTuneUsArr[i] - simBenchTuneUsArr[i-1] < SIMBENCH_SCAN_GAP_US)
+    {  //tune continues current run
+      ++runLen;
+      continue;
+    }
+    if(runLen >= SIMBENCH_SCAN_MINTUNES)
+      ++scanCount;
+    runLen = 1;
+  }
+  return (scanCount > 0) ? scanCount-1 : 0;
+}
+
+//Returns the percentage of time (sampled from 'startUs' to 'endUs') that
+// the receiver was tuned to the strongest channel in the trace, counting
+// only the times when the strongest channel is at or above the default
+// min RSSI (DEF_MIN_RSSI_LEVEL), or -1 if there were no such times.
+// startFreq:  frequency tuned at 'startUs'.
+double simBenchGetOnBestPct(uint64_t startUs, uint64_t endUs,
+                                                        uint16_t startFreq)
+{
+  uint16_t minRaw, maxRaw;
+  simRxGetTraceRawLimits(&minRaw,&maxRaw);
+  const int rangeVal = (maxRaw > minRaw) ? maxRaw - minRaw : 1;
+  uint16_t tunedFreq = startFreq, rawVal;
+  unsigned long sampleCount = 0, onBestCount = 0;
+  int tuneIdx = 0;
+  for(uint64_t timeUs=startUs; timeUs<endUs; timeUs+=SIMBENCH_SAMPLE_US)
+  {
+    while(tuneIdx < simBenchTuneCount &&
+                                      simBenchTuneUsArr[tuneIdx] <= timeUs)
+    {  //advance to tune in effect at sample time
+      tunedFreq = simBenchTuneFreqArr[tuneIdx++];
+    }
+    const uint16_t bestFreq = simRxGetTraceBestFreq(timeUs*1000,&rawVal);
+    if(bestFreq == 0 ||
+          ((int)rawVal - (int)minRaw) * 100 / rangeVal < DEF_MIN_RSSI_LEVEL)
+    {
+      continue;              //no channel with signal at this time
+    }
+    ++sampleCount;
+    if(simBenchFreqMatches(tunedFreq,bestFreq))
+      ++onBestCount;
+  }
+  return (sampleCount > 0) ? onBestCount * 100.0 / sampleCount : -1.0;
+}
+
+//Sets up the simulated hardware and runs the firmware power-up, with
+// the given raw-RSSI scaling values (and auto-calibration disabled).
+void simBenchStartFirmware(uint16_t minRaw, uint16_t maxRaw)
+{
+  simSetPinInputLevel(DISP7SEG_B_PIN,HIGH);      //display connected
+  simSetPinInputLevel(DISP7SEG_D_PIN,HIGH);
+  simSetPinInputLevel(DISP7SEG_F_PIN,HIGH);
+  simSetSerialOutputFn(simBenchOutputFn);
+  simRxSetTuneFn(simBenchTuneFn);
+  setup();
+  simRunLoopUntilIdle(SIMBENCH_QUIET_US,SIMBENCH_CMDMAX_US);
+  char cmdStr[32];
+  snprintf(cmdStr,sizeof(cmdStr),"XJ %d,%d",minRaw,maxRaw);
+  simBenchRunCommand("XA 0");
+  simBenchRunCommand(cmdStr);
+  simBenchClearLogs();
+}
+
+//Runs one command against the loaded raw-RSSI trace (in the current
+// process), for the duration of the trace.
+void simBenchRunReplayOne(char cmdChar, SimBenchResult *pResult)
+{
+  uint16_t minRaw, maxRaw;
+  simRxGetTraceRawLimits(&minRaw,&maxRaw);
+  simBenchStartFirmware(minRaw,maxRaw);
+  const uint16_t startFreq = simRxGetTunedFreq();
+  const uint64_t startUs = simGetTimeUs();
+  simRxSetTraceStartTime(simGetTimeNs());
+  simSerialQueueInput((cmdChar == 'M') ? "M" : "A");
+  simSerialQueueInput("\r");
+  simRunLoopForUs(simRxGetTraceDurationMs()*1000);
+  const uint64_t endUs = simGetTimeUs();
+  if(cmdChar == 'M')
+  {
+    uint16_t freqArr[SIMBENCH_MAX_TUNES];
+    simBenchFindDwells(endUs,freqArr,pResult);
+  }
+  else if(simBenchTuneCount > 0)
+  {  //'A'; measure time to tune of selected channel
+    pResult->switchMs = simBenchTuneMs(simBenchTuneCount-1,startUs);
+  }
+  pResult->onBestPct = simBenchGetOnBestPct(startUs,endUs,startFreq);
+  pResult->rescanCount = simBenchCountRescans();
+  pResult->tuneCount = (unsigned long)simBenchTuneCount;
+}
+
+//Runs one command for one scenario (in the current process).
+void simBenchRunOne(const SimBenchScenario &scen, char cmdChar,
+                                                    SimBenchResult *pResult)
+{
+  for(int i=0; i<SIMBENCH_MAX_TX && scen.freqArr[i] > 0; ++i)
+    simRxAddTransmitter(scen.freqArr[i],scen.levelArr[i],0,0);
+  simRxSetNoise(SIMBENCH_NOISE_RAW);
+  simRxSetSeed(SIMBENCH_SEED);
+         //use fixed RSSI scaling matching the simulated module (so the
+         // reported RSSI values equal the transmitter levels):
+  simBenchStartFirmware(SIMRX_DEF_FLOOR_RAW,SIMRX_DEF_FULL_RAW);
+  const unsigned long tuneCountStart = simRxGetTuneCount();
+  switch(cmdChar)
+  {
+    case 'S':
+      simBenchRunScan(scen,pResult);
+      break;
+    case 'A':
+      simBenchRunAutoTune(scen,pResult);
+      break;
+    case 'N':
+      simBenchRunNextChan(scen,pResult);
+      break;
+    case 'M':
+      simBenchRunMonitor(scen,pResult);
+      break;
+  }
+  pResult->tuneCount = simRxGetTuneCount() - tuneCountStart;
+}
+
+//Runs one command for one scenario (or, if 'scenPtr' is NULL, against
+// the loaded raw-RSSI trace) in a forked process.
+// Returns true if successful; false if error.
+bool simBenchRunForked(const SimBenchScenario *scenPtr, char cmdChar,
+                                                    SimBenchResult *pResult)
+{
+  int pipeFds[2];
+  if(pipe(pipeFds) != 0)
+    return false;
+  fflush(stdout);
+  const pid_t pid = fork();
+  if(pid < 0)
+    return false;
+  if(pid == 0)
+  {  //child process
+    close(pipeFds[0]);
+    SimBenchResult result = { -1.0, -1.0, 0, 0, 0, 0, -1.0, 0 };
+    if(scenPtr != NULL)
+      simBenchRunOne(*scenPtr,cmdChar,&result);
+    else
+      simBenchRunReplayOne(cmdChar,&result);
+    const bool okFlag = (write(pipeFds[1],&result,sizeof(result)) ==
+                                                   (ssize_t)sizeof(result));
+    _exit(okFlag ? 0 : 1);
+  }
+  close(pipeFds[1]);
+  const bool okFlag = (read(pipeFds[0],pResult,sizeof(*pResult)) ==
+                                                 (ssize_t)sizeof(*pResult));
+  close(pipeFds[0]);
+  int status;
+  waitpid(pid,&status,0);
+  return okFlag && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+//Formats a time value (or "-" if none) into the given buffer.
+const char *simBenchFmtMs(double val, char *buff, size_t buffLen)
+{
+  if(val < 0.0)
+    snprintf(buff,buffLen,"-");
+  else
+    snprintf(buff,buffLen,"%.1f",val);
+  return buff;
+}
+
+//Runs the replay-mode commands against the loaded raw-RSSI trace and
+// shows the results.
+// Returns the number of runs that failed.
+int simBenchRunReplay(const char *traceName, const char *cmdsStr)
+{
+  printf("Trace:  %s (%.1f secs)\n",traceName,
+                                         simRxGetTraceDurationMs()/1000.0);
+  printf("%-3s %10s %9s %7s %6s\n","Cmd","Switch(ms)","OnBest(%)",
+                                                         "Rescans","Tunes");
+  char buff1[24], buff2[24];
+  int errCount = 0;
+  for(const char *cPtr=cmdsStr; *cPtr != '\0'; ++cPtr)
+  {
+    const char cmdChar = (char)toupper(*cPtr);
+    if(strchr(simBenchReplayCmdsArr,cmdChar) == NULL)
+      continue;
+    SimBenchResult result;
+    if(!simBenchRunForked(NULL,cmdChar,&result))
+    {
+      printf("%-3c  (run failed)\n",cmdChar);
+      ++errCount;
+      continue;
+    }
+    printf("%-3c %10s %9s %7d %6lu\n",cmdChar,
+                 simBenchFmtMs(result.switchMs,buff1,sizeof(buff1)),
+                 simBenchFmtMs(result.onBestPct,buff2,sizeof(buff2)),
+                 result.rescanCount,result.tuneCount);
+  }
+  return errCount;
+}
+
+int main(int argc, char **argv)
+{
+  const char *cmdsStr = simBenchCommandsArr;
+  const char *scenStr = NULL;
+  const char *traceName = NULL;
+  bool cmdsFlag = false;
+  for(int i=1; i<argc; ++i)
+  {
+    if(strcmp(argv[i],"-c") == 0 && i+1 < argc)
+    {
+      cmdsStr = argv[++i];
+      cmdsFlag = true;
+    }
+    else if(strcmp(argv[i],"-s") == 0 && i+1 < argc)
+      scenStr = argv[++i];
+    else if(strcmp(argv[i],"-r") == 0 && i+1 < argc)
+      traceName = argv[++i];
+    else
+    {
+      fprintf(stderr,"Usage: arduvidbench [-c commands] [-s scenario] "
+                                                               "[-r trace]\n"
+                     "  -c commands  Commands to run (default \"%s\", or "
+                                                 "\"%s\" with '-r')\n"
+                     "  -s scenario  Run only the named scenario\n"
+                     "  -r trace     Replay raw-RSSI trace (captured via "
+                                                               "'XY')\n",
+                     simBenchCommandsArr,simBenchReplayCmdsArr);
+      return 1;
+    }
+  }
+  if(traceName != NULL)
+  {  //replay mode
+    if(!simRxLoadTrace(traceName))
+      return 1;
+    return (simBenchRunReplay(traceName,cmdsFlag ? cmdsStr :
+                                        simBenchReplayCmdsArr) > 0) ? 1 : 0;
+  }
+  printf("%-9s %-3s %9s %10s %6s %8s\n","Scenario","Cmd","Sweep(ms)",
+                                       "Switch(ms)","Tunes","Detect");
+  double sweepSumArr[4] = { 0 }, switchSumArr[4] = { 0 };
+  int sweepCntArr[4] = { 0 }, switchCntArr[4] = { 0 };
+  int hitSumArr[4] = { 0 }, expSumArr[4] = { 0 }, falseSumArr[4] = { 0 };
+  char buff1[24], buff2[24], buff3[24];
+  int errCount = 0;
+  for(int s=0; s<SIMBENCH_NUM_SCENARIOS; ++s)
+  {
+    const SimBenchScenario &scen = simBenchScenariosArr[s];
+    if(scenStr != NULL && strcmp(scenStr,scen.nameStr) != 0)
+      continue;
+    for(const char *cPtr=cmdsStr; *cPtr != '\0'; ++cPtr)
+    {
+      const char *posPtr = strchr(simBenchCommandsArr,toupper(*cPtr));
+      if(posPtr == NULL)
+        continue;
+      const int c = (int)(posPtr - simBenchCommandsArr);
+      SimBenchResult result;
+      if(!simBenchRunForked(&scen,*posPtr,&result))
+      {
+        printf("%-9s %-3c  (run failed)\n",scen.nameStr,*posPtr);
+        ++errCount;
+        continue;
+      }
+      snprintf(buff3,sizeof(buff3),"%d/%d +%d",result.hitCount,
+                                     result.expCount,result.falseCount);
+      printf("%-9s %-3c %9s %10s %6lu %8s\n",scen.nameStr,*posPtr,
+                  simBenchFmtMs(result.sweepMs,buff1,sizeof(buff1)),
+                  simBenchFmtMs(result.switchMs,buff2,sizeof(buff2)),
+                  result.tuneCount,buff3);
+      if(result.sweepMs >= 0.0)
+      {
+        sweepSumArr[c] += result.sweepMs;
+        ++sweepCntArr[c];
+      }
+      if(result.switchMs >= 0.0)
+      {
+        switchSumArr[c] += result.switchMs;
+        ++switchCntArr[c];
+      }
+      hitSumArr[c] += result.hitCount;
+      expSumArr[c] += result.expCount;
+      falseSumArr[c] += result.falseCount;
+    }
+  }
+  printf("\nSummary (means over scenarios):\n");
+  for(int c=0; c<4; ++c)
+  {
+    if(expSumArr[c] == 0 && sweepCntArr[c] == 0)
+      continue;
+    printf("  %c:  sweep=%s ms, switch=%s ms, detected=%d/%d, false=%d\n",
+         simBenchCommandsArr[c],
+         simBenchFmtMs((sweepCntArr[c] > 0) ?
+                       sweepSumArr[c]/sweepCntArr[c] : -1.0,buff1,sizeof(buff1)),
+         simBenchFmtMs((switchCntArr[c] > 0) ?
+                       switchSumArr[c]/switchCntArr[c] : -1.0,buff2,sizeof(buff2)),
+         hitSumArr[c],expSumArr[c],falseSumArr[c]);
+  }
+  return (errCount > 0) ? 1 : 0;
+}
@@ -0,0 +1,723 @@
+//SimCore.cpp:  Host-simulation core.  Provides the Arduino-core, EEPROM
+//              and TimerOne functions used by the firmware, running
+//              against a virtual clock (in nanoseconds).  Each call into
+//              this layer is charged its approximate time on a 16MHz
+//              ATmega328 (firmware code between calls takes no time),
+//              and the Timer1, ADC and pin-change interrupt routines are
+//              run as the clock passes their due times (while the
+//              simulated global-interrupt-enable bit is set).
+//
+// 10/16/2026 -- [ET]
+//
+
+#include <stdio.h>
+#include <Arduino.h>
+#include <EEPROM.h>
+#include "TimerOne.h"
+#include "SimRx5808.h"
+#include "SimCore.h"
+
+    //approximate times for calls on a 16MHz ATmega328 (nanoseconds):
+#define SIM_DIGITALWRITE_NS 3600
+#define SIM_DIGITALREAD_NS 3200
+#define SIM_PINMODE_NS 3800
+#define SIM_PORTWRITE_NS 125           //'sbi'/'cbi' (2 cycles)
+#define SIM_ANALOGREAD_NS 112000       //13 ADC clocks + overhead
+#define SIM_MICROS_NS 3600
+#define SIM_MILLIS_NS 1900
+#define SIM_SERIALWRITE_NS 5000        //put byte into transmit buffer
+#define SIM_SERIALREAD_NS 2500
+#define SIM_SERIALAVAIL_NS 1200
+#define SIM_EEPROMREAD_NS 1000
+#define SIM_EEPROMWRITE_NS 3400000     //EEPROM erase+write time
+#define SIM_ISRENTRY_NS 2500           //ISR entry/exit (register saves)
+#define SIM_LOOPPASS_NS 10000          //fixed charge per 'loop()' pass
+#define SIM_ADC_PERIOD_NS 104000       //free-running ADC (prescaler 128)
+
+    //'ADCSRA' bits set while the ADC is free running:
+#define SIM_ADC_RUNBITS (_BV(ADEN) | _BV(ADSC) | _BV(ADATE) | _BV(ADIE))
+
+    //AVR registers:
+SimPortReg PORTB(8), PORTC(14), PORTD(0);
+volatile uint8_t DDRB = 0, DDRC = 0, DDRD = 0;
+volatile uint8_t ADMUX = 0, ADCSRA = 0, ADCSRB = 0, ADCL = 0, ADCH = 0;
+volatile uint8_t SPCR = 0, SPSR = 0, SPDR = 0;
+volatile bool simIntsEnabledFlag = true;
+
+HardwareSerial Serial;
+EEPROMClass EEPROM;
+TimerOne Timer1;
+
+extern "C" void simAdcVectIsr(void) __attribute__((weak));
+
+uint64_t simTimeNs = 0;                //virtual time
+bool simInIsrFlag = false;             //true while running an ISR
+
+uint8_t simPinModeArr[SIM_NUM_PINS];   //mode for each pin
+uint8_t simPinOutArr[SIM_NUM_PINS];    //output (or pullup) level
+uint8_t simPinExtArr[SIM_NUM_PINS];    //external level+1 (0 == floating)
+
+void (*simExtIntFnArr[2])() = { NULL, NULL };  //INT0/INT1 routines
+bool simExtIntPendingArr[2] = { false, false };
+
+uint64_t simTimer1NextNs = 0;          //next Timer1 interrupt
+unsigned long simTimer1PeriodUs = 1000000;
+bool simTimer1EnabledFlag = false;
+
+uint64_t simAdcNextNs = 0;             //next ADC conversion complete
+bool simAdcRunningFlag = false;
+
+unsigned long simSerialByteNs = 86806;      //time per byte at baud rate
+uint8_t simTxRingArr[SIM_SERIAL_TXBUFSIZ];  //bytes awaiting transmit
+uint64_t simTxDoneNsArr[SIM_SERIAL_TXBUFSIZ];    //transmit-complete times
+uint8_t simTxHead = 0, simTxCount = 0;
+uint64_t simTxLastDoneNs = 0;          //completion time of last byte
+uint64_t simLastSerialOutNs = 0;       //time last byte was sent
+void (*simSerialOutFn)(uint8_t ch, uint64_t timeUs) = NULL;
+
+char simRxQueueArr[SIM_SERIAL_INMAXLEN];    //queued input bytes
+uint64_t simRxArriveNsArr[SIM_SERIAL_INMAXLEN];  //input-byte arrival times
+int simRxHead = 0, simRxCount = 0;
+
+uint8_t simEepromArr[SIM_EEPROM_SIZE];
+bool simEepromInitFlag = false;
+
+unsigned long simLoopPassCount = 0;
+
+void simAdvanceToNs(uint64_t targetNs);
+
+//Returns the current virtual time, in nanoseconds.
+uint64_t simGetTimeNs()
+{
+  return simTimeNs;
+}
+
+//Returns the current virtual time, in microseconds.
+uint64_t simGetTimeUs()
+{
+  return simTimeNs / 1000;
+}
+
+//Advances the virtual clock by the given time (the cost of an
+// operation), running any interrupt routines that come due.
+void simChargeNs(unsigned long timeNs)
+{
+  simAdvanceToNs(simTimeNs + timeNs);
+}
+
+//Advances the virtual clock by the given time without running 'loop()'.
+void simRunForUs(unsigned long timeUs)
+{
+  simAdvanceToNs(simTimeNs + (uint64_t)timeUs*1000);
+}
+
+//Passes on bytes whose transmit times have been reached.
+void simDrainSerialOutput()
+{
+  while(simTxCount > 0 && simTxDoneNsArr[simTxHead] <= simTimeNs)
+  {
+    simLastSerialOutNs = simTxDoneNsArr[simTxHead];
+    if(simSerialOutFn != NULL)
+      (*simSerialOutFn)(simTxRingArr[simTxHead],simLastSerialOutNs/1000);
+    simTxHead = (uint8_t)((simTxHead + 1) % SIM_SERIAL_TXBUFSIZ);
+    --simTxCount;
+  }
+}
+
+//Updates the ADC free-running state from the 'ADCSRA' register.
+void simCheckAdcState()
+{
+  const bool runFlag = ((ADCSRA & SIM_ADC_RUNBITS) == SIM_ADC_RUNBITS);
+  if(runFlag && !simAdcRunningFlag)
+    simAdcNextNs = simTimeNs + SIM_ADC_PERIOD_NS;
+  simAdcRunningFlag = runFlag;
+}
+
+//Runs an interrupt routine (with interrupts disabled).
+void simRunIsr(void (*isrFn)())
+{
+  simIntsEnabledFlag = false;
+  simInIsrFlag = true;
+  simChargeNs(SIM_ISRENTRY_NS);
+  (*isrFn)();
+  simInIsrFlag = false;
+  simIntsEnabledFlag = true;
+}
+
+//Completes an ADC conversion and runs the ADC interrupt routine.
+void simAdcConversionIsr()
+{
+  const uint16_t val = simRxReadRawRssi((uint8_t)(A0 + (ADMUX & 0x07)),
+                                                                simTimeNs);
+  ADCL = (uint8_t)val;
+  ADCH = (uint8_t)(val >> 8);
+  if(simAdcVectIsr != NULL)
+    simAdcVectIsr();
+}
+
+//Runs the Timer1 interrupt routine.
+void simTimer1Isr()
+{
+  if(Timer1.isrCallback != NULL)
+    Timer1.isrCallback();
+}
+
+//Advances the virtual clock to the given time.  If interrupts are
+// enabled, due interrupt routines are run (in AVR vector-priority
+// order) at their due times; otherwise they remain pending.  Periodic
+// interrupts that are held off longer than a period are merged (as on
+// the AVR).
+void simAdvanceToNs(uint64_t targetNs)
+{
+  while(true)
+  {
+    simCheckAdcState();
+    if(!simIntsEnabledFlag || simInIsrFlag)
+      break;
+    int extIdx = -1;
+    for(int i=0; i<2; ++i)
+    {
+      if(simExtIntPendingArr[i])
+      {
+        extIdx = i;
+        break;
+      }
+    }
+    if(extIdx >= 0)
+    {  //external interrupt pending (highest priority)
+      simExtIntPendingArr[extIdx] = false;
+      if(simExtIntFnArr[extIdx] != NULL)
+        simRunIsr(simExtIntFnArr[extIdx]);
+      continue;
+    }
+    uint64_t dueNs = targetNs + 1;
+    int srcId = 0;
+    if(simTimer1EnabledFlag && simTimer1NextNs < dueNs)
+    {
+      dueNs = simTimer1NextNs;
+      srcId = 1;
+    }
+    if(simAdcRunningFlag && simAdcNextNs < dueNs)
+    {
+      dueNs = simAdcNextNs;
+      srcId = 2;
+    }
+    if(srcId == 0)
+      break;
+    if(dueNs > simTimeNs)
+    {
+      simTimeNs = dueNs;
+      simDrainSerialOutput();
+    }
+    if(srcId == 1)
+    {
+      const uint64_t periodNs = (uint64_t)simTimer1PeriodUs * 1000;
+      do
+        simTimer1NextNs += periodNs;
+      while(simTimer1NextNs <= simTimeNs);
+      simRunIsr(simTimer1Isr);
+    }
+    else
+    {
+      do
+        simAdcNextNs += SIM_ADC_PERIOD_NS;
+      while(simAdcNextNs <= simTimeNs);
+      simRunIsr(simAdcConversionIsr);
+    }
+  }
+  if(targetNs > simTimeNs)
+    simTimeNs = targetNs;
+  simDrainSerialOutput();
+}
+
+//Returns the level seen on the given pin.
+int simGetPinLevel(uint8_t pin)
+{
+  if(pin >= SIM_NUM_PINS)
+    return LOW;
+  if(simPinModeArr[pin] == OUTPUT)
+    return simPinOutArr[pin];
+  if(simPinExtArr[pin] > 0)
+    return simPinExtArr[pin] - 1;
+  return (simPinModeArr[pin] == INPUT_PULLUP) ? HIGH : LOW;
+}
+
+//Sets the external level on an input pin (i.e., a button press or a
+// pullup via a display segment).
+// level:  HIGH, LOW, or -1 for floating.
+void simSetPinInputLevel(uint8_t pin, int level)
+{
+  if(pin >= SIM_NUM_PINS)
+    return;
+  const int oldLevel = simGetPinLevel(pin);
+  simPinExtArr[pin] = (level >= 0) ? (uint8_t)(level + 1) : (uint8_t)0;
+  if((pin == 2 || pin == 3) && simGetPinLevel(pin) != oldLevel)
+    simExtIntPendingArr[pin-2] = true;  //pin change (CHANGE mode only)
+}
+
+//Handles a change to a pin output level (from 'digitalWrite()' or a
+// port-register write).
+void simPinOutputChanged(uint8_t pin, uint8_t val)
+{
+  if(pin >= SIM_NUM_PINS)
+    return;
+  simPinOutArr[pin] = val;
+  if(simPinModeArr[pin] == OUTPUT)
+    simRxPinWrite(pin,val,simTimeNs);
+}
+
+//Writes a value to a port-output register (direct-port write).
+void SimPortReg::setValue(uint8_t val)
+{
+  const uint8_t chgBits = regVal ^ val;
+  regVal = val;
+  simChargeNs(SIM_PORTWRITE_NS);
+  for(uint8_t b=0; b<8; ++b)
+  {
+    if(chgBits & (uint8_t)(1 << b))
+      simPinOutputChanged((uint8_t)(firstPinNum+b),(val >> b) & 1);
+  }
+}
+
+//Returns the mode/output registers and bit mask for the given pin.
+void simGetPinRegs(uint8_t pin, volatile uint8_t **pDdr,
+                                   SimPortReg **pPort, uint8_t *pMask)
+{
+  if(pin < 8)
+  {
+    *pDdr = &DDRD;
+    *pPort = &PORTD;
+  }
+  else if(pin < 14)
+  {
+    *pDdr = &DDRB;
+    *pPort = &PORTB;
+  }
+  else
+  {
+    *pDdr = &DDRC;
+    *pPort = &PORTC;
+  }
+  *pMask = digitalPinToBitMask(pin);
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  simChargeNs(SIM_PINMODE_NS);
+  if(pin >= SIM_NUM_PINS)
+    return;
+  simPinModeArr[pin] = mode;
+  if(pin >= NUM_DIGITAL_PINS)
+    return;
+  volatile uint8_t *ddrPtr;
+  SimPortReg *portPtr;
+  uint8_t mask;
+  simGetPinRegs(pin,&ddrPtr,&portPtr,&mask);
+  if(mode == OUTPUT)
+    *ddrPtr |= mask;
+  else
+  {
+    *ddrPtr &= (uint8_t)~mask;
+    simPinOutArr[pin] = (mode == INPUT_PULLUP) ? HIGH : LOW;
+    if(mode == INPUT_PULLUP)
+      portPtr->regVal |= mask;
+    else
+      portPtr->regVal &= (uint8_t)~mask;
+  }
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+  simChargeNs(SIM_DIGITALWRITE_NS);
+  if(pin >= NUM_DIGITAL_PINS)
+    return;
+  volatile uint8_t *ddrPtr;
+  SimPortReg *portPtr;
+  uint8_t mask;
+  simGetPinRegs(pin,&ddrPtr,&portPtr,&mask);
+  if(val != LOW)
+    portPtr->regVal |= mask;
+  else
+    portPtr->regVal &= (uint8_t)~mask;
+  if(simPinModeArr[pin] == INPUT && val != LOW)
+    simPinModeArr[pin] = INPUT_PULLUP;      //write to input sets pullup
+  else if(simPinModeArr[pin] == INPUT_PULLUP && val == LOW)
+    simPinModeArr[pin] = INPUT;
+  simPinOutputChanged(pin,(val != LOW) ? HIGH : LOW);
+}
+
+int digitalRead(uint8_t pin)
+{
+  simChargeNs(SIM_DIGITALREAD_NS);
+  return simGetPinLevel(pin);
+}
+
+int analogRead(uint8_t pin)
+{
+  simChargeNs(SIM_ANALOGREAD_NS);
+  return simRxReadRawRssi(pin,simTimeNs);
+}
+
+void analogWrite(uint8_t pin, int val)
+{
+  pinMode(pin,OUTPUT);
+}
+
+void attachInterrupt(uint8_t intNum, void (*isr)(), int mode)
+{
+  if(intNum < 2)
+    simExtIntFnArr[intNum] = isr;
+}
+
+void detachInterrupt(uint8_t intNum)
+{
+  if(intNum < 2)
+    simExtIntFnArr[intNum] = NULL;
+}
+
+unsigned long micros()
+{
+  simChargeNs(SIM_MICROS_NS);
+  return (unsigned long)(simTimeNs / 1000);
+}
+
+unsigned long millis()
+{
+  simChargeNs(SIM_MILLIS_NS);
+  return (unsigned long)(simTimeNs / 1000000);
+}
+
+void delay(unsigned long ms)
+{
+  simChargeNs(ms*1000000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  simChargeNs((unsigned long)us*1000);
+}
+
+void simDelayCycles(unsigned long cycles)
+{
+  simChargeNs((unsigned long)(cycles*SIM_NS_PER_CYCLE));
+}
+
+long map(long x, long inMin, long inMax, long outMin, long outMax)
+{
+  if(inMax == inMin)         //(AVR division by zero does not trap)
+    return outMin;
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+//Converts an unsigned value to a string in the given radix.
+char *simUltoa(unsigned long val, char *str, int radix, bool negFlag)
+{
+  char buff[70];
+  int p = 0;
+  do
+  {
+    const int digVal = (int)(val % radix);
+    buff[p++] = (char)((digVal < 10) ? ('0' + digVal) : ('a' + digVal - 10));
+    val /= radix;
+  }
+  while(val > 0);
+  int q = 0;
+  if(negFlag)
+    str[q++] = '-';
+  while(p > 0)
+    str[q++] = buff[--p];
+  str[q] = '\0';
+  return str;
+}
+
+char *itoa(int val, char *str, int radix)
+{
+  return ltoa(val,str,radix);
+}
+
+char *ltoa(long val, char *str, int radix)
+{
+  if(radix == 10 && val < 0)
+    return simUltoa((unsigned long)-val,str,radix,true);
+  return simUltoa((radix == 10) ? (unsigned long)val :
+                   (unsigned long)(uint32_t)val,str,radix,false);
+}
+
+char *utoa(unsigned int val, char *str, int radix)
+{
+  return simUltoa(val,str,radix,false);
+}
+
+char *ultoa(unsigned long val, char *str, int radix)
+{
+  return simUltoa(val,str,radix,false);
+}
+
+
+/*###########################################################################*/
+
+
+//Queues the given string as serial input; the bytes arrive at the
+// serial-port rate after any previously-queued bytes.
+void simSerialQueueInput(const char *str)
+{
+  uint64_t arriveNs = simTimeNs;
+  if(simRxCount > 0)
+  {
+    const int lastIdx = (simRxHead + simRxCount - 1) % SIM_SERIAL_INMAXLEN;
+    if(simRxArriveNsArr[lastIdx] > arriveNs)
+      arriveNs = simRxArriveNsArr[lastIdx];
+  }
+  while(*str != '\0' && simRxCount < SIM_SERIAL_INMAXLEN)
+  {
+    arriveNs += simSerialByteNs;
+    const int idx = (simRxHead + simRxCount) % SIM_SERIAL_INMAXLEN;
+    simRxQueueArr[idx] = *str++;
+    simRxArriveNsArr[idx] = arriveNs;
+    ++simRxCount;
+  }
+}
+
+//Returns the number of queued input bytes not yet read by the firmware.
+int simSerialGetInputPendingCount()
+{
+  return simRxCount;
+}
+
+//Sets the function called for each byte sent by the firmware (at the
+// time its transmission is completed).
+void simSetSerialOutputFn(void (*outFn)(uint8_t ch, uint64_t timeUs))
+{
+  simSerialOutFn = outFn;
+}
+
+//Returns the time (in microseconds) that the last output byte was sent.
+uint64_t simGetLastSerialOutUs()
+{
+  return simLastSerialOutNs / 1000;
+}
+
+//Returns true if there are no output bytes waiting to be sent.
+bool simIsSerialOutputIdle()
+{
+  return (simTxCount == 0);
+}
+
+void HardwareSerial::begin(unsigned long baud)
+{
+  simSerialByteNs = (unsigned long)(10000000000ULL / baud);  //10 bits/byte
+}
+
+int HardwareSerial::available()
+{
+  simChargeNs(SIM_SERIALAVAIL_NS);
+  int count = 0;
+  while(count < simRxCount && count < SIM_SERIAL_RXBUFSIZ-1 &&
+         simRxArriveNsArr[(simRxHead+count)%SIM_SERIAL_INMAXLEN] <= simTimeNs)
+  {
+    ++count;
+  }
+  return count;
+}
+
+int HardwareSerial::peek()
+{
+  if(simRxCount <= 0 || simRxArriveNsArr[simRxHead] > simTimeNs)
+    return -1;
+  return (uint8_t)simRxQueueArr[simRxHead];
+}
+
+int HardwareSerial::read()
+{
+  simChargeNs(SIM_SERIALREAD_NS);
+  const int val = peek();
+  if(val >= 0)
+  {
+    simRxHead = (simRxHead + 1) % SIM_SERIAL_INMAXLEN;
+    --simRxCount;
+  }
+  return val;
+}
+
+int HardwareSerial::availableForWrite()
+{
+  simChargeNs(SIM_SERIALAVAIL_NS);
+      //one byte may be in the shift register; one buffer slot unused:
+  const int bufCount = (simTxCount > 0) ? simTxCount-1 : 0;
+  return SIM_SERIAL_TXBUFSIZ - 1 - bufCount;
+}
+
+void HardwareSerial::flush()
+{
+  if(simTxCount > 0)
+    simAdvanceToNs(simTxLastDoneNs);
+}
+
+size_t HardwareSerial::write(uint8_t val)
+{
+  simChargeNs(SIM_SERIALWRITE_NS);
+  while(simTxCount >= SIM_SERIAL_TXBUFSIZ)  //if buffer full then wait
+    simAdvanceToNs(simTxDoneNsArr[simTxHead]);
+  const uint64_t startNs = (simTxLastDoneNs > simTimeNs) ?
+                                                simTxLastDoneNs : simTimeNs;
+  simTxLastDoneNs = startNs + simSerialByteNs;
+  const int idx = (simTxHead + simTxCount) % SIM_SERIAL_TXBUFSIZ;
+  simTxRingArr[idx] = val;
+  simTxDoneNsArr[idx] = simTxLastDoneNs;
+  ++simTxCount;
+  return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buf, size_t len)
+{
+  for(size_t i=0; i<len; ++i)
+    write(buf[i]);
+  return len;
+}
+
+size_t HardwareSerial::print(long val, int base)
+{
+  char buff[70];
+  return write(ltoa(val,buff,base));
+}
+
+size_t HardwareSerial::print(unsigned long val, int base)
+{
+  char buff[70];
+  return write(ultoa(val,buff,base));
+}
+
+size_t HardwareSerial::print(double val, int digits)
+{
+  char buff[40];
+  snprintf(buff,sizeof(buff),"%.*f",digits,val);
+  return write(buff);
+}
+
+
+/*###########################################################################*/
+
+
+uint8_t EEPROMClass::read(int addr)
+{
+  simChargeNs(SIM_EEPROMREAD_NS);
+  if(!simEepromInitFlag)
+  {  //first access; set to erased state
+    memset(simEepromArr,0xFF,sizeof(simEepromArr));
+    simEepromInitFlag = true;
+  }
+  return (addr >= 0 && addr < SIM_EEPROM_SIZE) ? simEepromArr[addr] : 0xFF;
+}
+
+void EEPROMClass::write(int addr, uint8_t val)
+{
+  read(addr);                          //make sure initialized
+  simChargeNs(SIM_EEPROMWRITE_NS);
+  if(addr >= 0 && addr < SIM_EEPROM_SIZE)
+    simEepromArr[addr] = val;
+}
+
+
+/*###########################################################################*/
+
+
+void TimerOne::initialize(long microseconds)
+{
+  isrCallback = NULL;
+  setPeriod(microseconds);
+}
+
+void TimerOne::setPeriod(long microseconds)
+{
+  simTimer1PeriodUs = (microseconds > 0) ? (unsigned long)microseconds : 1;
+  simTimer1NextNs = simTimeNs + (uint64_t)simTimer1PeriodUs*1000;
+}
+
+void TimerOne::attachInterrupt(void (*isr)(), long microseconds)
+{
+  if(microseconds > 0)
+    setPeriod(microseconds);
+  isrCallback = isr;
+  simTimer1EnabledFlag = true;
+}
+
+void TimerOne::detachInterrupt()
+{
+  simTimer1EnabledFlag = false;
+}
+
+void TimerOne::start()
+{
+  simTimer1NextNs = simTimeNs + (uint64_t)simTimer1PeriodUs*1000;
+}
+
+void TimerOne::stop()
+{
+}
+
+void TimerOne::restart()
+{
+  start();
+}
+
+void TimerOne::resume()
+{
+}
+
+unsigned long TimerOne::read()
+{
+  return 0;
+}
+
+void TimerOne::pwm(char pin, int duty, long microseconds)
+{
+}
+
+void TimerOne::disablePwm(char pin)
+{
+}
+
+void TimerOne::setPwmDuty(char pin, int duty)
+{
+}
+
+
+/*###########################################################################*/
+
+
+//Returns the number of passes made through 'loop()'.
+unsigned long simGetLoopPassCount()
+{
+  return simLoopPassCount;
+}
+
+//Runs 'loop()' for the given time.
+void simRunLoopForUs(unsigned long timeUs)
+{
+  const uint64_t endNs = simTimeNs + (uint64_t)timeUs*1000;
+  while(simTimeNs < endNs)
+  {
+    loop();
+    ++simLoopPassCount;
+    simChargeNs(SIM_LOOPPASS_NS);
+  }
+}
+
+//Runs 'loop()' until all queued input has been read, all output has
+// been sent, and no output has been sent for the given time (or until
+// the maximum time is reached).
+void simRunLoopUntilIdle(unsigned long quietUs, unsigned long maxUs)
+{
+  const uint64_t endNs = simTimeNs + (uint64_t)maxUs*1000;
+  while(simTimeNs < endNs)
+  {
+    loop();
+    ++simLoopPassCount;
+    simChargeNs(SIM_LOOPPASS_NS);
+    if(simRxCount == 0 && simTxCount == 0 &&
+                     simTimeNs - simLastSerialOutNs >= (uint64_t)quietUs*1000)
+    {
+      break;
+    }
+  }
+}
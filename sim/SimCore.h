@@ -0,0 +1,31 @@
+//SimCore.h:  Header file for the host-simulation core (virtual clock,
+//            interrupts, pins, serial port and EEPROM).
+//
+// 10/16/2026 -- [ET]
+//
+
+#ifndef SIMCORE_H_
+#define SIMCORE_H_
+
+#include <stdint.h>
+
+#define SIM_NS_PER_CYCLE 62.5          //16MHz clock
+#define SIM_SERIAL_TXBUFSIZ 64         //size of serial transmit buffer
+#define SIM_SERIAL_RXBUFSIZ 64         //size of serial receive buffer
+#define SIM_SERIAL_INMAXLEN 4096       //max # of queued input bytes
+
+uint64_t simGetTimeNs();
+uint64_t simGetTimeUs();
+void simChargeNs(unsigned long timeNs);
+void simRunForUs(unsigned long timeUs);
+void simSetPinInputLevel(uint8_t pin, int level);
+void simSerialQueueInput(const char *str);
+int simSerialGetInputPendingCount();
+void simSetSerialOutputFn(void (*outFn)(uint8_t ch, uint64_t timeUs));
+uint64_t simGetLastSerialOutUs();
+bool simIsSerialOutputIdle();
+unsigned long simGetLoopPassCount();
+void simRunLoopForUs(unsigned long timeUs);
+void simRunLoopUntilIdle(unsigned long quietUs, unsigned long maxUs);
+
+#endif /* SIMCORE_H_ */
@@ -0,0 +1,137 @@
+//SimFreqCheck.cpp:  Frequency-lookup check for the ArduVidRx firmware.
+//                   Compares the binary-search lookups in "Rx5808Fns.cpp"
+//                   ('getIdxForFreqInMhz()', 'freqInMhzToFreqCode()' and
+//                   'freqInMhzToNearestFreqCode()') against reference
+//                   versions of the original linear-scan code, for every
+//                   frequency from MIN_CHANNEL_MHZ to MAX_CHANNEL_MHZ in
+//                   both directions, with and without a user-defined
+//                   band.
+//
+// 10/16/2026 -- [ET]
+//
+
+#include <stdio.h>
+#include <Arduino.h>
+#include "Config.h"
+#include "Rx5808Fns.h"
+#include "SimCore.h"
+
+#define SIMFREQ_QUIET_US 300000        //quiet time that ends a command
+#define SIMFREQ_CMDMAX_US 5000000      //max run time per command
+#define SIMFREQ_MAX_FAILS 10           //max # of mismatches shown
+
+int simFreqFailCount = 0;
+
+//Reference (original) version of 'getIdxForFreqInMhz()':  linear scan of
+// the table, returning the lowest matching index (or -1 if no match).
+int simFreqRefIdxForFreq(uint16_t freqVal)
+{
+  for(int idx=CHANNEL_MIN_INDEX; idx<=getChannelMaxIndex(); ++idx)
+  {
+    if(getChannelFreqTableEntry(idx) == freqVal)
+      return idx;
+  }
+  return -1;
+}
+
+//Reference (original) version of 'freqInMhzToNearestFreqCode()':  steps
+// one MHz at a time (with wrap-around) until a table frequency is found.
+uint16_t simFreqRefNearestCode(uint16_t freqVal, boolean upFlag,
+                                                               char *outStr)
+{
+  int freqIdx, fChkVal = freqVal;
+  uint16_t codeVal;
+  do
+  {
+    freqIdx = simFreqRefIdxForFreq(fChkVal);
+    if(freqIdx >= 0)
+    {  //table-index value found for frequency; check for matching code
+      codeVal = freqIdxToFreqCode(freqIdx,outStr);
+      if(codeVal > 0)
+        return codeVal;
+    }
+    if(upFlag)
+    {
+      if(++fChkVal > MAX_CHANNEL_MHZ)
+        fChkVal = MIN_CHANNEL_MHZ;
+    }
+    else
+    {
+      if(--fChkVal < MIN_CHANNEL_MHZ)
+        fChkVal = MAX_CHANNEL_MHZ;
+    }
+  }
+  while(fChkVal != freqVal);
+  return (uint16_t)0;
+}
+
+//Shows a mismatch (up to SIMFREQ_MAX_FAILS of them) and counts it.
+void simFreqShowFail(const char *nameStr, uint16_t freqVal, long newVal,
+                                                               long refVal)
+{
+  if(++simFreqFailCount <= SIMFREQ_MAX_FAILS)
+  {
+    printf("  %s(%u):  got %ld, expected %ld\n",nameStr,
+                                      (unsigned int)freqVal,newVal,refVal);
+  }
+}
+
+//Compares the lookups against the reference versions for every
+// frequency in the command range.
+// nameStr:  name for this pass.
+void simFreqCheckAll(const char *nameStr)
+{
+  const int prevFails = simFreqFailCount;
+  char newStr[3], refStr[3];          //two-char codes plus terminator
+  for(uint16_t f=MIN_CHANNEL_MHZ; f<=MAX_CHANNEL_MHZ; ++f)
+  {
+    const int newIdx = getIdxForFreqInMhz(f);
+    const int refIdx = simFreqRefIdxForFreq(f);
+    if(newIdx != refIdx)
+      simFreqShowFail("getIdxForFreqInMhz",f,newIdx,refIdx);
+    const uint16_t newCode = freqInMhzToFreqCode(f,NULL);
+    const uint16_t refCode = (refIdx >= 0) ?
+                                  freqIdxToFreqCode(refIdx,NULL) : (uint16_t)0;
+    if(newCode != refCode)
+      simFreqShowFail("freqInMhzToFreqCode",f,newCode,refCode);
+    for(int d=0; d<2; ++d)
+    {  //check nearest code in both directions
+      memset(newStr,0,sizeof(newStr));
+      memset(refStr,0,sizeof(refStr));
+      const uint16_t newNear = freqInMhzToNearestFreqCode(f,(d==0),newStr);
+      const uint16_t refNear = simFreqRefNearestCode(f,(d==0),refStr);
+      if(newNear != refNear || strcmp(newStr,refStr) != 0)
+      {
+        simFreqShowFail((d==0) ? "freqInMhzToNearestFreqCode(up)" :
+                          "freqInMhzToNearestFreqCode(down)",f,newNear,refNear);
+      }
+    }
+  }
+  printf("%-22s  channels=%d  %s\n",nameStr,getChannelMaxIndex()+1,
+                          (simFreqFailCount == prevFails) ? "OK" : "FAIL");
+}
+
+//Discards firmware output.
+void simFreqOutputFn(uint8_t ch, uint64_t timeUs)
+{
+}
+
+int main()
+{
+  simSetSerialOutputFn(simFreqOutputFn);
+  setup();
+  simRunLoopUntilIdle(SIMFREQ_QUIET_US,SIMFREQ_CMDMAX_US);
+  simFreqCheckAll("built-in bands");
+         //add user-defined band (with a frequency that duplicates a
+         // built-in one, and values out of order):
+  simSerialQueueInput("XE X 5880,5600,5620,5640,5905,5700,5720,5740\r");
+  simRunLoopUntilIdle(SIMFREQ_QUIET_US,SIMFREQ_CMDMAX_US);
+  simFreqCheckAll("with user-defined band");
+  if(simFreqFailCount > 0)
+  {
+    printf("%d mismatch(es)\n",simFreqFailCount);
+    return 1;
+  }
+  printf("All checks passed\n");
+  return 0;
+}
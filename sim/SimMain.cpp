@@ -0,0 +1,160 @@
+//SimMain.cpp:  Host-simulation runner for the ArduVidRx firmware.  Runs
+//              the firmware against the simulated RX5808 and virtual
+//              transmitters, sending command lines read from standard
+//              input and copying the firmware's serial output to
+//              standard output.
+//
+// 10/16/2026 -- [ET]
+//
+
+#include <stdio.h>
+#include <Arduino.h>
+#include "Display7Seg.h"
+#include "SimCore.h"
+#include "SimRx5808.h"
+
+#define SIMMAIN_LINE_MAXLEN 512
+#define SIMMAIN_DEF_QUIETMS 300        //default quiet time ending a command
+#define SIMMAIN_DEF_MAXMS 10000        //default max run time per command
+
+bool simMainTimeTagsFlag = false;      //true to show time at line starts
+bool simMainAtLineStartFlag = true;
+
+//Shows the usage information.
+void simMainShowUsage()
+{
+  fprintf(stderr,
+    "Usage: arduvidsim [options] < commands\n"
+    "Options:\n"
+    "  -t freq:level[:onMs[:offMs]]  Add virtual transmitter (level 0-100)\n"
+    "  -r file      Replay raw-RSSI trace (captured via 'XY'), starting at\n"
+    "               first command\n"
+    "  -n noise     Std dev of RSSI noise, in raw counts (default %.1f)\n"
+    "  -w mhz       Receive-filter width (sigma) in MHz (default %.1f)\n"
+    "  -u us        RSSI settle time constant in us (default %d)\n"
+    "  -s seed      Seed for noise generator\n"
+    "  -d           No 7-segment display connected\n"
+    "  -q ms        Quiet time that ends a command (default %d)\n"
+    "  -x ms        Maximum run time per command (default %d)\n"
+    "  -T           Show virtual time at start of output lines\n"
+    "Input lines are sent as commands, except:\n"
+    "  @wait ms     Run for given time\n"
+    "  @tx freq:level[:onMs[:offMs]]  Add virtual transmitter\n"
+    "  #...         Comment\n",
+    SIMRX_DEF_NOISE_RAW,SIMRX_DEF_BANDWIDTH_MHZ,SIMRX_DEF_SETTLE_US,
+    SIMMAIN_DEF_QUIETMS,SIMMAIN_DEF_MAXMS);
+}
+
+//Parses a transmitter specification ("freq:level[:onMs[:offMs]]") and
+// adds the transmitter.
+// Returns true if successful; false if error.
+bool simMainAddTransmitter(const char *specStr)
+{
+  unsigned int freqVal, levelVal;
+  unsigned long onMs = 0, offMs = 0;
+  if(sscanf(specStr,"%u:%u:%lu:%lu",&freqVal,&levelVal,&onMs,&offMs) < 2 ||
+                                      levelVal > 100 || freqVal > 0xFFFF)
+  {
+    fprintf(stderr,"Invalid transmitter specification:  %s\n",specStr);
+    return false;
+  }
+  simRxAddTransmitter((uint16_t)freqVal,(uint8_t)levelVal,onMs,offMs);
+  return true;
+}
+
+//Sets the pin levels seen when the 7-segment display is connected (the
+// display-detect function looks for pullups via the segments).
+void simMainSetDisplayConnected()
+{
+  simSetPinInputLevel(DISP7SEG_B_PIN,HIGH);
+  simSetPinInputLevel(DISP7SEG_D_PIN,HIGH);
+  simSetPinInputLevel(DISP7SEG_F_PIN,HIGH);
+}
+
+//Writes a firmware output byte to standard output.
+void simMainOutputFn(uint8_t ch, uint64_t timeUs)
+{
+  if(ch == '\r')
+    return;
+  if(simMainTimeTagsFlag && simMainAtLineStartFlag)
+    printf("[%10.3f] ",timeUs/1000.0);
+  putchar(ch);
+  simMainAtLineStartFlag = (ch == '\n');
+}
+
+int main(int argc, char **argv)
+{
+  bool displayFlag = true;
+  bool traceStartFlag = false;
+  unsigned long quietMs = SIMMAIN_DEF_QUIETMS;
+  unsigned long maxMs = SIMMAIN_DEF_MAXMS;
+  for(int i=1; i<argc; ++i)
+  {
+    const char *argStr = argv[i];
+    const bool valFlag = (i+1 < argc);
+    if(strcmp(argStr,"-t") == 0 && valFlag)
+    {
+      if(!simMainAddTransmitter(argv[++i]))
+        return 1;
+    }
+    else if(strcmp(argStr,"-r") == 0 && valFlag)
+    {
+      if(!simRxLoadTrace(argv[++i]))
+        return 1;
+      traceStartFlag = true;
+    }
+    else if(strcmp(argStr,"-n") == 0 && valFlag)
+      simRxSetNoise(atof(argv[++i]));
+    else if(strcmp(argStr,"-w") == 0 && valFlag)
+      simRxSetBandwidthMhz(atof(argv[++i]));
+    else if(strcmp(argStr,"-u") == 0 && valFlag)
+      simRxSetSettleUs(strtoul(argv[++i],NULL,10));
+    else if(strcmp(argStr,"-s") == 0 && valFlag)
+      simRxSetSeed((uint32_t)strtoul(argv[++i],NULL,10));
+    else if(strcmp(argStr,"-q") == 0 && valFlag)
+      quietMs = strtoul(argv[++i],NULL,10);
+    else if(strcmp(argStr,"-x") == 0 && valFlag)
+      maxMs = strtoul(argv[++i],NULL,10);
+    else if(strcmp(argStr,"-d") == 0)
+      displayFlag = false;
+    else if(strcmp(argStr,"-T") == 0)
+      simMainTimeTagsFlag = true;
+    else
+    {
+      simMainShowUsage();
+      return 1;
+    }
+  }
+  if(displayFlag)
+    simMainSetDisplayConnected();
+  setvbuf(stdout,NULL,_IOLBF,0);      //show output lines as they come
+  simSetSerialOutputFn(simMainOutputFn);
+  setup();
+  simRunLoopUntilIdle(quietMs*1000,maxMs*1000);
+
+  char lineBuff[SIMMAIN_LINE_MAXLEN];
+  while(fgets(lineBuff,sizeof(lineBuff),stdin) != NULL)
+  {
+    lineBuff[strcspn(lineBuff,"\r\n")] = '\0';
+    if(lineBuff[0] == '#')
+      continue;
+    if(strncmp(lineBuff,"@wait ",6) == 0)
+      simRunLoopForUs(strtoul(&lineBuff[6],NULL,10)*1000);
+    else if(strncmp(lineBuff,"@tx ",4) == 0)
+      simMainAddTransmitter(&lineBuff[4]);
+    else
+    {  //send as command
+      if(traceStartFlag)
+      {  //first command; start trace replay
+        simRxSetTraceStartTime(simGetTimeNs());
+        traceStartFlag = false;
+      }
+      strcat(lineBuff,"\r");
+      simSerialQueueInput(lineBuff);
+      simRunLoopUntilIdle(quietMs*1000,maxMs*1000);
+    }
+  }
+  if(!simMainAtLineStartFlag)
+    putchar('\n');
+  return 0;
+}
@@ -0,0 +1,473 @@
+//SimRx5808.cpp:  Simulated RX5808 module and RF environment.  Register-
+//                write frames are decoded from the SEL/CLK/DATA pin
+//                changes (via 'digitalWrite()' or direct-port writes),
+//                and the RSSI output is computed from a set of virtual
+//                transmitters, each with a frequency, a signal level
+//                (0-100) and optional on/off times.  The RSSI output for
+//                a transmitter falls off with frequency offset through a
+//                Gaussian receive-filter shape, the strongest transmitter
+//                dominates, and after each tune the output moves
+//                exponentially from its previous value to the new one.
+//                Gaussian noise is added to each reading.  Alternatively,
+//                the RSSI output may be replayed from a raw-RSSI trace
+//                captured on the hardware via the 'XY' command.
+//
+// 10/16/2026 -- [ET]
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <Arduino.h>
+#include "Config.h"
+#include "SimRx5808.h"
+
+#define SIMRX_SYNTHB_REGADDR 0x1       //synthesizer-B register
+#define SIMRX_FRAME_NUMBITS 25         //bits in register-write frame
+
+    //virtual transmitter:
+struct SimRxTransmitter
+{
+  uint16_t freqMhz;          //transmit frequency
+  uint8_t levelVal;          //signal level (0-100) at receiver
+  unsigned long onMs;        //time transmitter turns on
+  unsigned long offMs;       //time transmitter turns off (0 == never)
+};
+
+SimRxTransmitter simRxTransmittersArr[SIMRX_MAX_TRANSMITTERS];
+int simRxTransmittersCount = 0;
+
+uint16_t simRxFloorRaw = SIMRX_DEF_FLOOR_RAW;
+uint16_t simRxFullRaw = SIMRX_DEF_FULL_RAW;
+double simRxBandwidthMhz = SIMRX_DEF_BANDWIDTH_MHZ;
+unsigned long simRxSettleUs = SIMRX_DEF_SETTLE_US;
+double simRxNoiseRaw = SIMRX_DEF_NOISE_RAW;
+uint32_t simRxRandState = 12345;
+
+uint8_t simRxSelLevel = LOW;           //tracked pin levels
+uint8_t simRxClkLevel = LOW;
+uint8_t simRxDataLevel = LOW;
+uint8_t simRxFrameBitCount = 0;        //bits clocked into current frame
+uint32_t simRxFrameVal = 0;            //frame bits (LSB first)
+
+    //raw-RSSI trace entry ("timeMs,freqMhz,rawRssi" line):
+struct SimRxTraceEntry
+{
+  unsigned long timeMs;      //time since trace started
+  uint16_t freqMhz;          //frequency read
+  uint16_t rawVal;           //raw RSSI value
+};
+
+SimRxTraceEntry *simRxTraceArr = NULL; //trace entries (sorted by time)
+int simRxTraceCount = 0;
+uint16_t simRxTraceFreqsArr[SIMRX_TRACE_MAXFREQS];  //traced frequencies
+int simRxTraceFreqsCount = 0;
+uint16_t simRxTraceMinRaw = 0;         //scaling values from trace header
+uint16_t simRxTraceMaxRaw = 0;
+uint16_t simRxTraceFloorRaw = 0;       //lowest value in trace
+uint64_t simRxTraceStartNs = 0;        //simulation time at trace start
+
+uint16_t simRxTunedFreqMhz = 0;        //tuned frequency (0 == none)
+uint64_t simRxTuneTimeNs = 0;          //time of last tune
+double simRxSettleOffset = 0.0;        //output offset at time of tune
+unsigned long simRxTuneCount = 0;
+void (*simRxTuneFn)(uint16_t freqMhz, uint64_t timeUs) = NULL;
+
+//Adds a virtual transmitter.
+// freqMhz:  transmit frequency, in MHz.
+// levelVal:  signal level at receiver (0-100; 100 == full-scale RSSI).
+// onMs:  time (virtual, in ms) that transmitter turns on.
+// offMs:  time that transmitter turns off, or 0 for never.
+void simRxAddTransmitter(uint16_t freqMhz, uint8_t levelVal,
+                                      unsigned long onMs, unsigned long offMs)
+{
+  if(simRxTransmittersCount >= SIMRX_MAX_TRANSMITTERS)
+    return;
+  SimRxTransmitter &txRef = simRxTransmittersArr[simRxTransmittersCount++];
+  txRef.freqMhz = freqMhz;
+  txRef.levelVal = (levelVal <= 100) ? levelVal : (uint8_t)100;
+  txRef.onMs = onMs;
+  txRef.offMs = offMs;
+}
+
+//Removes all virtual transmitters.
+void simRxClearTransmitters()
+{
+  simRxTransmittersCount = 0;
+}
+
+//Returns the number of virtual transmitters.
+int simRxGetTransmitterCount()
+{
+  return simRxTransmittersCount;
+}
+
+//Fetches the frequency and level of the given virtual transmitter.
+void simRxGetTransmitter(int idx, uint16_t *pFreqMhz, uint8_t *pLevelVal)
+{
+  *pFreqMhz = simRxTransmittersArr[idx].freqMhz;
+  *pLevelVal = simRxTransmittersArr[idx].levelVal;
+}
+
+//Sets the raw-RSSI values for no signal and for a full-level signal.
+void simRxSetLevels(uint16_t floorRaw, uint16_t fullRaw)
+{
+  simRxFloorRaw = floorRaw;
+  simRxFullRaw = fullRaw;
+}
+
+//Sets the width (standard deviation, in MHz) of the receive filter.
+void simRxSetBandwidthMhz(double widthMhz)
+{
+  simRxBandwidthMhz = (widthMhz > 0.1) ? widthMhz : 0.1;
+}
+
+//Sets the time constant for RSSI-output settling after a tune.
+void simRxSetSettleUs(unsigned long settleUs)
+{
+  simRxSettleUs = settleUs;
+}
+
+//Sets the standard deviation of the noise added to readings.
+void simRxSetNoise(double noiseRaw)
+{
+  simRxNoiseRaw = (noiseRaw >= 0.0) ? noiseRaw : 0.0;
+}
+
+//Sets the seed for the noise generator.
+void simRxSetSeed(uint32_t seedVal)
+{
+  simRxRandState = (seedVal != 0) ? seedVal : 1;
+}
+
+//Sets the function called for each tune of the module.
+void simRxSetTuneFn(void (*tuneFn)(uint16_t freqMhz, uint64_t timeUs))
+{
+  simRxTuneFn = tuneFn;
+}
+
+//Returns the frequency the module is tuned to (0 if never tuned).
+uint16_t simRxGetTunedFreq()
+{
+  return simRxTunedFreqMhz;
+}
+
+//Returns the number of tunes of the module.
+unsigned long simRxGetTuneCount()
+{
+  return simRxTuneCount;
+}
+
+//Returns a uniformly-distributed random value in (0,1].
+double simRxRandUniform()
+{
+  simRxRandState ^= simRxRandState << 13;        //xorshift32
+  simRxRandState ^= simRxRandState >> 17;
+  simRxRandState ^= simRxRandState << 5;
+  return ((double)simRxRandState + 1.0) / 4294967296.0;
+}
+
+//Returns a normally-distributed random value (mean 0, std dev 1).
+double simRxRandNormal()
+{
+  const double u1 = simRxRandUniform();
+  const double u2 = simRxRandUniform();
+  return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+//Returns the signal level (0.0-1.0) seen by the receiver when tuned to
+// the given frequency (the strongest transmitter after filtering).
+double simRxGetSignalLevel(uint16_t freqMhz, uint64_t timeNs)
+{
+  const unsigned long timeMs = (unsigned long)(timeNs / 1000000);
+  double maxVal = 0.0;
+  for(int i=0; i<simRxTransmittersCount; ++i)
+  {
+    const SimRxTransmitter &txRef = simRxTransmittersArr[i];
+    if(timeMs < txRef.onMs || (txRef.offMs > 0 && timeMs >= txRef.offMs))
+      continue;
+    const double offsVal = ((double)freqMhz - txRef.freqMhz) /
+                                                         simRxBandwidthMhz;
+    const double val = txRef.levelVal / 100.0 * exp(-0.5*offsVal*offsVal);
+    if(val > maxVal)
+      maxVal = val;
+  }
+  return maxVal;
+}
+
+//Compares trace entries by time (for 'qsort()').
+int simRxCompareTraceEntries(const void *p1, const void *p2)
+{
+  const unsigned long t1 = ((const SimRxTraceEntry *)p1)->timeMs;
+  const unsigned long t2 = ((const SimRxTraceEntry *)p2)->timeMs;
+  return (t1 < t2) ? -1 : ((t1 > t2) ? 1 : 0);
+}
+
+//Loads a raw-RSSI trace (as captured via the 'XY' command), after which
+// the RSSI output is replayed from the trace (instead of being computed
+// from the virtual transmitters).  Lines that are not trace readings
+// or the "#trace rawMin=nnn rawMax=nnn" header are ignored.
+// Returns true if successful; false if error.
+bool simRxLoadTrace(const char *fileName)
+{
+  FILE *fp = fopen(fileName,"r");
+  if(fp == NULL)
+  {
+    fprintf(stderr,"Unable to open trace file:  %s\n",fileName);
+    return false;
+  }
+  int allocCount = 0;
+  char lineBuff[128];
+  unsigned long timeMs;
+  unsigned int freqVal, rawVal, minVal, maxVal;
+  simRxTraceCount = 0;
+  simRxTraceFreqsCount = 0;
+  simRxTraceMinRaw = simRxTraceMaxRaw = 0;
+  while(fgets(lineBuff,sizeof(lineBuff),fp) != NULL)
+  {
+    if(sscanf(lineBuff,"#trace rawMin=%u rawMax=%u",&minVal,&maxVal) == 2)
+    {
+      simRxTraceMinRaw = (uint16_t)minVal;
+      simRxTraceMaxRaw = (uint16_t)maxVal;
+      continue;
+    }
+    if(sscanf(lineBuff,"%lu,%u,%u",&timeMs,&freqVal,&rawVal) != 3 ||
+                                       freqVal == 0 || freqVal > 0xFFFF)
+    {
+      continue;
+    }
+    if(simRxTraceCount >= allocCount)
+    {
+      allocCount = (allocCount > 0) ? allocCount*2 : 1024;
+      simRxTraceArr = (SimRxTraceEntry *)realloc(simRxTraceArr,
+                                       allocCount*sizeof(SimRxTraceEntry));
+    }
+    SimRxTraceEntry &entRef = simRxTraceArr[simRxTraceCount++];
+    entRef.timeMs = timeMs;
+    entRef.freqMhz = (uint16_t)freqVal;
+    entRef.rawVal = (uint16_t)rawVal;
+    if(simRxTraceCount == 1 || rawVal < simRxTraceFloorRaw)
+      simRxTraceFloorRaw = (uint16_t)rawVal;
+    int i = 0;
+    while(i < simRxTraceFreqsCount && simRxTraceFreqsArr[i] != freqVal)
+      ++i;
+    if(i >= simRxTraceFreqsCount && i < SIMRX_TRACE_MAXFREQS)
+      simRxTraceFreqsArr[simRxTraceFreqsCount++] = (uint16_t)freqVal;
+  }
+  fclose(fp);
+  if(simRxTraceCount <= 0)
+  {
+    fprintf(stderr,"No readings in trace file:  %s\n",fileName);
+    return false;
+  }
+  qsort(simRxTraceArr,simRxTraceCount,sizeof(SimRxTraceEntry),
+                                                simRxCompareTraceEntries);
+  if(simRxTraceMaxRaw <= simRxTraceMinRaw)
+  {  //no header; use range of values in trace
+    simRxTraceMinRaw = simRxTraceFloorRaw;
+    simRxTraceMaxRaw = simRxTraceFloorRaw;
+    for(int i=0; i<simRxTraceCount; ++i)
+    {
+      if(simRxTraceArr[i].rawVal > simRxTraceMaxRaw)
+        simRxTraceMaxRaw = simRxTraceArr[i].rawVal;
+    }
+  }
+  return true;
+}
+
+//Returns true if a raw-RSSI trace is loaded.
+bool simRxIsTraceLoaded()
+{
+  return (simRxTraceCount > 0);
+}
+
+//Sets the simulation time corresponding to the first trace reading.
+void simRxSetTraceStartTime(uint64_t timeNs)
+{
+  simRxTraceStartNs = timeNs;
+}
+
+//Fetches the raw-RSSI scaling values for the trace (from its header, or
+// the range of its values).
+void simRxGetTraceRawLimits(uint16_t *pMinRaw, uint16_t *pMaxRaw)
+{
+  *pMinRaw = simRxTraceMinRaw;
+  *pMaxRaw = simRxTraceMaxRaw;
+}
+
+//Returns the time from the first to the last trace reading.
+unsigned long simRxGetTraceDurationMs()
+{
+  return (simRxTraceCount > 0) ? simRxTraceArr[simRxTraceCount-1].timeMs -
+                                                  simRxTraceArr[0].timeMs : 0;
+}
+
+//Returns the index of the last trace entry at or before the given
+// simulation time (or 0 if none).
+int simRxGetTraceIdxForTime(uint64_t timeNs)
+{
+  const unsigned long timeMs = simRxTraceArr[0].timeMs +
+                               ((timeNs > simRxTraceStartNs) ?
+                      (unsigned long)((timeNs-simRxTraceStartNs)/1000000) : 0);
+  int loIdx = 0, hiIdx = simRxTraceCount - 1;
+  while(loIdx < hiIdx)
+  {
+    const int midIdx = (loIdx + hiIdx + 1) / 2;
+    if(simRxTraceArr[midIdx].timeMs <= timeMs)
+      loIdx = midIdx;
+    else
+      hiIdx = midIdx - 1;
+  }
+  return loIdx;
+}
+
+//Returns the raw-RSSI value from the trace for the given frequency at
+// the given simulation time:  the latest reading (at or before the time)
+// of the nearest traced frequency, or the lowest trace value if no
+// traced frequency is within SIMRX_TRACE_MATCH_MHZ.
+uint16_t simRxGetTraceRaw(uint16_t freqMhz, uint64_t timeNs)
+{
+  int bestDiff = SIMRX_TRACE_MATCH_MHZ + 1;
+  uint16_t traceFreq = 0;
+  for(int i=0; i<simRxTraceFreqsCount; ++i)
+  {
+    const int diffVal = abs((int)simRxTraceFreqsArr[i] - (int)freqMhz);
+    if(diffVal < bestDiff)
+    {
+      bestDiff = diffVal;
+      traceFreq = simRxTraceFreqsArr[i];
+    }
+  }
+  if(traceFreq == 0)
+    return simRxTraceFloorRaw;
+  const int idx = simRxGetTraceIdxForTime(timeNs);
+  for(int i=idx; i>=0; --i)
+  {  //search back for latest reading of frequency
+    if(simRxTraceArr[i].freqMhz == traceFreq)
+      return simRxTraceArr[i].rawVal;
+  }
+  for(int i=idx+1; i<simRxTraceCount; ++i)
+  {  //time is before first reading of frequency; use first one
+    if(simRxTraceArr[i].freqMhz == traceFreq)
+      return simRxTraceArr[i].rawVal;
+  }
+  return simRxTraceFloorRaw;
+}
+
+//Returns the traced frequency with the highest latest reading at the
+// given simulation time (0 if none), with its raw-RSSI value entered
+// into 'pRawVal'.
+uint16_t simRxGetTraceBestFreq(uint64_t timeNs, uint16_t *pRawVal)
+{
+  bool seenArr[SIMRX_TRACE_MAXFREQS] = { false };
+  int seenCount = 0;
+  uint16_t bestFreq = 0, bestRaw = 0;
+  for(int i=simRxGetTraceIdxForTime(timeNs);
+                              i>=0 && seenCount<simRxTraceFreqsCount; --i)
+  {  //search back until latest reading of each frequency seen
+    const SimRxTraceEntry &entRef = simRxTraceArr[i];
+    int f = 0;
+    while(f < simRxTraceFreqsCount && simRxTraceFreqsArr[f] != entRef.freqMhz)
+      ++f;
+    if(f >= simRxTraceFreqsCount || seenArr[f])
+      continue;
+    seenArr[f] = true;
+    ++seenCount;
+    if(bestFreq == 0 || entRef.rawVal > bestRaw)
+    {
+      bestFreq = entRef.freqMhz;
+      bestRaw = entRef.rawVal;
+    }
+  }
+  *pRawVal = bestRaw;
+  return bestFreq;
+}
+
+//Returns the settled (noise-free) raw-RSSI output for the given
+// frequency (from the trace, if loaded).
+double simRxGetTargetRaw(uint16_t freqMhz, uint64_t timeNs)
+{
+  if(simRxTraceCount > 0)
+    return simRxGetTraceRaw(freqMhz,timeNs);
+  if(freqMhz == 0)
+    return simRxFloorRaw;
+  return simRxFloorRaw + (simRxFullRaw - simRxFloorRaw) *
+                                       simRxGetSignalLevel(freqMhz,timeNs);
+}
+
+//Returns the noise-free raw-RSSI output at the given time (including
+// any settling transient).
+double simRxGetOutputRaw(uint64_t timeNs)
+{
+  double val = simRxGetTargetRaw(simRxTunedFreqMhz,timeNs);
+  if(simRxSettleUs > 0 && timeNs >= simRxTuneTimeNs)
+  {
+    val += simRxSettleOffset * exp(-(double)(timeNs - simRxTuneTimeNs) /
+                                                   (simRxSettleUs * 1000.0));
+  }
+  return val;
+}
+
+//Handles a register-write frame received by the module.
+void simRxHandleFrame(uint32_t frameVal, uint64_t timeNs)
+{
+  if((frameVal & 0x0F) != SIMRX_SYNTHB_REGADDR || !(frameVal & 0x10))
+    return;                  //not a write to synthesizer-B register
+  const uint32_t regVal = frameVal >> 5;
+  const uint16_t freqMhz = (uint16_t)(2*((regVal >> 7)*32 +
+                                                  (regVal & 0x7F)) + 479);
+  const double prevVal = simRxGetOutputRaw(timeNs);
+  simRxTunedFreqMhz = freqMhz;
+  simRxTuneTimeNs = timeNs;
+  simRxSettleOffset = prevVal - simRxGetTargetRaw(freqMhz,timeNs);
+  ++simRxTuneCount;
+  if(simRxTuneFn != NULL)
+    (*simRxTuneFn)(freqMhz,timeNs/1000);
+}
+
+//Tracks a change to an output pin; bits are clocked in on CLK rising
+// edges while SEL is low, and the frame is latched on SEL rising.
+void simRxPinWrite(uint8_t pin, uint8_t val, uint64_t timeNs)
+{
+  if(pin == RX5808_SEL_PIN)
+  {
+    if(val != LOW && simRxSelLevel == LOW)
+    {  //SEL rising; latch frame
+      if(simRxFrameBitCount == SIMRX_FRAME_NUMBITS)
+        simRxHandleFrame(simRxFrameVal,timeNs);
+      simRxFrameBitCount = 0;
+    }
+    else if(val == LOW && simRxSelLevel != LOW)
+    {  //SEL falling; start of frame
+      simRxFrameBitCount = 0;
+      simRxFrameVal = 0;
+    }
+    simRxSelLevel = val;
+  }
+  else if(pin == RX5808_CLK_PIN)
+  {
+    if(val != LOW && simRxClkLevel == LOW && simRxSelLevel == LOW &&
+                                  simRxFrameBitCount < SIMRX_FRAME_NUMBITS)
+    {  //CLK rising during frame; clock in data bit
+      if(simRxDataLevel != LOW)
+        simRxFrameVal |= (uint32_t)1 << simRxFrameBitCount;
+      ++simRxFrameBitCount;
+    }
+    simRxClkLevel = val;
+  }
+  else if(pin == RX5808_DATA_PIN)
+    simRxDataLevel = val;
+}
+
+//Returns a raw (10-bit ADC) reading of the given analog-input pin.  The
+// primary RSSI pin carries the module output; other pins read as zero.
+// No noise is added when replaying a trace (it holds the real noise).
+uint16_t simRxReadRawRssi(uint8_t pin, uint64_t timeNs)
+{
+  if(pin != RSSI_PRI_PIN)
+    return 0;
+  const double noiseVal = (simRxTraceCount > 0) ? 0.0 :
+                                          simRxNoiseRaw * simRxRandNormal();
+  const long val = lround(simRxGetOutputRaw(timeNs) + noiseVal);
+  return (uint16_t)constrain(val,0L,1023L);
+}
@@ -0,0 +1,45 @@
+//SimRx5808.h:  Header file for the simulated RX5808 module and RF
+//              environment.
+//
+// 10/16/2026 -- [ET]
+//
+
+#ifndef SIMRX5808_H_
+#define SIMRX5808_H_
+
+#include <stdint.h>
+
+#define SIMRX_MAX_TRANSMITTERS 16      //max # of virtual transmitters
+#define SIMRX_DEF_FLOOR_RAW 110        //default raw RSSI with no signal
+#define SIMRX_DEF_FULL_RAW 230         //default raw RSSI for full signal
+#define SIMRX_DEF_BANDWIDTH_MHZ 12.0   //default receive-filter width (sigma)
+#define SIMRX_DEF_SETTLE_US 6000       //default settle time constant
+#define SIMRX_DEF_NOISE_RAW 1.0        //default noise (std dev, raw counts)
+#define SIMRX_TRACE_MAXFREQS 128       //max # of frequencies in RSSI trace
+#define SIMRX_TRACE_MATCH_MHZ 5        //max offset to use traced frequency
+
+void simRxAddTransmitter(uint16_t freqMhz, uint8_t levelVal,
+                                   unsigned long onMs, unsigned long offMs);
+void simRxClearTransmitters();
+int simRxGetTransmitterCount();
+void simRxGetTransmitter(int idx, uint16_t *pFreqMhz, uint8_t *pLevelVal);
+void simRxSetLevels(uint16_t floorRaw, uint16_t fullRaw);
+void simRxSetBandwidthMhz(double widthMhz);
+void simRxSetSettleUs(unsigned long settleUs);
+void simRxSetNoise(double noiseRaw);
+void simRxSetSeed(uint32_t seedVal);
+void simRxPinWrite(uint8_t pin, uint8_t val, uint64_t timeNs);
+uint16_t simRxReadRawRssi(uint8_t pin, uint64_t timeNs);
+double simRxGetSignalLevel(uint16_t freqMhz, uint64_t timeNs);
+uint16_t simRxGetTunedFreq();
+unsigned long simRxGetTuneCount();
+void simRxSetTuneFn(void (*tuneFn)(uint16_t freqMhz, uint64_t timeUs));
+bool simRxLoadTrace(const char *fileName);
+bool simRxIsTraceLoaded();
+void simRxSetTraceStartTime(uint64_t timeNs);
+void simRxGetTraceRawLimits(uint16_t *pMinRaw, uint16_t *pMaxRaw);
+unsigned long simRxGetTraceDurationMs();
+uint16_t simRxGetTraceRaw(uint16_t freqMhz, uint64_t timeNs);
+uint16_t simRxGetTraceBestFreq(uint64_t timeNs, uint16_t *pRawVal);
+
+#endif /* SIMRX5808_H_ */
@@ -0,0 +1,92 @@
+//SimTuneCheck.cpp:  Tuning check for the ArduVidRx firmware, run against
+//                   the simulated RX5808.  Verifies that the module is
+//                   tuned at power-up and after each of a sequence of
+//                   'T' commands (including band changes and a re-tune
+//                   to the current frequency, which sends no frame), via
+//                   the frames decoded from the SEL/CLK/DATA pins.  The
+//                   module tunes in 2 MHz steps, so the decoded freq may
+//                   be 1 MHz below the requested one.
+//
+// 10/16/2026 -- [ET]
+//
+
+#include <stdio.h>
+#include <Arduino.h>
+#include "Config.h"
+#include "SimCore.h"
+#include "SimRx5808.h"
+
+#define SIMTUNE_QUIET_US 300000        //quiet time that ends a command
+#define SIMTUNE_CMDMAX_US 5000000      //max run time per command
+#define SIMTUNE_FREQ_TOLMHZ 1          //max offset of tuned freq
+
+    //tune step (command, expected tuned freq, expected # of new frames):
+struct SimTuneStep
+{
+  const char *cmdStr;
+  uint16_t freqMhz;
+  unsigned long newTunes;
+};
+
+const SimTuneStep simTuneStepsArr[] = {
+  { "T 5800", 5800, 0 },     //same as power-up freq; no frame sent
+  { "T A1",   5865, 1 },     //band change (F to A)
+  { "T B8",   5866, 0 },     //band change (A to B); same reg value
+  { "T E1",   5705, 1 },     //band change (B to E)
+  { "T L1",   5362, 1 },     //L band
+  { "T 5658", 5658, 1 },     //band R by MHz value
+  { "T 5658", 5658, 0 },     //re-tune to same freq; no frame sent
+  { "U",      5659, 1 },     //up one MHz
+  { "T F4",   5800, 1 }      //back to power-up freq
+};
+#define SIMTUNE_NUM_STEPS \
+                       ((int)(sizeof(simTuneStepsArr)/sizeof(SimTuneStep)))
+
+//Discards firmware output.
+void simTuneOutputFn(uint8_t ch, uint64_t timeUs)
+{
+}
+
+//Checks the tuned frequency and tune count against the expected values.
+// Returns true if they match; false (with message shown) if not.
+bool simTuneCheckState(const char *nameStr, uint16_t freqMhz,
+                                                   unsigned long tuneCount)
+{
+  const uint16_t tunedFreq = simRxGetTunedFreq();
+  const unsigned long curCount = simRxGetTuneCount();
+  const bool okFlag = (abs((int)tunedFreq - (int)freqMhz) <=
+                         SIMTUNE_FREQ_TOLMHZ && curCount == tuneCount);
+  printf("%-8s  tuned=%4u (expected %4u)  frames=%lu (expected %lu)  %s\n",
+         nameStr,(unsigned int)tunedFreq,(unsigned int)freqMhz,curCount,
+                                          tuneCount,okFlag ? "OK" : "FAIL");
+  return okFlag;
+}
+
+int main()
+{
+  simSetSerialOutputFn(simTuneOutputFn);
+  setup();
+  simRunLoopUntilIdle(SIMTUNE_QUIET_US,SIMTUNE_CMDMAX_US);
+  unsigned long expCount = 1;          //power-up tune
+  int failCount = 0;
+  if(!simTuneCheckState("power-up",DEFAULT_FREQ_MHZ,expCount))
+    ++failCount;
+  char cmdBuff[32];
+  for(int i=0; i<SIMTUNE_NUM_STEPS; ++i)
+  {
+    const SimTuneStep &step = simTuneStepsArr[i];
+    snprintf(cmdBuff,sizeof(cmdBuff),"%s\r",step.cmdStr);
+    simSerialQueueInput(cmdBuff);
+    simRunLoopUntilIdle(SIMTUNE_QUIET_US,SIMTUNE_CMDMAX_US);
+    expCount += step.newTunes;
+    if(!simTuneCheckState(step.cmdStr,step.freqMhz,expCount))
+      ++failCount;
+  }
+  if(failCount > 0)
+  {
+    printf("%d check(s) failed\n",failCount);
+    return 1;
+  }
+  printf("All checks passed\n");
+  return 0;
+}
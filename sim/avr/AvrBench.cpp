@@ -0,0 +1,616 @@
+//AvrBench.cpp:  Cycle-count benchmarks of the compiled ArduVidRx firmware
+//               under the 'simavr' AVR instruction-set simulator.  The
+//               firmware ELF is run on a simulated ATmega328P, with
+//               commands sent via the simulated UART and the RSSI voltage
+//               on A7 set from a scripted set of transmitters (tracking
+//               the tune frames written to the RX5808 pins).  The cycle
+//               counts for RX5808 tune writes, scan steps, the display
+//               (Timer1) interrupt routine and command-to-response
+//               latency are written to a machine-readable (JSON) report,
+//               which may be compared against a baseline report.
+//
+// 10/16/2026 -- [ET]
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "sim_avr.h"
+#include "sim_elf.h"
+#include "sim_irq.h"
+#include "avr_ioport.h"
+#include "avr_uart.h"
+#include "avr_adc.h"
+#include "Config.h"
+
+#define AVRBENCH_MCU_NAME "atmega328p"
+#define AVRBENCH_FREQ_HZ 16000000UL
+#define AVRBENCH_VCC_MV 5000
+#define AVRBENCH_UART_CHAR_CYCLES (AVRBENCH_FREQ_HZ*10/SERIAL_BAUDRATE)
+#define AVRBENCH_DISPISR_VECNUM 13     //TIMER1_OVF_vect on ATmega328
+#define AVRBENCH_RETI_OPCODE 0x9518
+#define AVRBENCH_RSSI_ADC_CHAN 7       //RSSI_PRI_PIN (A7)
+#define AVRBENCH_SEC_ADC_CHAN 6        //RSSI_SEC_PIN (A6)
+#define AVRBENCH_FLOOR_RAW 110         //raw RSSI with no signal
+#define AVRBENCH_FULL_RAW 230          //raw RSSI at full signal level
+#define AVRBENCH_BANDWIDTH_MHZ 12.0    //receive-filter width (sigma)
+#define AVRBENCH_SYNTHB_REGADDR 0x1    //synthesizer-B register
+#define AVRBENCH_FRAME_NUMBITS 25      //bits in register-write frame
+#define AVRBENCH_STARTUP_MS 3000       //run time for power-up
+#define AVRBENCH_DEF_QUIETMS 300       //default quiet time ending a command
+#define AVRBENCH_DEF_MAXMS 30000       //default max run time per command
+#define AVRBENCH_MAX_TX 8              //max number of transmitters
+#define AVRBENCH_MAX_CMDS 32           //max number of commands
+#define AVRBENCH_CMD_MAXLEN 64
+#define AVRBENCH_DEF_REGRPCT 5.0       //default regression threshold (%)
+
+    //pins watched or driven (Arduino pin numbers; see "Config.h" and
+    // "Display7Seg.h"):
+#define AVRBENCH_DISP_B_PIN 7          //display-detect pins (held high
+#define AVRBENCH_DISP_D_PIN 9          // so display is detected)
+#define AVRBENCH_DISP_F_PIN 15         //A1
+
+    //commands run before those given (echo off, so that the first output
+    // after a command is its response; fixed RSSI scaling to match the
+    // scripted levels):
+const char *avrBenchSetupCmdsArr[] = { "E 0", "XA 0", "XJ 110,230" };
+#define AVRBENCH_NUM_SETUPCMDS \
+                 ((int)(sizeof(avrBenchSetupCmdsArr)/sizeof(const char *)))
+
+const char *avrBenchDefCmdsArr[] = { "V", "T 5800", "R", "S", "A", "N" };
+#define AVRBENCH_NUM_DEFCMDS \
+                   ((int)(sizeof(avrBenchDefCmdsArr)/sizeof(const char *)))
+
+    //statistics for a measured span (in cycles):
+struct AvrBenchSpan
+{
+  const char *nameStr;
+  unsigned long count;
+  uint64_t minCyc;
+  uint64_t maxCyc;
+  double sumCyc;
+};
+
+enum { AVRBENCH_SPAN_TUNEWRITE, AVRBENCH_SPAN_SCANSTEP,
+                AVRBENCH_SPAN_DISPISR, AVRBENCH_SPAN_CMDRESP,
+                                                  AVRBENCH_NUM_SPANS };
+
+AvrBenchSpan avrBenchSpansArr[AVRBENCH_NUM_SPANS] = {
+  { "tuneWrite", 0, 0, 0, 0.0 },
+  { "scanStep", 0, 0, 0, 0.0 },
+  { "displayIsr", 0, 0, 0, 0.0 },
+  { "cmdResponse", 0, 0, 0, 0.0 }
+};
+
+    //results for one command:
+struct AvrBenchCmdResult
+{
+  char cmdStr[AVRBENCH_CMD_MAXLEN];
+  uint64_t respCycles;       //cycles from command to response (0 if none)
+  uint64_t runCycles;        //cycles from command to end of output
+  unsigned long tuneCount;   //tunes during command
+};
+
+AvrBenchCmdResult avrBenchCmdResultsArr[AVRBENCH_MAX_CMDS];
+int avrBenchCmdResultsCount = 0;
+
+uint16_t avrBenchTxFreqArr[AVRBENCH_MAX_TX];     //scripted transmitters
+uint8_t avrBenchTxLevelArr[AVRBENCH_MAX_TX];
+int avrBenchTxCount = 0;
+
+avr_t *avrBenchAvrPtr = NULL;
+avr_irq_t *avrBenchUartInIrqPtr = NULL;
+avr_irq_t *avrBenchRssiAdcIrqPtr = NULL;
+bool avrBenchVerboseFlag = false;      //true to copy output to stderr
+
+uint8_t avrBenchSelLevel = 1;          //tracked RX5808 pin levels
+uint8_t avrBenchClkLevel = 0;
+uint8_t avrBenchDataLevel = 0;
+uint8_t avrBenchFrameBitCount = 0;
+uint32_t avrBenchFrameVal = 0;
+uint64_t avrBenchSelLowCycle = 0;      //cycle of SEL falling
+uint64_t avrBenchLastTuneCycle = 0;    //cycle of last tune (0 if none)
+unsigned long avrBenchTuneCount = 0;
+bool avrBenchScanCmdFlag = false;      //true while scan command running
+
+uint64_t avrBenchLastOutCycle = 0;     //cycle of last output byte
+uint64_t avrBenchCmdSentCycle = 0;     //cycle command terminator sent
+uint64_t avrBenchRespCycle = 0;        //cycle of first response byte
+bool avrBenchAwaitRespFlag = false;
+
+//Adds a value to the given span statistics.
+void avrBenchAddSpan(int spanIdx, uint64_t cycVal)
+{
+  AvrBenchSpan &spanRef = avrBenchSpansArr[spanIdx];
+  if(spanRef.count == 0 || cycVal < spanRef.minCyc)
+    spanRef.minCyc = cycVal;
+  if(cycVal > spanRef.maxCyc)
+    spanRef.maxCyc = cycVal;
+  spanRef.sumCyc += (double)cycVal;
+  ++spanRef.count;
+}
+
+//Returns the mean of the given span statistics (0 if no values).
+double avrBenchGetSpanMean(const AvrBenchSpan &spanRef)
+{
+  return (spanRef.count > 0) ? spanRef.sumCyc / spanRef.count : 0.0;
+}
+
+//Converts an Arduino (Nano/Uno) pin number to a port letter and bit.
+void avrBenchGetPortBit(int pinNum, char *pPortCh, int *pBitNum)
+{
+  if(pinNum < 8)
+  {
+    *pPortCh = 'D';
+    *pBitNum = pinNum;
+  }
+  else if(pinNum < 14)
+  {
+    *pPortCh = 'B';
+    *pBitNum = pinNum - 8;
+  }
+  else
+  {
+    *pPortCh = 'C';
+    *pBitNum = pinNum - 14;
+  }
+}
+
+//Returns the IRQ for the given Arduino pin number.
+avr_irq_t *avrBenchGetPinIrq(int pinNum)
+{
+  char portCh;
+  int bitNum;
+  avrBenchGetPortBit(pinNum,&portCh,&bitNum);
+  return avr_io_getirq(avrBenchAvrPtr,AVR_IOCTL_IOPORT_GETIRQ(portCh),bitNum);
+}
+
+//Sets the RSSI voltage on the A7 input for the given tuned frequency.
+void avrBenchSetRssiForFreq(uint16_t freqMhz)
+{
+  double levelVal = 0.0;
+  for(int i=0; i<avrBenchTxCount; ++i)
+  {
+    const double offsVal = ((double)freqMhz - avrBenchTxFreqArr[i]) /
+                                                    AVRBENCH_BANDWIDTH_MHZ;
+    const double val = avrBenchTxLevelArr[i] / 100.0 *
+                                                 exp(-0.5*offsVal*offsVal);
+    if(val > levelVal)
+      levelVal = val;
+  }
+  const double rawVal = AVRBENCH_FLOOR_RAW +
+                         (AVRBENCH_FULL_RAW - AVRBENCH_FLOOR_RAW) * levelVal;
+  avr_raise_irq(avrBenchRssiAdcIrqPtr,      //ADC value is mV*1023/AVcc
+                         (uint32_t)ceil(rawVal * AVRBENCH_VCC_MV / 1023.0));
+}
+
+//Handles a register-write frame sent to the RX5808.
+void avrBenchHandleFrame(uint32_t frameVal)
+{
+  if((frameVal & 0x0F) != AVRBENCH_SYNTHB_REGADDR || !(frameVal & 0x10))
+    return;                  //not a write to synthesizer-B register
+  const uint32_t regVal = frameVal >> 5;
+  const uint16_t freqMhz = (uint16_t)(2*((regVal >> 7)*32 +
+                                                  (regVal & 0x7F)) + 479);
+  avrBenchSetRssiForFreq(freqMhz);
+  const uint64_t cycVal = avrBenchAvrPtr->cycle;
+  if(avrBenchScanCmdFlag && avrBenchLastTuneCycle > 0)
+    avrBenchAddSpan(AVRBENCH_SPAN_SCANSTEP,cycVal-avrBenchLastTuneCycle);
+  avrBenchLastTuneCycle = cycVal;
+  ++avrBenchTuneCount;
+}
+
+//Notify function for changes on the RX5808 SEL pin.
+void avrBenchSelPinFn(avr_irq_t *irqPtr, uint32_t val, void *paramPtr)
+{
+  if(val && !avrBenchSelLevel)
+  {  //SEL rising; end of frame
+    avrBenchAddSpan(AVRBENCH_SPAN_TUNEWRITE,
+                               avrBenchAvrPtr->cycle - avrBenchSelLowCycle);
+    if(avrBenchFrameBitCount == AVRBENCH_FRAME_NUMBITS)
+      avrBenchHandleFrame(avrBenchFrameVal);
+  }
+  else if(!val && avrBenchSelLevel)
+  {  //SEL falling; start of frame
+    avrBenchSelLowCycle = avrBenchAvrPtr->cycle;
+    avrBenchFrameBitCount = 0;
+    avrBenchFrameVal = 0;
+  }
+  avrBenchSelLevel = (val != 0);
+}
+
+//Notify function for changes on the RX5808 CLK pin.
+void avrBenchClkPinFn(avr_irq_t *irqPtr, uint32_t val, void *paramPtr)
+{
+  if(val && !avrBenchClkLevel && !avrBenchSelLevel &&
+                           avrBenchFrameBitCount < AVRBENCH_FRAME_NUMBITS)
+  {  //CLK rising during frame; clock in data bit
+    if(avrBenchDataLevel)
+      avrBenchFrameVal |= (uint32_t)1 << avrBenchFrameBitCount;
+    ++avrBenchFrameBitCount;
+  }
+  avrBenchClkLevel = (val != 0);
+}
+
+//Notify function for changes on the RX5808 DATA pin.
+void avrBenchDataPinFn(avr_irq_t *irqPtr, uint32_t val, void *paramPtr)
+{
+  avrBenchDataLevel = (val != 0);
+}
+
+//Notify function for bytes sent by the firmware via the UART.
+void avrBenchUartOutFn(avr_irq_t *irqPtr, uint32_t val, void *paramPtr)
+{
+  avrBenchLastOutCycle = avrBenchAvrPtr->cycle;
+  if(avrBenchAwaitRespFlag)
+  {
+    avrBenchRespCycle = avrBenchLastOutCycle;
+    avrBenchAwaitRespFlag = false;
+  }
+  if(avrBenchVerboseFlag)
+    fputc((int)(val & 0xFF),stderr);
+}
+
+//Returns the current stack-pointer value.
+uint16_t avrBenchGetSp()
+{
+  return (uint16_t)(avrBenchAvrPtr->data[R_SPL] |
+                                     (avrBenchAvrPtr->data[R_SPH] << 8));
+}
+
+//Runs the simulation for the given number of cycles, tracking entries to
+// and exits from the display interrupt routine.  An exit is the 'reti'
+// executed with the stack pointer at its value on entry (so nested
+// interrupts are not counted as exits).  Input bytes in the given string
+// (may be NULL) are sent via the UART at the baud rate.
+// Returns false if the simulated CPU stopped or crashed.
+bool avrBenchRunCycles(uint64_t numCycles, const char *inStr)
+{
+  static bool isrActiveFlag = false;
+  static uint64_t isrEntryCycle = 0;
+  static uint16_t isrEntrySp = 0;
+  const avr_flashaddr_t vecAddr = AVRBENCH_DISPISR_VECNUM * 4;
+  const uint64_t endCycle = avrBenchAvrPtr->cycle + numCycles;
+  uint64_t nextInCycle = avrBenchAvrPtr->cycle;
+  while(avrBenchAvrPtr->cycle < endCycle)
+  {
+    if(inStr != NULL && *inStr != '\0' &&
+                                     avrBenchAvrPtr->cycle >= nextInCycle)
+    {  //send next input byte
+      if(*inStr == '\r')
+      {  //command terminator; start response timing
+        avrBenchCmdSentCycle = avrBenchAvrPtr->cycle;
+        avrBenchAwaitRespFlag = true;
+      }
+      avr_raise_irq(avrBenchUartInIrqPtr,(uint8_t)*inStr++);
+      nextInCycle = avrBenchAvrPtr->cycle + AVRBENCH_UART_CHAR_CYCLES;
+    }
+    const avr_flashaddr_t pcVal = avrBenchAvrPtr->pc;
+    const bool retiFlag = isrActiveFlag &&
+         (avrBenchAvrPtr->flash[pcVal] |
+              (avrBenchAvrPtr->flash[pcVal+1] << 8)) == AVRBENCH_RETI_OPCODE &&
+                                             avrBenchGetSp() == isrEntrySp;
+    const int stateVal = avr_run(avrBenchAvrPtr);
+    if(stateVal == cpu_Done || stateVal == cpu_Crashed)
+      return false;
+    if(retiFlag)
+    {  //display ISR finished
+      avrBenchAddSpan(AVRBENCH_SPAN_DISPISR,
+                                    avrBenchAvrPtr->cycle - isrEntryCycle);
+      isrActiveFlag = false;
+    }
+    else if(!isrActiveFlag && avrBenchAvrPtr->pc == vecAddr)
+    {  //display ISR entered
+      isrActiveFlag = true;
+      isrEntryCycle = avrBenchAvrPtr->cycle;
+      isrEntrySp = avrBenchGetSp();
+    }
+  }
+  return true;
+}
+
+//Sends a command and runs until its output has been quiet for the given
+// time (or the maximum time has passed).
+// Returns false if the simulated CPU stopped or crashed.
+bool avrBenchRunCommand(const char *cmdStr, unsigned long quietMs,
+                                                           unsigned long maxMs)
+{
+  const uint64_t cycPerMs = AVRBENCH_FREQ_HZ / 1000;
+  char inBuff[AVRBENCH_CMD_MAXLEN+2];
+  snprintf(inBuff,sizeof(inBuff),"%s\r",cmdStr);
+  const uint64_t startCycle = avrBenchAvrPtr->cycle;
+  const unsigned long startTunes = avrBenchTuneCount;
+  avrBenchScanCmdFlag = (cmdStr[0] == 'S' || cmdStr[0] == 's');
+  avrBenchLastTuneCycle = 0;
+  avrBenchRespCycle = 0;
+  avrBenchLastOutCycle = startCycle;
+  if(!avrBenchRunCycles(strlen(inBuff)*AVRBENCH_UART_CHAR_CYCLES,inBuff))
+    return false;
+  while(avrBenchAvrPtr->cycle - avrBenchLastOutCycle < quietMs*cycPerMs &&
+                            avrBenchAvrPtr->cycle - startCycle < maxMs*cycPerMs)
+  {
+    if(!avrBenchRunCycles(cycPerMs,NULL))
+      return false;
+  }
+  avrBenchAwaitRespFlag = false;
+  avrBenchScanCmdFlag = false;
+  if(avrBenchCmdResultsCount < AVRBENCH_MAX_CMDS)
+  {
+    AvrBenchCmdResult &resRef =
+                             avrBenchCmdResultsArr[avrBenchCmdResultsCount++];
+    strncpy(resRef.cmdStr,cmdStr,sizeof(resRef.cmdStr)-1);
+    resRef.cmdStr[sizeof(resRef.cmdStr)-1] = '\0';
+    resRef.respCycles = (avrBenchRespCycle > 0) ?
+                               avrBenchRespCycle - avrBenchCmdSentCycle : 0;
+    resRef.runCycles = avrBenchLastOutCycle - avrBenchCmdSentCycle;
+    resRef.tuneCount = avrBenchTuneCount - startTunes;
+    if(resRef.respCycles > 0)
+      avrBenchAddSpan(AVRBENCH_SPAN_CMDRESP,resRef.respCycles);
+  }
+  return true;
+}
+
+//Writes a JSON string value (with quotes and escapes).
+void avrBenchWriteJsonStr(FILE *fp, const char *str)
+{
+  fputc('"',fp);
+  for(; *str != '\0'; ++str)
+  {
+    if(*str == '"' || *str == '\\')
+      fputc('\\',fp);
+    fputc(*str,fp);
+  }
+  fputc('"',fp);
+}
+
+//Writes the report.  Each span is written on its own line (so the report
+// may be read back by 'avrBenchCompareBaseline()').
+void avrBenchWriteReport(FILE *fp, const char *elfName, const char *revStr)
+{
+  fprintf(fp,"{\n  \"firmware\": ");
+  avrBenchWriteJsonStr(fp,elfName);
+  fprintf(fp,",\n  \"revision\": ");
+  avrBenchWriteJsonStr(fp,revStr);
+  fprintf(fp,",\n  \"mcu\": \"%s\",\n  \"freqHz\": %lu,\n",
+                                          AVRBENCH_MCU_NAME,AVRBENCH_FREQ_HZ);
+  fprintf(fp,"  \"units\": \"cycles\",\n  \"spans\": {\n");
+  for(int i=0; i<AVRBENCH_NUM_SPANS; ++i)
+  {
+    const AvrBenchSpan &spanRef = avrBenchSpansArr[i];
+    fprintf(fp,"    \"%s\": { \"count\": %lu, \"min\": %llu, "
+               "\"mean\": %.1f, \"max\": %llu }%s\n",spanRef.nameStr,
+               spanRef.count,(unsigned long long)spanRef.minCyc,
+               avrBenchGetSpanMean(spanRef),
+               (unsigned long long)spanRef.maxCyc,
+               (i < AVRBENCH_NUM_SPANS-1) ? "," : "");
+  }
+  fprintf(fp,"  },\n  \"commands\": [\n");
+  for(int i=0; i<avrBenchCmdResultsCount; ++i)
+  {
+    const AvrBenchCmdResult &resRef = avrBenchCmdResultsArr[i];
+    fprintf(fp,"    { \"cmd\": ");
+    avrBenchWriteJsonStr(fp,resRef.cmdStr);
+    fprintf(fp,", \"responseCycles\": %llu, \"runCycles\": %llu, "
+               "\"tunes\": %lu }%s\n",(unsigned long long)resRef.respCycles,
+               (unsigned long long)resRef.runCycles,resRef.tuneCount,
+               (i < avrBenchCmdResultsCount-1) ? "," : "");
+  }
+  fprintf(fp,"  ]\n}\n");
+}
+
+//Compares the span means against those in the given baseline report and
+// shows the differences.
+// Returns the number of spans whose mean increased by more than the
+// given percentage, or -1 if the baseline could not be read.
+int avrBenchCompareBaseline(const char *baseName, double regrPct)
+{
+  FILE *fp = fopen(baseName,"r");
+  if(fp == NULL)
+  {
+    fprintf(stderr,"Unable to open baseline report:  %s\n",baseName);
+    return -1;
+  }
+  int regrCount = 0;
+  char lineBuff[256], nameBuff[32];
+  unsigned long countVal;
+  unsigned long long minVal, maxVal;
+  double meanVal;
+  while(fgets(lineBuff,sizeof(lineBuff),fp) != NULL)
+  {
+    if(sscanf(lineBuff," \"%31[^\"]\": { \"count\": %lu, \"min\": %llu, "
+                              "\"mean\": %lf, \"max\": %llu",nameBuff,&countVal,
+                                        &minVal,&meanVal,&maxVal) != 5)
+    {
+      continue;
+    }
+    for(int i=0; i<AVRBENCH_NUM_SPANS; ++i)
+    {
+      const AvrBenchSpan &spanRef = avrBenchSpansArr[i];
+      if(strcmp(nameBuff,spanRef.nameStr) != 0 || spanRef.count == 0 ||
+                                                             meanVal <= 0.0)
+      {
+        continue;
+      }
+      const double newVal = avrBenchGetSpanMean(spanRef);
+      const double pctVal = (newVal - meanVal) * 100.0 / meanVal;
+      const bool regrFlag = (pctVal > regrPct);
+      fprintf(stderr,"%-12s %12.1f -> %12.1f  %+7.2f%%%s\n",nameBuff,
+                      meanVal,newVal,pctVal,regrFlag ? "  REGRESSION" : "");
+      if(regrFlag)
+        ++regrCount;
+    }
+  }
+  fclose(fp);
+  return regrCount;
+}
+
+//Shows the usage information.
+void avrBenchShowUsage()
+{
+  fprintf(stderr,
+    "Usage: avrbench [options] firmware.elf [command ...]\n"
+    "Options:\n"
+    "  -t freq:level  Add scripted transmitter (level 0-100)\n"
+    "  -o file        Write report to file (default stdout)\n"
+    "  -r revision    Revision string for report\n"
+    "  -b file        Compare against baseline report\n"
+    "  -p pct         Regression threshold for '-b' (default %.1f%%)\n"
+    "  -q ms          Quiet time that ends a command (default %d)\n"
+    "  -x ms          Maximum run time per command (default %d)\n"
+    "  -v             Copy firmware output to stderr\n"
+    "If no commands are given then the default set is run.\n"
+    "Exit status is 2 if a regression is found via '-b'.\n",
+    AVRBENCH_DEF_REGRPCT,AVRBENCH_DEF_QUIETMS,AVRBENCH_DEF_MAXMS);
+}
+
+int main(int argc, char **argv)
+{
+  const char *outName = NULL, *revStr = "", *baseName = NULL;
+  const char *elfName = NULL;
+  const char *cmdsArr[AVRBENCH_MAX_CMDS];
+  int cmdsCount = 0;
+  double regrPct = AVRBENCH_DEF_REGRPCT;
+  unsigned long quietMs = AVRBENCH_DEF_QUIETMS;
+  unsigned long maxMs = AVRBENCH_DEF_MAXMS;
+  for(int i=1; i<argc; ++i)
+  {
+    const char *argStr = argv[i];
+    const bool valFlag = (i+1 < argc);
+    unsigned int freqVal, levelVal;
+    if(strcmp(argStr,"-t") == 0 && valFlag)
+    {
+      if(sscanf(argv[++i],"%u:%u",&freqVal,&levelVal) != 2 ||
+                 levelVal > 100 || freqVal > 0xFFFF ||
+                                        avrBenchTxCount >= AVRBENCH_MAX_TX)
+      {
+        fprintf(stderr,"Invalid transmitter specification:  %s\n",argv[i]);
+        return 1;
+      }
+      avrBenchTxFreqArr[avrBenchTxCount] = (uint16_t)freqVal;
+      avrBenchTxLevelArr[avrBenchTxCount++] = (uint8_t)levelVal;
+    }
+    else if(strcmp(argStr,"-o") == 0 && valFlag)
+      outName = argv[++i];
+    else if(strcmp(argStr,"-r") == 0 && valFlag)
+      revStr = argv[++i];
+    else if(strcmp(argStr,"-b") == 0 && valFlag)
+      baseName = argv[++i];
+    else if(strcmp(argStr,"-p") == 0 && valFlag)
+      regrPct = atof(argv[++i]);
+    else if(strcmp(argStr,"-q") == 0 && valFlag)
+      quietMs = strtoul(argv[++i],NULL,10);
+    else if(strcmp(argStr,"-x") == 0 && valFlag)
+      maxMs = strtoul(argv[++i],NULL,10);
+    else if(strcmp(argStr,"-v") == 0)
+      avrBenchVerboseFlag = true;
+    else if(argStr[0] == '-')
+    {
+      avrBenchShowUsage();
+      return 1;
+    }
+    else if(elfName == NULL)
+      elfName = argStr;
+    else if(cmdsCount < AVRBENCH_MAX_CMDS)
+      cmdsArr[cmdsCount++] = argStr;
+  }
+  if(elfName == NULL)
+  {
+    avrBenchShowUsage();
+    return 1;
+  }
+  if(cmdsCount == 0)
+  {  //no commands given; use default set
+    for(int i=0; i<AVRBENCH_NUM_DEFCMDS; ++i)
+      cmdsArr[cmdsCount++] = avrBenchDefCmdsArr[i];
+  }
+  if(avrBenchTxCount == 0)
+  {  //no transmitters given; use default set
+    const uint16_t defFreqArr[] = { 5658, 5740, 5800, 5880 };
+    const uint8_t defLevelArr[] = { 70, 55, 80, 45 };
+    for(int i=0; i<4; ++i)
+    {
+      avrBenchTxFreqArr[avrBenchTxCount] = defFreqArr[i];
+      avrBenchTxLevelArr[avrBenchTxCount++] = defLevelArr[i];
+    }
+  }
+
+  elf_firmware_t fwObj;
+  memset(&fwObj,0,sizeof(fwObj));
+  if(elf_read_firmware(elfName,&fwObj) != 0)
+  {
+    fprintf(stderr,"Unable to read firmware file:  %s\n",elfName);
+    return 1;
+  }
+  strncpy(fwObj.mmcu,AVRBENCH_MCU_NAME,sizeof(fwObj.mmcu)-1);
+  fwObj.frequency = AVRBENCH_FREQ_HZ;
+  fwObj.vcc = fwObj.avcc = fwObj.aref = AVRBENCH_VCC_MV;
+  if((avrBenchAvrPtr=avr_make_mcu_by_name(fwObj.mmcu)) == NULL)
+  {
+    fprintf(stderr,"Unable to create simulated MCU:  %s\n",fwObj.mmcu);
+    return 1;
+  }
+  avr_init(avrBenchAvrPtr);
+  avr_load_firmware(avrBenchAvrPtr,&fwObj);
+
+  uint32_t uartFlags = 0;              //don't copy UART output to stdout
+  avr_ioctl(avrBenchAvrPtr,AVR_IOCTL_UART_GET_FLAGS('0'),&uartFlags);
+  uartFlags &= ~AVR_UART_FLAG_STDIO;
+  avr_ioctl(avrBenchAvrPtr,AVR_IOCTL_UART_SET_FLAGS('0'),&uartFlags);
+  avrBenchUartInIrqPtr = avr_io_getirq(avrBenchAvrPtr,
+                                 AVR_IOCTL_UART_GETIRQ('0'),UART_IRQ_INPUT);
+  avr_irq_register_notify(avr_io_getirq(avrBenchAvrPtr,
+                               AVR_IOCTL_UART_GETIRQ('0'),UART_IRQ_OUTPUT),
+                                                    avrBenchUartOutFn,NULL);
+  avr_irq_register_notify(avrBenchGetPinIrq(RX5808_SEL_PIN),
+                                                     avrBenchSelPinFn,NULL);
+  avr_irq_register_notify(avrBenchGetPinIrq(RX5808_CLK_PIN),
+                                                     avrBenchClkPinFn,NULL);
+  avr_irq_register_notify(avrBenchGetPinIrq(RX5808_DATA_PIN),
+                                                    avrBenchDataPinFn,NULL);
+  avr_raise_irq(avrBenchGetPinIrq(AVRBENCH_DISP_B_PIN),1);
+  avr_raise_irq(avrBenchGetPinIrq(AVRBENCH_DISP_D_PIN),1);
+  avr_raise_irq(avrBenchGetPinIrq(AVRBENCH_DISP_F_PIN),1);
+  avrBenchRssiAdcIrqPtr = avr_io_getirq(avrBenchAvrPtr,
+                   AVR_IOCTL_ADC_GETIRQ,ADC_IRQ_ADC0+AVRBENCH_RSSI_ADC_CHAN);
+  avr_raise_irq(avr_io_getirq(avrBenchAvrPtr,AVR_IOCTL_ADC_GETIRQ,
+                                   ADC_IRQ_ADC0+AVRBENCH_SEC_ADC_CHAN),0);
+  avrBenchSetRssiForFreq(0);
+
+  bool okFlag = avrBenchRunCycles(
+                  (uint64_t)AVRBENCH_STARTUP_MS*(AVRBENCH_FREQ_HZ/1000),NULL);
+  for(int i=0; okFlag && i<AVRBENCH_NUM_SETUPCMDS; ++i)
+    okFlag = avrBenchRunCommand(avrBenchSetupCmdsArr[i],quietMs,maxMs);
+  avrBenchCmdResultsCount = 0;         //only report on given commands
+  avrBenchSpansArr[AVRBENCH_SPAN_CMDRESP].count = 0;
+  avrBenchSpansArr[AVRBENCH_SPAN_CMDRESP].maxCyc = 0;
+  avrBenchSpansArr[AVRBENCH_SPAN_CMDRESP].sumCyc = 0.0;
+  for(int i=0; okFlag && i<cmdsCount; ++i)
+    okFlag = avrBenchRunCommand(cmdsArr[i],quietMs,maxMs);
+  if(!okFlag)
+  {
+    fprintf(stderr,"Simulated CPU stopped at cycle %llu (pc=0x%04X)\n",
+                     (unsigned long long)avrBenchAvrPtr->cycle,
+                                           (unsigned int)avrBenchAvrPtr->pc);
+    return 1;
+  }
+
+  FILE *outFp = stdout;
+  if(outName != NULL && (outFp=fopen(outName,"w")) == NULL)
+  {
+    fprintf(stderr,"Unable to create report file:  %s\n",outName);
+    return 1;
+  }
+  avrBenchWriteReport(outFp,elfName,revStr);
+  if(outFp != stdout)
+    fclose(outFp);
+  if(baseName != NULL)
+  {
+    const int regrCount = avrBenchCompareBaseline(baseName,regrPct);
+    if(regrCount < 0)
+      return 1;
+    if(regrCount > 0)
+      return 2;
+  }
+  return 0;
+}
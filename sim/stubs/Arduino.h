@@ -0,0 +1,125 @@
+//Arduino.h:  Host-simulation stand-in for the Arduino core header.  The
+//            functions declared here are implemented in "SimCore.cpp"
+//            against the virtual clock and simulated hardware.
+//
+// 10/16/2026 -- [ET]
+//
+
+#ifndef ARDUINO_H_
+#define ARDUINO_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "avr/io.h"
+#include "avr/pgmspace.h"
+#include "avr/interrupt.h"
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+#define A6 20
+#define A7 21
+#define NUM_DIGITAL_PINS 20
+#define SIM_NUM_PINS 22                //includes analog-only A6, A7
+
+#define F(s) (s)
+#define min(a,b) ((a)<(b)?(a):(b))
+#define max(a,b) ((a)>(b)?(a):(b))
+#define constrain(amt,low,high) \
+                       ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define lowByte(w) ((uint8_t)((w) & 0xff))
+#define highByte(w) ((uint8_t)((w) >> 8))
+
+    //pin-register lookups (only used for reading back pin modes):
+#define digitalPinToInterrupt(p) ((p) == 2 ? 0 : ((p) == 3 ? 1 : -1))
+#define digitalPinToBitMask(p) ((uint8_t)(1 << (((p) < 8) ? (p) : \
+                                  (((p) < 14) ? ((p) - 8) : ((p) - 14)))))
+#define digitalPinToPort(p) (((p) < 8) ? 4 : (((p) < 14) ? 2 : 3))
+#define portModeRegister(p) \
+                     (((p) == 4) ? &DDRD : (((p) == 2) ? &DDRB : &DDRC))
+#define portOutputRegister(p) (((p) == 4) ? &PORTD.regVal : \
+                        (((p) == 2) ? &PORTB.regVal : &PORTC.regVal))
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int val);
+void attachInterrupt(uint8_t intNum, void (*isr)(), int mode);
+void detachInterrupt(uint8_t intNum);
+void simDelayCycles(unsigned long cycles);
+#define __builtin_avr_delay_cycles(n) simDelayCycles(n)
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+char *itoa(int val, char *str, int radix);
+char *ltoa(long val, char *str, int radix);
+char *utoa(unsigned int val, char *str, int radix);
+char *ultoa(unsigned long val, char *str, int radix);
+
+//Simulated hardware serial port (output paced at the configured baud
+// rate through a 64-byte transmit buffer, as on the AVR).
+class HardwareSerial
+{
+  public:
+    void begin(unsigned long baud);
+    void end() {}
+    int available();
+    int read();
+    int peek();
+    int availableForWrite();
+    void flush();
+    size_t write(uint8_t val);
+    size_t write(int val) { return write((uint8_t)val); }
+    size_t write(const uint8_t *buf, size_t len);
+    size_t write(const char *str) { return write((const uint8_t *)str,strlen(str)); }
+    size_t print(const char *str) { return write(str); }
+    size_t print(char ch) { return write((uint8_t)ch); }
+    size_t print(unsigned char val, int base=10) { return print((unsigned long)val,base); }
+    size_t print(int val, int base=10) { return print((long)val,base); }
+    size_t print(unsigned int val, int base=10) { return print((unsigned long)val,base); }
+    size_t print(long val, int base=10);
+    size_t print(unsigned long val, int base=10);
+    size_t print(double val, int digits=2);
+    size_t println() { return write((const uint8_t *)"\r\n",2); }
+    template<typename T> size_t println(T val)
+    {
+      const size_t n = print(val);
+      return n + println();
+    }
+    template<typename T> size_t println(T val, int fmt)
+    {
+      const size_t n = print(val,fmt);
+      return n + println();
+    }
+    operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+inline boolean isAlphaNumeric(int c) { return isalnum(c) != 0; }
+inline boolean isDigit(int c) { return isdigit(c) != 0; }
+
+void setup();
+void loop();
+
+#endif /* ARDUINO_H_ */
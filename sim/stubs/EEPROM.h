@@ -0,0 +1,29 @@
+//EEPROM.h:  Host-simulation stand-in for the Arduino EEPROM library
+//           (1 KB, erased to 0xFF; writes take 3.4ms of virtual time).
+//
+// 10/16/2026 -- [ET]
+//
+
+#ifndef EEPROM_H_
+#define EEPROM_H_
+
+#include <stdint.h>
+
+#define SIM_EEPROM_SIZE 1024
+
+class EEPROMClass
+{
+  public:
+    uint8_t read(int addr);
+    void write(int addr, uint8_t val);
+    void update(int addr, uint8_t val)
+    {
+      if(read(addr) != val)
+        write(addr,val);
+    }
+    uint16_t length() { return SIM_EEPROM_SIZE; }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif /* EEPROM_H_ */
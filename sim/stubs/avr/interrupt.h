@@ -0,0 +1,21 @@
+//interrupt.h:  Host-simulation stand-in for the AVR interrupt header.
+//              Interrupt routines are run by the virtual clock (in
+//              "SimCore.cpp") while interrupts are enabled.
+//
+// 10/16/2026 -- [ET]
+//
+
+#ifndef AVR_INTERRUPT_H_
+#define AVR_INTERRUPT_H_
+
+#define ISR(vect) extern "C" void vect(void)
+#define ADC_vect simAdcVectIsr
+
+extern volatile bool simIntsEnabledFlag;    //global-interrupt-enable bit
+
+#define cli() (simIntsEnabledFlag = false)
+#define sei() (simIntsEnabledFlag = true)
+#define noInterrupts() cli()
+#define interrupts() sei()
+
+#endif /* AVR_INTERRUPT_H_ */
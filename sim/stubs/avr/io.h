@@ -0,0 +1,61 @@
+//io.h:  Host-simulation stand-in for the AVR I/O-register header.  The
+//       port-output registers are objects that pass bit changes on to
+//       the simulated pins (so direct-port writes reach the simulated
+//       RX5808); the other registers are plain variables (defined in
+//       "SimCore.cpp"), with the ADC registers used by the simulated
+//       free-running ADC.
+//
+// 10/16/2026 -- [ET]
+//
+
+#ifndef AVR_IO_H_
+#define AVR_IO_H_
+
+#include <stdint.h>
+
+//Port-output register; writes are passed to the simulated pins.
+class SimPortReg
+{
+  public:
+    SimPortReg(uint8_t firstPin) : regVal(0), firstPinNum(firstPin) {}
+    operator uint8_t() const { return regVal; }
+    SimPortReg &operator=(uint8_t val) { setValue(val); return *this; }
+    SimPortReg &operator|=(uint8_t val) { setValue(regVal | val); return *this; }
+    SimPortReg &operator&=(uint8_t val) { setValue(regVal & val); return *this; }
+    SimPortReg &operator^=(uint8_t val) { setValue(regVal ^ val); return *this; }
+    void setValue(uint8_t val);
+    volatile uint8_t regVal;           //register contents
+    const uint8_t firstPinNum;         //Arduino pin # for bit 0
+};
+
+extern SimPortReg PORTB, PORTC, PORTD;
+extern volatile uint8_t DDRB, DDRC, DDRD;
+extern volatile uint8_t ADMUX, ADCSRA, ADCSRB, ADCL, ADCH;
+extern volatile uint8_t SPCR, SPSR, SPDR;
+
+#define _BV(bit) (1 << (bit))
+
+    //ADMUX, ADCSRA bits:
+#define REFS1 7
+#define REFS0 6
+#define ADEN 7
+#define ADSC 6
+#define ADATE 5
+#define ADIF 4
+#define ADIE 3
+#define ADPS2 2
+#define ADPS1 1
+#define ADPS0 0
+    //SPCR, SPSR bits:
+#define SPIE 7
+#define SPE 6
+#define DORD 5
+#define MSTR 4
+#define CPOL 3
+#define CPHA 2
+#define SPR1 1
+#define SPR0 0
+#define SPIF 7
+#define SPI2X 0
+
+#endif /* AVR_IO_H_ */
@@ -0,0 +1,38 @@
+//pgmspace.h:  Host-simulation stand-in for the AVR program-memory
+//             header (program memory is ordinary memory on the host).
+//             Since the firmware fetches pointers from program memory as
+//             words, reading a word from a table of pointers returns the
+//             full (host-sized) pointer value.
+//
+// 10/16/2026 -- [ET]
+//
+
+#ifndef AVR_PGMSPACE_H_
+#define AVR_PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s) (s)
+//Reads a word from program memory.
+inline uint16_t simPgmReadWord(const void *addr)
+{
+  return *(const uint16_t *)addr;
+}
+
+//Reads a pointer (as a "word") from a table of pointers.
+template<typename T> inline uintptr_t simPgmReadWord(T *const *addr)
+{
+  return (uintptr_t)*addr;
+}
+
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) simPgmReadWord(addr)
+#define pgm_read_byte_near(addr) pgm_read_byte(addr)
+#define pgm_read_word_near(addr) pgm_read_word(addr)
+#define strlen_P strlen
+#define strcpy_P strcpy
+#define memcpy_P memcpy
+
+#endif /* AVR_PGMSPACE_H_ */
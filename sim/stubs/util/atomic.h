@@ -0,0 +1,43 @@
+//atomic.h:  Host-simulation stand-in for the AVR atomic-block header.
+//           The block clears the simulated global-interrupt-enable bit
+//           and restores it on exit (including via 'return'); the exit
+//           is charged a few cycles, so interrupts held off by the block
+//           are run then and busy-wait loops on ISR-updated values
+//           (via atomic reads) see time pass.
+//
+// 10/16/2026 -- [ET]
+//
+
+#ifndef UTIL_ATOMIC_H_
+#define UTIL_ATOMIC_H_
+
+#include "avr/interrupt.h"
+
+void simChargeNs(unsigned long timeNs);
+
+#define ATOMIC_RESTORESTATE 0
+#define ATOMIC_FORCEON 1
+
+//Saves and clears the interrupt-enable bit for the life of the object.
+class SimAtomicGuard
+{
+  public:
+    SimAtomicGuard(int typeVal) :
+        savedFlag(typeVal == ATOMIC_FORCEON || simIntsEnabledFlag)
+    {
+      simIntsEnabledFlag = false;
+    }
+    ~SimAtomicGuard()
+    {
+      simIntsEnabledFlag = savedFlag;
+      simChargeNs(250);      //~4 cycles (plus any interrupts now due)
+    }
+    bool savedFlag;
+    bool doneFlag = false;
+};
+
+#define ATOMIC_BLOCK(type) \
+      for(SimAtomicGuard simAtomicGuardObj(type); \
+          !simAtomicGuardObj.doneFlag; simAtomicGuardObj.doneFlag = true)
+
+#endif /* UTIL_ATOMIC_H_ */
@@ -0,0 +1,21 @@
+//crc16.h:  Host-simulation stand-in for the AVR CRC header (same
+//          results as the avr-libc versions).
+//
+// 10/16/2026 -- [ET]
+//
+
+#ifndef UTIL_CRC16_H_
+#define UTIL_CRC16_H_
+
+#include <stdint.h>
+
+//Updates a CRC-8 (poly 0x07) with the given data byte.
+static inline uint8_t _crc8_ccitt_update(uint8_t crc, uint8_t data)
+{
+  data ^= crc;
+  for(uint8_t i=0; i<8; ++i)
+    data = (data & 0x80) ? (uint8_t)((data << 1) ^ 0x07) : (uint8_t)(data << 1);
+  return data;
+}
+
+#endif /* UTIL_CRC16_H_ */